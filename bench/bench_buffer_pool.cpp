@@ -0,0 +1,91 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/buffer_pool.hpp"
+#include "sockslib/socket.hpp"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+    constexpr kstd::usize buffer_size = 16 * 1024;
+    constexpr kstd::usize message_size = 4 * 1024;
+
+    // Connected socket pairs stand in for accepted connections, only one of them has data in flight at a time
+    struct Connections final {
+        std::vector<sockslib::AcceptedSocket> sockets;
+        std::vector<sockslib::AcceptedSocket> peers;
+
+        explicit Connections(const kstd::usize count) {
+            sockets.reserve(count);
+            peers.reserve(count);
+            for(kstd::usize i = 0; i < count; ++i) {
+                int handles[2] {};// NOLINT
+                if(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, handles) < 0) {
+                    throw std::runtime_error {"Unable to create socket pair"};
+                }
+                sockets.emplace_back(handles[0]);
+                peers.emplace_back(handles[1]);
+            }
+        }
+    };
+
+    [[nodiscard]] auto resident_size() -> kstd::usize {
+        std::ifstream statm {"/proc/self/statm"};
+        kstd::usize total_pages = 0;
+        kstd::usize resident_pages = 0;
+        statm >> total_pages >> resident_pages;
+        return resident_pages * static_cast<kstd::usize>(sysconf(_SC_PAGESIZE));
+    }
+
+    auto report(benchmark::State& state, const kstd::usize start_resident_size) -> void {
+        const auto end_resident_size = resident_size();
+        const auto resident_growth = end_resident_size - std::min(end_resident_size, start_resident_size);
+        state.counters["buffer_rss_mb"] = static_cast<double>(resident_growth) / (1024.0 * 1024.0);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * message_size));
+    }
+}// namespace
+
+static void bench_per_connection_buffers(benchmark::State& state) {
+    using namespace sockslib;
+    const auto connection_count = static_cast<kstd::usize>(state.range(0));
+    Connections connections {connection_count};
+    std::vector<kstd::u8> message(message_size);
+
+    const auto start_resident_size = resident_size();
+    std::vector<std::vector<kstd::u8>> buffers(connection_count, std::vector<kstd::u8>(buffer_size));
+    kstd::usize connection = 0;
+    for(auto _ : state) {
+        connections.peers[connection].write(message.data(), message.size()).get_or_throw();
+        auto& buffer = buffers[connection];
+        benchmark::DoNotOptimize(connections.sockets[connection].read(buffer.data(), buffer.size()).get_or_throw());
+        connection = (connection + 1) % connection_count;
+    }
+    report(state, start_resident_size);
+}
+
+static void bench_pooled_buffers(benchmark::State& state) {
+    using namespace sockslib;
+    const auto connection_count = static_cast<kstd::usize>(state.range(0));
+    Connections connections {connection_count};
+    std::vector<kstd::u8> message(message_size);
+
+    const auto start_resident_size = resident_size();
+    BufferPool pool {buffer_size};
+    kstd::usize connection = 0;
+    for(auto _ : state) {
+        connections.peers[connection].write(message.data(), message.size()).get_or_throw();
+        const auto buffer = connections.sockets[connection].read(pool).get_or_throw();
+        benchmark::DoNotOptimize(buffer.data());
+        connection = (connection + 1) % connection_count;
+    }
+    report(state, start_resident_size);
+    state.counters["pool_mb"] = static_cast<double>(pool.memory_size()) / (1024.0 * 1024.0);
+}
+
+BENCHMARK(bench_per_connection_buffers)->Arg(1000)->Arg(8000);
+BENCHMARK(bench_pooled_buffers)->Arg(1000)->Arg(8000);
+#endif
@@ -0,0 +1,75 @@
+#include "sockslib/buffered_stream.hpp"
+#include "sockslib/socket.hpp"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace {
+    // Messages per iteration, small enough to fit into the socket buffers, so one thread can write and read them
+    constexpr kstd::usize batch_size = 256;
+
+    struct Connection final {
+        sockslib::ServerSocket server_socket {1337, sockslib::ProtocolType::TCP};
+        sockslib::ClientSocket client_socket {"127.0.0.1", 1337, sockslib::ProtocolType::TCP};
+        sockslib::AcceptedSocket socket {std::move(server_socket.accept().get_or_throw())};
+    };
+
+    // Line of size bytes including the delimiter
+    auto create_message(const kstd::usize size) -> std::vector<kstd::u8> {
+        std::vector<kstd::u8> message(size, 'x');
+        message.back() = '\n';
+        return message;
+    }
+}// namespace
+
+// One write and one read syscall per message, the messages have a fixed size so no delimiter scan is needed
+static void bench_unbuffered_messages(benchmark::State& state) {
+    using namespace sockslib;
+    const auto message_size = static_cast<kstd::usize>(state.range(0));
+    Connection connection {};
+    auto message = create_message(message_size);
+    std::vector<kstd::u8> received_message(message_size);
+
+    for(auto _ : state) {
+        for(kstd::usize i = 0; i < batch_size; ++i) {
+            connection.client_socket.write(message.data(), message.size()).get_or_throw();
+        }
+        for(kstd::usize i = 0; i < batch_size; ++i) {
+            kstd::usize bytes_read = 0;
+            while(bytes_read < message_size) {
+                bytes_read += connection.socket.read(received_message.data() + bytes_read, message_size - bytes_read)
+                                      .get_or_throw();
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batch_size));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * batch_size * message_size));
+}
+
+// Coalesced writes with one flush per batch, lines are split by read_until out of the read buffer
+static void bench_buffered_messages(benchmark::State& state) {
+    using namespace sockslib;
+    const auto message_size = static_cast<kstd::usize>(state.range(0));
+    Connection connection {};
+    BufferedStream writer {connection.client_socket};
+    BufferedStream reader {connection.socket};
+    auto message = create_message(message_size);
+    std::vector<kstd::u8> received_message {};
+    received_message.reserve(message_size);
+
+    for(auto _ : state) {
+        for(kstd::usize i = 0; i < batch_size; ++i) {
+            writer.write(message.data(), message.size()).throw_if_error();
+        }
+        writer.flush().throw_if_error();
+        for(kstd::usize i = 0; i < batch_size; ++i) {
+            received_message.clear();
+            benchmark::DoNotOptimize(reader.read_until('\n', received_message).get_or_throw());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batch_size));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * batch_size * message_size));
+}
+
+BENCHMARK(bench_unbuffered_messages)->Arg(16)->Arg(64);
+BENCHMARK(bench_buffered_messages)->Arg(16)->Arg(64);
@@ -0,0 +1,80 @@
+#include "sockslib/connection_scheduler.hpp"
+
+#ifdef PLATFORM_LINUX
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <vector>
+
+namespace {
+    constexpr kstd::usize worker_count = 4;
+    constexpr kstd::usize connection_count = 16;
+
+    // Every fourth connection sends expensive requests, round-robin assignment puts all of them onto worker 0
+    constexpr auto heavy_request_time = std::chrono::microseconds {200};
+    constexpr auto light_request_time = std::chrono::microseconds {2};
+
+    auto spin(const std::chrono::microseconds duration) -> void {
+        const auto end = std::chrono::steady_clock::now() + duration;
+        while(std::chrono::steady_clock::now() < end) {
+        }
+    }
+
+    // The request byte tells the handler how expensive the request is, it's echoed back as response
+    auto handle(const kstd::usize, sockslib::AcceptedSocket& socket) -> bool {
+        kstd::u8 request = 0;
+        auto read_result = socket.try_read(&request, 1);
+        if(read_result && read_result.get().is_empty()) {
+            return true;
+        }
+        if(!read_result || read_result.get().get() == 0) {
+            return false;
+        }
+        spin(request != 0 ? heavy_request_time : light_request_time);
+        return !socket.write(&request, 1).is_error();
+    }
+
+    void run_skewed_requests(benchmark::State& state, const bool work_stealing) {
+        using namespace sockslib;
+        ServerSocket server_socket {1337, ProtocolType::TCP};
+        ConnectionScheduler scheduler {worker_count, handle, work_stealing};
+        std::vector<ClientSocket> client_sockets {};
+        client_sockets.reserve(connection_count);
+        for(kstd::usize i = 0; i < connection_count; ++i) {
+            client_sockets.emplace_back("127.0.0.1", 1337, ProtocolType::TCP);
+            scheduler.add(std::move(server_socket.accept().get_or_throw())).throw_if_error();
+        }
+        scheduler.start().throw_if_error();
+
+        for(auto _ : state) {
+            for(kstd::usize i = 0; i < connection_count; ++i) {
+                auto request = static_cast<kstd::u8>(i % worker_count == 0 ? 1 : 0);
+                client_sockets[i].write(&request, 1).get_or_throw();
+            }
+            for(const auto& socket : client_sockets) {
+                kstd::u8 response = 0;
+                socket.read(&response, 1).get_or_throw();
+            }
+        }
+
+        kstd::usize stolen_count = 0;
+        for(kstd::usize i = 0; i < worker_count; ++i) {
+            stolen_count += scheduler.stolen_count(i);
+        }
+        scheduler.stop();
+        state.counters["stolen"] = benchmark::Counter {static_cast<double>(stolen_count),
+                                                       benchmark::Counter::kAvgIterations};
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * connection_count));
+    }
+}// namespace
+
+static void bench_skewed_static_sharding(benchmark::State& state) {
+    run_skewed_requests(state, false);
+}
+
+static void bench_skewed_work_stealing(benchmark::State& state) {
+    run_skewed_requests(state, true);
+}
+
+BENCHMARK(bench_skewed_static_sharding)->UseRealTime();
+BENCHMARK(bench_skewed_work_stealing)->UseRealTime();
+#endif
@@ -0,0 +1,108 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/datagram_socket.hpp"
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <vector>
+
+namespace {
+    constexpr kstd::usize burst_size = 32;
+    constexpr kstd::u16 datagram_size = 1200;
+
+    // Every iteration transfers one burst over loopback, which stays far below the default socket buffer size
+    template<typename F>
+    void run_packet_rate(benchmark::State& state, F&& transfer_burst, const bool receive_offload = false) {
+        using namespace sockslib;
+        DatagramSocket receiver {1337};
+        DatagramSocket sender {};
+        receiver.set_receive_offload(receive_offload).throw_if_error();
+        const auto address = SocketAddress::from_literal("127.0.0.1", 1337).get();
+        for(auto _ : state) {
+            transfer_burst(sender, receiver, address);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * burst_size));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * burst_size * datagram_size));
+    }
+}// namespace
+
+static void bench_single_datagrams(benchmark::State& state) {
+    using namespace sockslib;
+    std::vector<kstd::u8> buffer(datagram_size);
+    run_packet_rate(state, [&](DatagramSocket& sender, DatagramSocket& receiver, const SocketAddress& address) {
+        SocketAddress sender_address {};
+        for(kstd::usize i = 0; i < burst_size; ++i) {
+            sender.send_to(buffer.data(), buffer.size(), address).get_or_throw();
+        }
+        for(kstd::usize i = 0; i < burst_size; ++i) {
+            benchmark::DoNotOptimize(receiver.receive_from(buffer.data(), buffer.size(), sender_address).get_or_throw());
+        }
+    });
+}
+
+static void bench_batched_datagrams(benchmark::State& state) {
+    using namespace sockslib;
+    DatagramBatch send_batch {burst_size, datagram_size};
+    DatagramBatch receive_batch {burst_size, datagram_size};
+    std::vector<kstd::u8> buffer(datagram_size);
+    run_packet_rate(state, [&](DatagramSocket& sender, DatagramSocket& receiver, const SocketAddress& address) {
+        send_batch.clear();
+        for(kstd::usize i = 0; i < burst_size; ++i) {
+            benchmark::DoNotOptimize(send_batch.push(buffer.data(), buffer.size(), address));
+        }
+        sender.send_batch(send_batch).get_or_throw();
+
+        kstd::usize received_count = 0;
+        while(received_count < burst_size) {
+            received_count += receiver.receive_batch(receive_batch).get_or_throw();
+        }
+    });
+}
+
+static void bench_segmented_datagrams(benchmark::State& state) {
+    using namespace sockslib;
+    std::vector<kstd::u8> buffer(burst_size * datagram_size);
+    std::vector<kstd::u8> receive_buffer(64 * 1024);
+    run_packet_rate(state, [&](DatagramSocket& sender, DatagramSocket& receiver, const SocketAddress& address) {
+        sender.send_segmented(buffer.data(), buffer.size(), datagram_size, address).get_or_throw();
+
+        SocketAddress sender_address {};
+        kstd::usize received_count = 0;
+        while(received_count < burst_size) {
+            received_count += receiver.receive_coalesced(receive_buffer.data(), receive_buffer.size(), sender_address)
+                                      .get_or_throw()
+                                      .count();
+        }
+    }, true);
+}
+
+// Like bench_single_datagrams with the receive timestamps of the kernel, which costs the control message parsing.
+// The queue time counter is the average time between the kernel receiving a datagram and the application reading it.
+static void bench_timestamped_datagrams(benchmark::State& state) {
+    using namespace sockslib;
+    std::vector<kstd::u8> buffer(datagram_size);
+    std::chrono::nanoseconds queue_time {0};
+    bool timestamping_enabled = false;
+    run_packet_rate(state, [&](DatagramSocket& sender, DatagramSocket& receiver, const SocketAddress& address) {
+        if(!timestamping_enabled) {
+            receiver.set_timestamping({true, false, false}).throw_if_error();
+            timestamping_enabled = true;
+        }
+        SocketAddress sender_address {};
+        for(kstd::usize i = 0; i < burst_size; ++i) {
+            sender.send_to(buffer.data(), buffer.size(), address).get_or_throw();
+        }
+        for(kstd::usize i = 0; i < burst_size; ++i) {
+            const auto read = receiver.receive_from_timestamped(buffer.data(), buffer.size(), sender_address)
+                                      .get_or_throw();
+            queue_time += std::chrono::system_clock::now() - read.timestamp.get();
+        }
+    });
+    const auto datagram_count = static_cast<double>(state.iterations() * burst_size);
+    state.counters["queue_us"] = static_cast<double>(queue_time.count()) / 1000.0 / datagram_count;
+}
+
+BENCHMARK(bench_single_datagrams);
+BENCHMARK(bench_timestamped_datagrams);
+BENCHMARK(bench_batched_datagrams);
+BENCHMARK(bench_segmented_datagrams);
+#endif
@@ -0,0 +1,85 @@
+#include "sockslib/frame_codec.hpp"
+#include "sockslib/socket.hpp"
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <vector>
+
+namespace {
+    // Frames per iteration, small enough to fit into the socket buffers, so one thread can write and read them
+    constexpr kstd::usize batch_size = 256;
+
+    struct Connection final {
+        sockslib::ServerSocket server_socket {1337, sockslib::ProtocolType::TCP};
+        sockslib::ClientSocket client_socket {"127.0.0.1", 1337, sockslib::ProtocolType::TCP};
+        sockslib::AcceptedSocket socket {std::move(server_socket.accept().get_or_throw())};
+    };
+
+    auto read_exact(const sockslib::AcceptedSocket& socket, kstd::u8* data, const kstd::usize size) -> void {
+        kstd::usize bytes_read = 0;
+        while(bytes_read < size) {
+            bytes_read += socket.read(data + bytes_read, size - bytes_read).get_or_throw();
+        }
+    }
+}// namespace
+
+// The hand-rolled way, one read for the prefix and one for the payload of every frame
+static void bench_hand_rolled_frames(benchmark::State& state) {
+    using namespace sockslib;
+    const auto payload_size = static_cast<kstd::usize>(state.range(0));
+    Connection connection {};
+    FrameEncoder encoder {LengthPrefix::FIXED_32};
+    const std::vector<kstd::u8> payload(payload_size);
+    for(kstd::usize i = 0; i < batch_size; ++i) {
+        encoder.encode(payload.data(), payload.size()).throw_if_error();
+    }
+    std::vector<kstd::u8> received_payload {};
+
+    for(auto _ : state) {
+        FrameEncoder batch_encoder {encoder};
+        batch_encoder.write_to(connection.client_socket).throw_if_error();
+        for(kstd::usize i = 0; i < batch_size; ++i) {
+            std::array<kstd::u8, 4> prefix {};
+            read_exact(connection.socket, prefix.data(), prefix.size());
+            const auto size = (kstd::usize {prefix[0]} << 24U) | (kstd::usize {prefix[1]} << 16U) |
+                              (kstd::usize {prefix[2]} << 8U) | prefix[3];
+            received_payload.resize(size);
+            read_exact(connection.socket, received_payload.data(), size);
+            benchmark::DoNotOptimize(received_payload.data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batch_size));
+}
+
+static void bench_decoded_frames(benchmark::State& state) {
+    using namespace sockslib;
+    const auto payload_size = static_cast<kstd::usize>(state.range(0));
+    Connection connection {};
+    FrameEncoder encoder {LengthPrefix::FIXED_32};
+    const std::vector<kstd::u8> payload(payload_size);
+    for(kstd::usize i = 0; i < batch_size; ++i) {
+        encoder.encode(payload.data(), payload.size()).throw_if_error();
+    }
+    FrameDecoder decoder {LengthPrefix::FIXED_32};
+
+    for(auto _ : state) {
+        FrameEncoder batch_encoder {encoder};
+        batch_encoder.write_to(connection.client_socket).throw_if_error();
+        kstd::usize frame_count = 0;
+        while(frame_count < batch_size) {
+            decoder.read_from(connection.socket).get_or_throw();
+            while(true) {
+                const auto frame = decoder.next().get_or_throw();
+                if(frame.is_empty()) {
+                    break;
+                }
+                benchmark::DoNotOptimize(frame.get().data);
+                ++frame_count;
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batch_size));
+}
+
+BENCHMARK(bench_hand_rolled_frames)->Arg(64)->Arg(1024);
+BENCHMARK(bench_decoded_frames)->Arg(64)->Arg(1024);
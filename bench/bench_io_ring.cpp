@@ -0,0 +1,99 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/io_ring.hpp"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr kstd::u32 connection_count = 8;
+    constexpr kstd::usize chunk_size = 64 * 1024;
+    constexpr kstd::usize bytes_per_connection = 16 * 1024 * 1024;
+
+    // Streams bytes_per_connection bytes over every connection and lets the receiver drain them until EOF
+    template<typename F>
+    void run_throughput(benchmark::State& state, F&& receive_all) {
+        using namespace sockslib;
+        for(auto _ : state) {
+            ServerSocket server_socket {1337, ProtocolType::TCP};
+            std::vector<std::thread> sender_threads {};
+            std::vector<AcceptedSocket> accepted_sockets {};
+            for(kstd::u32 i = 0; i < connection_count; ++i) {
+                ClientSocket client_socket {"127.0.0.1", 1337, ProtocolType::TCP};
+                accepted_sockets.push_back(std::move(server_socket.accept().get_or_throw()));
+                sender_threads.emplace_back([client_socket = std::move(client_socket)]() mutable {
+                    std::array<kstd::u8, chunk_size> chunk {};
+                    kstd::usize bytes_sent = 0;
+                    while(bytes_sent < bytes_per_connection) {
+                        bytes_sent += client_socket.write(chunk.data(), chunk.size()).get_or_throw();
+                    }
+                });
+            }
+
+            benchmark::DoNotOptimize(receive_all(accepted_sockets));
+            for(auto& thread : sender_threads) {
+                thread.join();
+            }
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * connection_count * bytes_per_connection));
+    }
+}// namespace
+
+static void bench_blocking_receive(benchmark::State& state) {
+    using namespace sockslib;
+    run_throughput(state, [](std::vector<AcceptedSocket>& sockets) {
+        std::vector<kstd::u8> buffer(chunk_size);
+        std::vector<bool> open(sockets.size(), true);
+        kstd::usize open_count = sockets.size();
+        kstd::usize bytes_received = 0;
+        while(open_count > 0) {
+            for(kstd::usize i = 0; i < sockets.size(); ++i) {
+                if(!open[i]) {
+                    continue;
+                }
+                const auto bytes_read = sockets[i].read(buffer.data(), buffer.size()).get_or_throw();
+                if(bytes_read == 0) {
+                    open[i] = false;
+                    --open_count;
+                }
+                bytes_received += bytes_read;
+            }
+        }
+        return bytes_received;
+    });
+}
+BENCHMARK(bench_blocking_receive)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void bench_io_ring_receive(benchmark::State& state) {
+    using namespace sockslib;
+    IoRing ring {connection_count, connection_count, chunk_size};
+    state.SetLabel(ring.uses_io_uring() ? "io_uring" : "fallback");
+    run_throughput(state, [&ring](std::vector<AcceptedSocket>& sockets) {
+        for(kstd::u32 i = 0; i < sockets.size(); ++i) {
+            ring.prepare_receive_fixed(sockets[i].socket_handle(), i, i).throw_if_error();
+        }
+
+        // Keep one receive per connection in flight and re-arm all completed ones with one submission
+        std::array<IoCompletion, connection_count> completions {};
+        kstd::u32 in_flight = connection_count;
+        kstd::usize bytes_received = 0;
+        while(in_flight > 0) {
+            ring.submit(1).throw_if_error();
+            const auto count = ring.reap(completions.data(), completions.size());
+            for(kstd::usize i = 0; i < count; ++i) {
+                const auto& completion = completions[i];
+                if(completion.result <= 0) {
+                    --in_flight;
+                    continue;
+                }
+                bytes_received += static_cast<kstd::usize>(completion.result);
+                const auto index = static_cast<kstd::u32>(completion.user_data);
+                ring.prepare_receive_fixed(sockets[index].socket_handle(), index, index).throw_if_error();
+            }
+        }
+        return bytes_received;
+    });
+}
+BENCHMARK(bench_io_ring_receive)->Unit(benchmark::kMillisecond)->UseRealTime();
+#endif
@@ -0,0 +1,59 @@
+#include "sockslib/io_stats.hpp"
+#include "sockslib/socket.hpp"
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <chrono>
+
+// Cost of counting one call, the per-thread counters skip the atomic read-modify-write of the shared ones
+static void bench_record_thread(benchmark::State& state) {
+    using namespace sockslib;
+    auto& statistics = detail::thread_io_statistics();
+    for(auto _ : state) {
+        statistics.record(IoOperation::READ, false, 64, 128, 0, std::chrono::nanoseconds {0});
+    }
+    benchmark::DoNotOptimize(statistics.snapshot());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void bench_record_shared(benchmark::State& state) {
+    using namespace sockslib;
+    static SocketStatistics statistics {};
+    for(auto _ : state) {
+        statistics.record(IoOperation::READ, false, 64, 128, 0, std::chrono::nanoseconds {0});
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Write and read of 64 bytes over loopback. Arg 0 only counts per thread, arg 1 also counts on attached socket
+// statistics and arg 2 adds the latency histogram. Comparing against a build without SOCKSLIB_IO_STATS gives the
+// overhead of the counting.
+static void bench_write_read(benchmark::State& state) {
+    using namespace sockslib;
+    ServerSocket server_socket {1337, ProtocolType::TCP};
+    ClientSocket client_socket {"127.0.0.1", 1337, ProtocolType::TCP};
+    AcceptedSocket socket {std::move(server_socket.accept().get_or_throw())};
+
+    SocketStatistics statistics {};
+    if(state.range(0) >= 1) {
+        socket.set_statistics(&statistics);
+        client_socket.set_statistics(&statistics);
+    }
+    set_io_latency_histogram(state.range(0) >= 2);
+
+    std::array<kstd::u8, 64> data {};
+    for(auto _ : state) {
+        socket.write(data.data(), data.size()).throw_if_error();
+        kstd::usize bytes_read = 0;
+        while(bytes_read < data.size()) {
+            bytes_read += client_socket.read(data.data() + bytes_read, data.size() - bytes_read).get_or_throw();
+        }
+    }
+    set_io_latency_histogram(false);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["io_stats"] = static_cast<double>(global_io_statistics()[IoOperation::READ].calls > 0);
+}
+
+BENCHMARK(bench_record_thread);
+BENCHMARK(bench_record_shared)->Threads(1)->Threads(4);
+BENCHMARK(bench_write_read)->Arg(0)->Arg(1)->Arg(2);
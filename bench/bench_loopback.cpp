@@ -0,0 +1,146 @@
+#include "sockslib/socket.hpp"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+    using clock = std::chrono::steady_clock;
+
+    auto no_delay_options() -> sockslib::SocketOptions {
+        sockslib::SocketOptions options {};
+        options.no_delay = true;
+        return options;
+    }
+
+    // Accepted sockets inherit TCP_NODELAY from the server socket, so no side waits for delayed ACKs
+    struct Connection final {
+        sockslib::ServerSocket server_socket {1337, sockslib::ProtocolType::TCP, false, no_delay_options()};
+        std::optional<sockslib::ClientSocket> client_socket {std::in_place, "127.0.0.1", 1337,
+                                                             sockslib::ProtocolType::TCP, no_delay_options()};
+        sockslib::AcceptedSocket socket {std::move(server_socket.accept().get_or_throw())};
+        std::thread peer_thread {};
+
+        // Closing the client ends the stream, which stops the peer thread
+        ~Connection() noexcept {
+            client_socket.reset();
+            if(peer_thread.joinable()) {
+                peer_thread.join();
+            }
+        }
+    };
+
+    template<typename S>
+    auto write_all(const S& socket, kstd::u8* data, const kstd::usize size) -> bool {
+        kstd::usize bytes_sent = 0;
+        while(bytes_sent < size) {
+            const auto result = socket.write(data + bytes_sent, size - bytes_sent);
+            if(!result) {
+                return false;
+            }
+            bytes_sent += result.get();
+        }
+        return true;
+    }
+
+    template<typename S>
+    auto read_exact(const S& socket, kstd::u8* data, const kstd::usize size) -> bool {
+        kstd::usize bytes_read = 0;
+        while(bytes_read < size) {
+            const auto result = socket.read(data + bytes_read, size - bytes_read);
+            if(!result || result.get() == 0) {
+                return false;
+            }
+            bytes_read += result.get();
+        }
+        return true;
+    }
+
+    // The percentiles are reported as counters, so the JSON output carries them next to the mean
+    auto report_percentiles(benchmark::State& state, std::vector<clock::duration>& round_trip_times) -> void {
+        if(round_trip_times.empty()) {
+            return;
+        }
+        std::sort(round_trip_times.begin(), round_trip_times.end());
+        const auto percentile = [&round_trip_times](const double fraction) {
+            const auto index = static_cast<kstd::usize>(fraction * static_cast<double>(round_trip_times.size() - 1));
+            return std::chrono::duration<double, std::micro> {round_trip_times[index]}.count();
+        };
+        state.counters["p50_us"] = percentile(0.5);
+        state.counters["p90_us"] = percentile(0.9);
+        state.counters["p99_us"] = percentile(0.99);
+        state.counters["p999_us"] = percentile(0.999);
+        state.counters["max_us"] = percentile(1.0);
+    }
+}// namespace
+
+// Round trip of one message of range(0) bytes, which the peer echoes back
+static void bench_ping_pong(benchmark::State& state) {
+    const auto payload_size = static_cast<kstd::usize>(state.range(0));
+    Connection connection {};
+    connection.peer_thread = std::thread {[&connection, payload_size] {
+        std::vector<kstd::u8> message(payload_size);
+        while(read_exact(connection.socket, message.data(), message.size()) &&
+              write_all(connection.socket, message.data(), message.size())) {
+        }
+    }};
+
+    std::vector<kstd::u8> message(payload_size);
+    std::vector<clock::duration> round_trip_times {};
+    round_trip_times.reserve(static_cast<kstd::usize>(state.max_iterations));
+    for(auto _ : state) {
+        const auto start = clock::now();
+        if(!write_all(*connection.client_socket, message.data(), message.size()) ||
+           !read_exact(*connection.client_socket, message.data(), message.size())) {
+            state.SkipWithError("Echo peer closed the connection");
+            break;
+        }
+        round_trip_times.push_back(clock::now() - start);
+    }
+    report_percentiles(state, round_trip_times);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload_size * 2));
+}
+
+// One-way bulk transfer in writes of range(0) bytes, the peer drains the stream
+static void bench_bulk_throughput(benchmark::State& state) {
+    const auto chunk_size = static_cast<kstd::usize>(state.range(0));
+    Connection connection {};
+    connection.peer_thread = std::thread {[&connection] {
+        std::vector<kstd::u8> buffer(256 * 1024);
+        while(true) {
+            const auto result = connection.socket.read(buffer.data(), buffer.size());
+            if(!result || result.get() == 0) {
+                return;
+            }
+        }
+    }};
+
+    std::vector<kstd::u8> chunk(chunk_size);
+    for(auto _ : state) {
+        if(!write_all(*connection.client_socket, chunk.data(), chunk.size())) {
+            state.SkipWithError("Draining peer closed the connection");
+            break;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * chunk_size));
+}
+
+// Connect and accept of one connection per iteration, both sides are closed right away
+static void bench_connection_setup(benchmark::State& state) {
+    using namespace sockslib;
+    ServerSocket server_socket {1337, ProtocolType::TCP};
+    for(auto _ : state) {
+        ClientSocket client_socket {"127.0.0.1", 1337, ProtocolType::TCP};
+        benchmark::DoNotOptimize(server_socket.accept().get_or_throw());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(bench_ping_pong)->Arg(16)->Arg(256)->Arg(4096)->Arg(64 * 1024)->UseRealTime();
+BENCHMARK(bench_bulk_throughput)->Arg(4 * 1024)->Arg(64 * 1024)->Arg(1024 * 1024)->UseRealTime();
+BENCHMARK(bench_connection_setup)->UseRealTime();
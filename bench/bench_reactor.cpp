@@ -0,0 +1,140 @@
+#include "sockslib/reactor.hpp"
+
+#if defined(PLATFORM_LINUX) && defined(KSTD_CPP_20)
+#include <benchmark/benchmark.h>
+#include <array>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    constexpr kstd::usize message_size = 64;
+
+    // Every connection sends one message per iteration, then all echoes are read back
+    template<typename F>
+    void run_echo(benchmark::State& state, F&& serve) {
+        using namespace sockslib;
+        const auto connection_count = static_cast<kstd::usize>(state.range(0));
+        ServerSocket server_socket {1337, ProtocolType::TCP};
+        auto server_thread = serve(server_socket, connection_count);
+
+        std::vector<ClientSocket> client_sockets {};
+        client_sockets.reserve(connection_count);
+        for(kstd::usize i = 0; i < connection_count; ++i) {
+            client_sockets.emplace_back("127.0.0.1", 1337, ProtocolType::TCP);
+        }
+
+        std::array<kstd::u8, message_size> message {};
+        for(auto _ : state) {
+            for(const auto& socket : client_sockets) {
+                socket.write(message.data(), message.size()).get_or_throw();
+            }
+            for(const auto& socket : client_sockets) {
+                kstd::usize bytes_read = 0;
+                while(bytes_read < message.size()) {
+                    bytes_read += socket.read(message.data() + bytes_read, message.size() - bytes_read).get_or_throw();
+                }
+            }
+        }
+
+        // Closing the clients lets the server side handlers finish
+        client_sockets.clear();
+        server_thread.join();
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * connection_count));
+    }
+
+    auto echo(sockslib::Reactor& reactor, sockslib::AcceptedSocket socket) -> sockslib::Task<> {
+        std::array<kstd::u8, message_size> buffer {};
+        while(true) {
+            const auto read_result = co_await socket.async_read(reactor, buffer.data(), buffer.size());
+            if(read_result.is_error() || read_result.get() == 0) {
+                co_return;
+            }
+            if((co_await socket.async_write(reactor, buffer.data(), read_result.get())).is_error()) {
+                co_return;
+            }
+        }
+    }
+
+    auto serve(sockslib::Reactor& reactor, const sockslib::ServerSocket& server_socket,
+               const kstd::usize connection_count) -> sockslib::Task<> {
+        for(kstd::usize i = 0; i < connection_count; ++i) {
+            auto accept_result = co_await server_socket.async_accept(reactor);
+            reactor.spawn(echo(reactor, std::move(accept_result.get_or_throw())));
+        }
+    }
+}// namespace
+
+static void bench_echo_thread_per_connection(benchmark::State& state) {
+    using namespace sockslib;
+    run_echo(state, [](const ServerSocket& server_socket, const kstd::usize connection_count) {
+        return std::thread {[&server_socket, connection_count] {
+            std::vector<std::thread> threads {};
+            for(kstd::usize i = 0; i < connection_count; ++i) {
+                threads.emplace_back([socket = std::move(server_socket.accept().get_or_throw())] {
+                    std::array<kstd::u8, message_size> buffer {};
+                    while(true) {
+                        const auto bytes_read = socket.read(buffer.data(), buffer.size()).get_or(0);
+                        if(bytes_read == 0 || socket.write(buffer.data(), bytes_read).is_error()) {
+                            return;
+                        }
+                    }
+                });
+            }
+            for(auto& thread : threads) {
+                thread.join();
+            }
+        }};
+    });
+}
+
+static void bench_echo_event_loop(benchmark::State& state) {
+    using namespace sockslib;
+    run_echo(state, [](const ServerSocket& server_socket, const kstd::usize connection_count) {
+        return std::thread {[&server_socket, connection_count] {
+            EventLoop event_loop {};
+            std::unordered_map<SocketHandle, AcceptedSocket> sockets {};
+            kstd::usize closed_count = 0;
+            event_loop.add(server_socket, [&](AcceptedSocket accepted_socket) {
+                const auto handle = accepted_socket.socket_handle();
+                sockets.emplace(handle, std::move(accepted_socket));
+                event_loop.add(handle, EventType::READ, [&, handle](auto) {
+                    const auto& socket = sockets.at(handle);
+                    std::array<kstd::u8, message_size> buffer {};
+                    while(true) {
+                        auto read_result = socket.try_read(buffer.data(), buffer.size());
+                        if(read_result && read_result.get().is_empty()) {
+                            return;
+                        }
+                        if(!read_result || read_result.get().get() == 0) {
+                            event_loop.remove(handle).throw_if_error();
+                            sockets.erase(handle);
+                            if(++closed_count == connection_count) {
+                                event_loop.stop();
+                            }
+                            return;
+                        }
+                        socket.try_write(buffer.data(), read_result.get().get()).throw_if_error();
+                    }
+                }).throw_if_error();
+            }).throw_if_error();
+            event_loop.run().throw_if_error();
+        }};
+    });
+}
+
+static void bench_echo_coroutines(benchmark::State& state) {
+    using namespace sockslib;
+    run_echo(state, [](const ServerSocket& server_socket, const kstd::usize connection_count) {
+        return std::thread {[&server_socket, connection_count] {
+            Reactor reactor {};
+            reactor.spawn(serve(reactor, server_socket, connection_count));
+            reactor.run().throw_if_error();
+        }};
+    });
+}
+
+BENCHMARK(bench_echo_thread_per_connection)->Arg(64)->Arg(1024)->UseRealTime();
+BENCHMARK(bench_echo_event_loop)->Arg(64)->Arg(1024)->UseRealTime();
+BENCHMARK(bench_echo_coroutines)->Arg(64)->Arg(1024)->UseRealTime();
+#endif
@@ -0,0 +1,110 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/datagram_socket.hpp"
+#include "sockslib/dns_resolver.hpp"
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Name server on 127.0.0.1:1337, which answers every A and AAAA query with one record and a TTL of 60 seconds
+    class StubDnsServer final {
+        sockslib::DatagramSocket _socket {1337};
+        std::thread _thread;
+
+        public:
+        StubDnsServer() {
+            _thread = std::thread {[this] {
+                std::array<kstd::u8, 512> query {};
+                while(true) {
+                    sockslib::SocketAddress sender {};
+                    const auto size = _socket.receive_from(query.data(), query.size(), sender).get_or_throw();
+                    if(size < 12) {
+                        return;
+                    }
+
+                    // The response repeats header and question and appends the record with a name pointer
+                    std::vector<kstd::u8> response {query.begin(), query.begin() + static_cast<std::ptrdiff_t>(size)};
+                    const auto type = response[size - 3];
+                    response[2] = 0x81;
+                    response[3] = 0x80;
+                    response[7] = 1;
+                    response.insert(response.end(), {0xC0, 0x0C, 0, type, 0, 1, 0, 0, 0, 60, 0});
+                    if(type == 28) {
+                        response.insert(response.end(),
+                                        {16, 0x20, 0x01, 0x0D, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1});
+                    }
+                    else {
+                        response.insert(response.end(), {4, 192, 0, 2, 1});
+                    }
+                    _socket.send_to(response.data(), response.size(), sender).throw_if_error();
+                }
+            }};
+        }
+
+        ~StubDnsServer() noexcept {
+            // An empty datagram stops the server
+            sockslib::DatagramSocket socket {};
+            const auto address = sockslib::SocketAddress::from_literal("127.0.0.1", 1337).get();
+            static_cast<void>(socket.send_to(nullptr, 0, address));
+            _thread.join();
+        }
+    };
+
+    auto stub_name_server() -> sockslib::SocketAddress {
+        return sockslib::SocketAddress::from_literal("127.0.0.1", 1337).get();
+    }
+}// namespace
+
+static void bench_parse_address_literal(benchmark::State& state) {
+    using namespace sockslib;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(SocketAddress::from_literal("192.0.2.1", 1337));
+        benchmark::DoNotOptimize(SocketAddress::from_literal("2001:db8::1", 1337));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * 2));
+}
+
+// The system configuration (getaddrinfo) answers localhost from /etc/hosts, repeated lookups hit the cache
+static void bench_resolve_system(benchmark::State& state) {
+    using namespace sockslib;
+    DnsResolver resolver {};
+    if(!resolver.resolve("localhost", 1337)) {
+        state.SkipWithError("localhost can't be resolved");
+        return;
+    }
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(resolver.resolve("localhost", 1337));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void bench_resolve_cached(benchmark::State& state) {
+    using namespace sockslib;
+    StubDnsServer server {};
+    DnsResolver resolver {stub_name_server()};
+    resolver.resolve("example.test", 1337).throw_if_error();
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(resolver.resolve("example.test", 1337));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// A and AAAA query to the stub name server over loopback per iteration
+static void bench_resolve_uncached(benchmark::State& state) {
+    using namespace sockslib;
+    StubDnsServer server {};
+    DnsResolver resolver {stub_name_server()};
+    for(auto _ : state) {
+        resolver.clear_cache();
+        resolver.resolve("example.test", 1337).throw_if_error();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(bench_parse_address_literal);
+BENCHMARK(bench_resolve_system);
+BENCHMARK(bench_resolve_cached);
+BENCHMARK(bench_resolve_uncached)->UseRealTime();
+#endif
@@ -0,0 +1,203 @@
+#include "sockslib/socket.hpp"
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+#ifdef PLATFORM_LINUX
+namespace {
+    // Requests are written as header and body, the write-write-read pattern which Nagle and delayed ACKs stall
+    constexpr kstd::usize header_size = 16;
+    constexpr kstd::usize message_size = 64;
+
+    struct Variant final {
+        const char* name;
+        sockslib::SocketOptions client_options;
+        sockslib::SocketOptions server_options;
+        bool quick_ack;// Reapplied by the server after every response, sending data clears it
+        bool cork;     // The client corks the request and uncorks it after the body
+    };
+
+    // Variants from 4 on tune the path without Nagle delays, which would hide their effect otherwise
+    auto create_variant(const kstd::usize index) -> Variant {
+        Variant variant {"default", {}, {}, false, false};
+        if(index >= 4) {
+            variant.client_options.no_delay = true;
+        }
+        switch(index) {
+            case 1:
+                variant.name = "no_delay";
+                variant.client_options.no_delay = true;
+                break;
+            case 2:
+                variant.name = "quick_ack";
+                variant.quick_ack = true;
+                break;
+            case 3:
+                variant.name = "cork";
+                variant.cork = true;
+                break;
+            case 4:
+                variant.name = "no_delay+busy_poll";
+                variant.client_options.busy_poll = std::chrono::microseconds {50};
+                variant.server_options.busy_poll = std::chrono::microseconds {50};
+                break;
+            case 5:
+                variant.name = "no_delay+small_buffers";
+                variant.client_options.send_buffer_size = 4096;
+                variant.client_options.receive_buffer_size = 4096;
+                variant.server_options.send_buffer_size = 4096;
+                variant.server_options.receive_buffer_size = 4096;
+                break;
+            case 6:
+                variant.name = "no_delay+not_sent_low_watermark";
+                variant.client_options.not_sent_low_watermark = 1U << 14;
+                variant.server_options.not_sent_low_watermark = 1U << 14;
+                break;
+            case 7:
+                variant.name = "no_delay+incoming_cpu";
+                variant.server_options.incoming_cpu = 0;
+                break;
+            default: break;
+        }
+        return variant;
+    }
+
+    auto read_exact(const sockslib::AcceptedSocket& socket, kstd::u8* data, const kstd::usize size) -> bool {
+        kstd::usize bytes_read = 0;
+        while(bytes_read < size) {
+            const auto result = socket.read(data + bytes_read, size - bytes_read);
+            if(!result || result.get() == 0) {
+                return false;
+            }
+            bytes_read += result.get();
+        }
+        return true;
+    }
+
+    // Answers every request with one response until the client closes the connection
+    auto run_server(const sockslib::AcceptedSocket& socket, const bool quick_ack) -> void {
+        sockslib::SocketOptions quick_ack_options {};
+        quick_ack_options.quick_ack = true;
+        std::array<kstd::u8, message_size> message {};
+        while(read_exact(socket, message.data(), message.size())) {
+            if(!socket.write(message.data(), message.size())) {
+                return;
+            }
+            if(quick_ack) {
+                static_cast<void>(socket.set_options(quick_ack_options));
+            }
+        }
+    }
+}// namespace
+
+// Round trip of one request over loopback, the argument selects the tuned options (see create_variant)
+static void bench_request_latency(benchmark::State& state) {
+    using namespace sockslib;
+    const auto variant = create_variant(static_cast<kstd::usize>(state.range(0)));
+    state.SetLabel(variant.name);
+
+    std::optional<ServerSocket> server_socket {};
+    std::optional<ClientSocket> client_socket {};
+    try {
+        server_socket.emplace(1337, ProtocolType::TCP, false, variant.server_options);
+        client_socket.emplace("127.0.0.1", 1337, ProtocolType::TCP, variant.client_options);
+    }
+    catch(const std::runtime_error& error) {
+        state.SkipWithError(error.what());// Raising SO_BUSY_POLL requires CAP_NET_ADMIN
+        return;
+    }
+    AcceptedSocket socket {std::move(server_socket->accept().get_or_throw())};
+    std::thread server_thread {[&socket, &variant] {
+        run_server(socket, variant.quick_ack);
+    }};
+
+    SocketOptions cork_options {};
+    SocketOptions uncork_options {};
+    cork_options.cork = true;
+    uncork_options.cork = false;
+    std::array<kstd::u8, message_size> request {};
+    std::array<kstd::u8, message_size> response {};
+    for(auto _ : state) {
+        if(variant.cork) {
+            client_socket->set_options(cork_options).throw_if_error();
+        }
+        client_socket->write(request.data(), header_size).get_or_throw();
+        client_socket->write(request.data() + header_size, message_size - header_size).get_or_throw();
+        if(variant.cork) {
+            client_socket->set_options(uncork_options).throw_if_error();
+        }
+
+        kstd::usize bytes_read = 0;
+        while(bytes_read < response.size()) {
+            bytes_read += client_socket->read(response.data() + bytes_read, response.size() - bytes_read)
+                                  .get_or_throw();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+
+    client_socket.reset();
+    server_thread.join();
+}
+
+// Connection setup plus one round trip, which TCP_DEFER_ACCEPT and TCP Fast Open shorten
+static void bench_connect_latency(benchmark::State& state) {
+    using namespace sockslib;
+    SocketOptions client_options {};
+    SocketOptions server_options {};
+    switch(state.range(0)) {
+        case 1:
+            state.SetLabel("defer_accept");
+            server_options.defer_accept = std::chrono::seconds {1};
+            break;
+        case 2:
+            // Falls back to a regular handshake unless net.ipv4.tcp_fastopen enables client and server (3)
+            state.SetLabel("fast_open");
+            server_options.fast_open = 256;
+            client_options.fast_open_connect = true;
+            break;
+        default: state.SetLabel("default"); break;
+    }
+
+    ServerSocket server_socket {1337, ProtocolType::TCP, false, server_options};
+    std::thread server_thread {[&server_socket] {
+        while(true) {
+            auto accept_result = server_socket.accept();
+            if(!accept_result) {
+                return;
+            }
+            std::array<kstd::u8, message_size> message {};
+            const auto& socket = accept_result.get();
+            if(!read_exact(socket, message.data(), message.size())) {
+                return;// An empty connection stops the server
+            }
+            static_cast<void>(socket.write(message.data(), message.size()));
+        }
+    }};
+
+    std::array<kstd::u8, message_size> request {};
+    std::array<kstd::u8, message_size> response {};
+    for(auto _ : state) {
+        ClientSocket client_socket {"127.0.0.1", 1337, ProtocolType::TCP, client_options};
+        client_socket.write(request.data(), request.size()).get_or_throw();
+        kstd::usize bytes_read = 0;
+        while(bytes_read < response.size()) {
+            bytes_read += client_socket.read(response.data() + bytes_read, response.size() - bytes_read)
+                                  .get_or_throw();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+
+    {
+        ClientSocket stop_socket {"127.0.0.1", 1337, ProtocolType::TCP};
+        kstd::u8 stop_byte = 0;
+        stop_socket.write(&stop_byte, sizeof(stop_byte)).get_or_throw();// Pushes the deferred connection out
+    }
+    server_thread.join();
+}
+
+BENCHMARK(bench_request_latency)->DenseRange(0, 7)->UseRealTime();
+BENCHMARK(bench_connect_latency)->DenseRange(0, 2)->UseRealTime();
+#endif
@@ -0,0 +1,41 @@
+#include "sockslib/socket.hpp"
+#include "sockslib/tcp_info.hpp"
+
+#include <benchmark/benchmark.h>
+#include <optional>
+#include <vector>
+
+// Cost of one TCP_INFO query, which bounds how many sockets a sampler can poll per interval
+static void bench_tcp_info(benchmark::State& state) {
+    using namespace sockslib;
+    ServerSocket server_socket {1337, ProtocolType::TCP};
+    ClientSocket client_socket {"127.0.0.1", 1337, ProtocolType::TCP};
+    AcceptedSocket socket {std::move(server_socket.accept().get_or_throw())};
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(client_socket.tcp_info().get_or_throw());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void bench_tcp_info_sampler(benchmark::State& state) {
+    using namespace sockslib;
+    const auto socket_count = static_cast<kstd::usize>(state.range(0));
+    ServerSocket server_socket {1337, ProtocolType::TCP};
+    std::vector<std::optional<ClientSocket>> client_sockets(socket_count);
+    std::vector<AcceptedSocket> sockets {};
+    sockets.reserve(socket_count);
+    TcpInfoSampler sampler {1024};
+    for(auto& client_socket : client_sockets) {
+        client_socket.emplace("127.0.0.1", 1337, ProtocolType::TCP);
+        sockets.emplace_back(std::move(server_socket.accept().get_or_throw()));
+        sampler.add(client_socket->socket_handle());
+    }
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(sampler.sample());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * socket_count));
+}
+
+BENCHMARK(bench_tcp_info);
+BENCHMARK(bench_tcp_info_sampler)->Arg(16)->Arg(256);
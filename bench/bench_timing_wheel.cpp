@@ -0,0 +1,93 @@
+#include "sockslib/timing_wheel.hpp"
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+    using clock = std::chrono::steady_clock;
+
+    // Idle timeouts of 30s to 60s, which are extended whenever their connection is active
+    auto random_timeouts(const kstd::usize count) -> std::vector<std::chrono::milliseconds> {
+        std::mt19937 random {42};
+        std::uniform_int_distribution<int> distribution {30000, 60000};
+        std::vector<std::chrono::milliseconds> timeouts(count);
+        for(auto& timeout : timeouts) {
+            timeout = std::chrono::milliseconds {distribution(random)};
+        }
+        return timeouts;
+    }
+}// namespace
+
+// Ordered timer set, which is what a min-heap or std::map based timer queue costs per touch
+static void bench_touch_ordered_map(benchmark::State& state) {
+    const auto timer_count = static_cast<kstd::usize>(state.range(0));
+    const auto timeouts = random_timeouts(timer_count);
+    const auto start = clock::now();
+    std::multimap<clock::time_point, kstd::usize> timers {};
+    std::vector<std::multimap<clock::time_point, kstd::usize>::iterator> handles {};
+    handles.reserve(timer_count);
+    for(kstd::usize i = 0; i < timer_count; ++i) {
+        handles.push_back(timers.emplace(start + timeouts[i], i));
+    }
+
+    kstd::usize index = 0;
+    auto now = start;
+    for(auto _ : state) {
+        index = (index + 7919) % timer_count;
+        now += std::chrono::microseconds {1};
+        timers.erase(handles[index]);
+        handles[index] = timers.emplace(now + timeouts[index], index);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void bench_touch_timing_wheel(benchmark::State& state) {
+    using namespace sockslib;
+    const auto timer_count = static_cast<kstd::usize>(state.range(0));
+    const auto timeouts = random_timeouts(timer_count);
+    const auto start = clock::now();
+    TimingWheel<kstd::usize> timing_wheel {std::chrono::milliseconds {10}, start};
+    std::vector<TimerId> handles {};
+    handles.reserve(timer_count);
+    for(kstd::usize i = 0; i < timer_count; ++i) {
+        handles.push_back(timing_wheel.schedule(start + timeouts[i], i));
+    }
+
+    kstd::usize index = 0;
+    auto now = start;
+    for(auto _ : state) {
+        index = (index + 7919) % timer_count;
+        now += std::chrono::microseconds {1};
+        timing_wheel.reschedule(handles[index], now + timeouts[index]);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Cost of one tick with all timers pending, which is what an idle event loop pays per wakeup
+static void bench_tick_timing_wheel(benchmark::State& state) {
+    using namespace sockslib;
+    const auto timer_count = static_cast<kstd::usize>(state.range(0));
+    const auto timeouts = random_timeouts(timer_count);
+    const auto start = clock::now();
+    TimingWheel<kstd::usize> timing_wheel {std::chrono::milliseconds {10}, start};
+    for(kstd::usize i = 0; i < timer_count; ++i) {
+        timing_wheel.schedule(start + std::chrono::hours {24} + timeouts[i], i);
+    }
+
+    auto now = start;
+    kstd::usize expired_count = 0;
+    for(auto _ : state) {
+        now += std::chrono::milliseconds {10};
+        expired_count += timing_wheel.advance(now, [](const kstd::usize) {
+        });
+    }
+    benchmark::DoNotOptimize(expired_count);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(bench_touch_ordered_map)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(bench_touch_timing_wheel)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(bench_tick_timing_wheel)->Arg(1 << 20);
@@ -0,0 +1,45 @@
+#include "sockslib/socket.hpp"
+#include "sockslib/tracing.hpp"
+
+#include <benchmark/benchmark.h>
+#include <array>
+
+// Cost of the hooks around an empty call: arg 0 without a sink, arg 1 with the ring buffer sink. Without
+// SOCKSLIB_TRACING both compile down to the call.
+static void bench_trace_call(benchmark::State& state) {
+    using namespace sockslib;
+    RingBufferTraceSink sink {};
+    set_trace_sink(state.range(0) != 0 ? &sink : nullptr);
+    kstd::isize value = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(trace_call(TraceEvent::SEND, 0, [&value]() {
+            benchmark::DoNotOptimize(value);
+            return value;
+        }));
+    }
+    set_trace_sink(nullptr);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void bench_traced_write_read(benchmark::State& state) {
+    using namespace sockslib;
+    ServerSocket server_socket {1337, ProtocolType::TCP};
+    ClientSocket client_socket {"127.0.0.1", 1337, ProtocolType::TCP};
+    AcceptedSocket socket {std::move(server_socket.accept().get_or_throw())};
+    RingBufferTraceSink sink {};
+    set_trace_sink(state.range(0) != 0 ? &sink : nullptr);
+
+    std::array<kstd::u8, 64> data {};
+    for(auto _ : state) {
+        socket.write(data.data(), data.size()).throw_if_error();
+        kstd::usize bytes_read = 0;
+        while(bytes_read < data.size()) {
+            bytes_read += client_socket.read(data.data() + bytes_read, data.size() - bytes_read).get_or_throw();
+        }
+    }
+    set_trace_sink(nullptr);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(bench_trace_call)->Arg(0)->Arg(1);
+BENCHMARK(bench_traced_write_read)->Arg(0)->Arg(1);
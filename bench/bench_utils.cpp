@@ -0,0 +1,79 @@
+#include "sockslib/utils.hpp"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <regex>
+#include <string>
+
+namespace {
+    // The regex based classifiers which were replaced by the hand-written parsers, kept as reference
+    auto regex_is_domain(const std::string& address) noexcept -> bool {
+        return address == "localhost" || std::regex_match(address, std::regex(R"(\b((?=[a-z0-9-]{1,63}\.)[a-z0-9]+(-[a-z0-9]+)*\.)+[a-z]{2,63}\b)"));
+    }
+
+    auto regex_is_ipv4_address(const std::string& address) noexcept -> bool {
+        return std::regex_match(address, std::regex(R"(([0-9]{1,3})\.([0-9]{1,3})\.([0-9]{1,3})\.([0-9]{1,3}))"));
+    }
+
+    auto regex_is_ipv6_address(const std::string& address) noexcept -> bool {
+        return std::regex_match(address, std::regex("(([0-9a-fA-F]{1,4}:){7,7}[0-9a-fA-F]{1,4}|([0-9a-fA-F]{1,4}:){1,7}:|([0-9a-fA-F]{1,4}:){1,6}:[0-9a-fA-F]{1,4}|([0-9a-fA-F]{1,4}:){1,5}(:[0-9a-fA-F]{1,4}){1,2}|([0-9a-fA-F]{1,4}:){1,4}(:[0-9a-fA-F]{1,4}){1,3}|([0-9a-fA-F]{1,4}:){1,3}(:[0-9a-fA-F]{1,4}){1,4}|([0-9a-fA-F]{1,4}:){1,2}(:[0-9a-fA-F]{1,4}){1,5}|[0-9a-fA-F]{1,4}:((:[0-9a-fA-F]{1,4}){1,6})|:((:[0-9a-fA-F]{1,4}){1,7}|:)|fe80:(:[0-9a-fA-F]{0,4}){0,4}%[0-9a-zA-Z]{1,}|::(ffff(:0{1,4}){0,1}:){0,1}((25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])\\.){3,3}(25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])|([0-9a-fA-F]{1,4}:){1,4}:((25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])\\.){3,3}(25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9]))"));
+    }
+
+    // Same inputs as in test/test_utils.cpp
+    const std::array<std::string, 3> domains {"cach30verfl0w.de", "subdomain.cach30verfl0w.de",
+                                              "subdomain.subdomain.cach30verfl0w.de"};
+
+    const std::array<std::string, 10> ipv4_addresses {"137.211.231.252", "233.234.201.205", "106.202.7.239",
+                                                      "253.27.111.16",   "73.174.233.160",  "215.120.157.87",
+                                                      "202.211.169.51",  "145.117.212.254", "177.1.100.5",
+                                                      "5.100.94.131"};
+
+    const std::array<std::string, 10> ipv6_addresses {
+            "1950:98bb:33fe:cc7a:e605:304c:070a:28c2", "dab9:74c5:d2f8:d8dd:62ec:adea:eb1e:7cc9",
+            "2458:fa28:bcb2:114b:46ff:000f:a4b5:2b96", "0f73:7ff3:c32a:c1e7:70d4:2018:f7c8:55f1",
+            "8787:4aa1:338c:a58e:17b9:9954:e814:e439", "8af2:9b43:80d2:8023:f9b3:84f4:e472:5f89",
+            "6777:2d94:f2d6:83b9:271a:e955:451f:227a", "fe80::5b3f:c05e:de1a:9df7%17",
+            "fe80::1%17",                              "::1"};
+
+    template<typename A, typename F>
+    void run_classifier(benchmark::State& state, const A& inputs, F&& classifier) {
+        for(auto _ : state) {
+            for(const auto& input : inputs) {
+                benchmark::DoNotOptimize(classifier(input));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * inputs.size()));
+    }
+}// namespace
+
+static void bench_regex_is_domain(benchmark::State& state) {
+    run_classifier(state, domains, regex_is_domain);
+}
+BENCHMARK(bench_regex_is_domain);
+
+static void bench_is_domain(benchmark::State& state) {
+    run_classifier(state, domains, [](const std::string& address) { return sockslib::is_domain(address); });
+}
+BENCHMARK(bench_is_domain);
+
+static void bench_regex_is_ipv4_address(benchmark::State& state) {
+    run_classifier(state, ipv4_addresses, regex_is_ipv4_address);
+}
+BENCHMARK(bench_regex_is_ipv4_address);
+
+static void bench_is_ipv4_address(benchmark::State& state) {
+    run_classifier(state, ipv4_addresses,
+                   [](const std::string& address) { return sockslib::is_ipv4_address(address); });
+}
+BENCHMARK(bench_is_ipv4_address);
+
+static void bench_regex_is_ipv6_address(benchmark::State& state) {
+    run_classifier(state, ipv6_addresses, regex_is_ipv6_address);
+}
+BENCHMARK(bench_regex_is_ipv6_address);
+
+static void bench_is_ipv6_address(benchmark::State& state) {
+    run_classifier(state, ipv6_addresses,
+                   [](const std::string& address) { return sockslib::is_ipv6_address(address); });
+}
+BENCHMARK(bench_is_ipv6_address);
@@ -0,0 +1,210 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/socket.hpp"
+#include "sockslib/splice_relay.hpp"
+#include "sockslib/zero_copy_sender.hpp"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+    constexpr kstd::usize chunk_size = 64 * 1024;
+
+    // Sparse file of size bytes, its pages come from the page cache without touching the disk
+    auto create_sparse_file(const kstd::usize size) -> int {
+        std::array<char, 20> path {"/tmp/sockslibXXXXXX"};
+        const auto file_handle = mkstemp(path.data());
+        unlink(path.data());
+        if(file_handle < 0 || ftruncate(file_handle, static_cast<off_t>(size)) < 0) {
+            throw std::runtime_error {"Unable to create temporary file"};
+        }
+        return file_handle;
+    }
+
+    template<typename S>
+    auto drain(const S& socket) -> kstd::usize {
+        std::vector<kstd::u8> buffer(chunk_size);
+        kstd::usize bytes_received = 0;
+        while(true) {
+            const auto bytes_read = socket.read(buffer.data(), buffer.size()).get_or_throw();
+            if(bytes_read == 0) {
+                return bytes_received;
+            }
+            bytes_received += bytes_read;
+        }
+    }
+
+    template<typename S>
+    auto write_all(const S& socket, kstd::u8* data, const kstd::usize size) -> void {
+        kstd::usize bytes_sent = 0;
+        while(bytes_sent < size) {
+            bytes_sent += socket.write(data + bytes_sent, size - bytes_sent).get_or_throw();
+        }
+    }
+
+    // Serves the file over loopback to a draining client, send_file gets the accepted socket and the file
+    template<typename F>
+    void run_file_transfer(benchmark::State& state, F&& send_file) {
+        using namespace sockslib;
+        const auto file_size = static_cast<kstd::usize>(state.range(0)) * 1024 * 1024 * 1024;
+        const auto file_handle = create_sparse_file(file_size);
+        for(auto _ : state) {
+            ServerSocket server_socket {1337, ProtocolType::TCP};
+            ClientSocket client_socket {"127.0.0.1", 1337, ProtocolType::TCP};
+            kstd::usize bytes_received = 0;
+            auto receiver_thread = std::thread {[&bytes_received, client_socket = std::move(client_socket)] {
+                bytes_received = drain(client_socket);
+            }};
+            {
+                auto socket = std::move(server_socket.accept().get_or_throw());
+                send_file(socket, file_handle, file_size);
+            }
+            receiver_thread.join();
+            benchmark::DoNotOptimize(bytes_received);
+        }
+        close(file_handle);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file_size));
+    }
+
+    // Sends 1GB in buffers of state.range(0) bytes to a draining client, send gets the accepted socket and buffer
+    template<typename F>
+    void run_bulk_send(benchmark::State& state, F&& send) {
+        using namespace sockslib;
+        constexpr kstd::usize total_size = 1024 * 1024 * 1024;
+        std::vector<kstd::u8> buffer(static_cast<kstd::usize>(state.range(0)));
+        for(auto _ : state) {
+            ServerSocket server_socket {1337, ProtocolType::TCP};
+            ClientSocket client_socket {"127.0.0.1", 1337, ProtocolType::TCP};
+            auto receiver_thread = std::thread {[client_socket = std::move(client_socket)] {
+                benchmark::DoNotOptimize(drain(client_socket));
+            }};
+            {
+                auto socket = std::move(server_socket.accept().get_or_throw());
+                send(socket, buffer, total_size);
+            }
+            receiver_thread.join();
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * total_size));
+    }
+
+    // Streams size bytes through a proxy between two loopback connections, relay gets both sockets of the proxy
+    template<typename F>
+    void run_relay(benchmark::State& state, F&& relay) {
+        using namespace sockslib;
+        const auto size = static_cast<kstd::usize>(state.range(0)) * 1024 * 1024 * 1024;
+        for(auto _ : state) {
+            ServerSocket upstream_server {1337, ProtocolType::TCP};
+            ServerSocket downstream_server {1338, ProtocolType::TCP};
+            ClientSocket upstream_client {"127.0.0.1", 1337, ProtocolType::TCP};
+            auto upstream_socket = std::move(upstream_server.accept().get_or_throw());
+            ClientSocket downstream_client {"127.0.0.1", 1338, ProtocolType::TCP};
+            auto downstream_socket = std::move(downstream_server.accept().get_or_throw());
+
+            auto sender_thread = std::thread {[size, client_socket = std::move(upstream_client)] {
+                std::vector<kstd::u8> chunk(chunk_size);
+                for(kstd::usize bytes_sent = 0; bytes_sent < size; bytes_sent += chunk_size) {
+                    write_all(client_socket, chunk.data(), chunk.size());
+                }
+            }};
+            kstd::usize bytes_received = 0;
+            auto receiver_thread = std::thread {[&bytes_received, socket = std::move(downstream_socket)] {
+                bytes_received = drain(socket);
+            }};
+
+            relay(upstream_socket, downstream_client);
+            {
+                // Closing the downstream connection ends the receiver
+                auto closed_client = std::move(downstream_client);
+            }
+            sender_thread.join();
+            receiver_thread.join();
+            benchmark::DoNotOptimize(bytes_received);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+    }
+}// namespace
+
+static void bench_file_copy_loop(benchmark::State& state) {
+    using namespace sockslib;
+    run_file_transfer(state, [](AcceptedSocket& socket, const int file_handle, const kstd::usize file_size) {
+        std::vector<kstd::u8> buffer(chunk_size);
+        for(kstd::usize offset = 0; offset < file_size;) {
+            const auto bytes_read = pread(file_handle, buffer.data(), buffer.size(), static_cast<off_t>(offset));
+            if(bytes_read <= 0) {
+                break;
+            }
+            write_all(socket, buffer.data(), static_cast<kstd::usize>(bytes_read));
+            offset += static_cast<kstd::usize>(bytes_read);
+        }
+    });
+}
+
+static void bench_file_sendfile(benchmark::State& state) {
+    using namespace sockslib;
+    run_file_transfer(state, [](AcceptedSocket& socket, const int file_handle, const kstd::usize file_size) {
+        benchmark::DoNotOptimize(socket.send_file(file_handle, 0, file_size).get_or_throw());
+    });
+}
+
+static void bench_relay_copy_loop(benchmark::State& state) {
+    using namespace sockslib;
+    run_relay(state, [](AcceptedSocket& source, ClientSocket& destination) {
+        std::vector<kstd::u8> buffer(chunk_size);
+        while(true) {
+            const auto bytes_read = source.read(buffer.data(), buffer.size()).get_or_throw();
+            if(bytes_read == 0) {
+                break;
+            }
+            write_all(destination, buffer.data(), bytes_read);
+        }
+    });
+}
+
+static void bench_relay_splice(benchmark::State& state) {
+    using namespace sockslib;
+    run_relay(state, [](AcceptedSocket& source, ClientSocket& destination) {
+        SpliceRelay relay {};
+        benchmark::DoNotOptimize(relay.forward_all(source.socket_handle(), destination.socket_handle()).get_or_throw());
+    });
+}
+
+static void bench_bulk_write(benchmark::State& state) {
+    using namespace sockslib;
+    run_bulk_send(state, [](AcceptedSocket& socket, std::vector<kstd::u8>& buffer, const kstd::usize total_size) {
+        for(kstd::usize bytes_sent = 0; bytes_sent < total_size; bytes_sent += buffer.size()) {
+            write_all(socket, buffer.data(), buffer.size());
+        }
+    });
+}
+
+static void bench_bulk_zero_copy(benchmark::State& state) {
+    using namespace sockslib;
+    run_bulk_send(state, [](AcceptedSocket& socket, std::vector<kstd::u8>& buffer, const kstd::usize total_size) {
+        // The buffer is never modified, so it is reused without waiting for the completions
+        ZeroCopySender sender {socket.socket_handle()};
+        const auto ignore_completion = [](kstd::u64, bool) {};
+        for(kstd::usize bytes_sent = 0; bytes_sent < total_size; bytes_sent += buffer.size()) {
+            kstd::usize offset = 0;
+            while(offset < buffer.size()) {
+                offset += sender.send(buffer.data() + offset, buffer.size() - offset, 0).get_or_throw();
+            }
+            sender.reap(ignore_completion).throw_if_error();
+        }
+        sender.flush(ignore_completion).throw_if_error();
+    });
+}
+
+// Sizes in bytes
+BENCHMARK(bench_bulk_write)->Arg(64 * 1024)->Arg(1024 * 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_bulk_zero_copy)->Arg(64 * 1024)->Arg(1024 * 1024)->Unit(benchmark::kMillisecond);
+
+// Sizes in GB
+BENCHMARK(bench_file_copy_loop)->Arg(2)->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_file_sendfile)->Arg(2)->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_relay_copy_loop)->Arg(2)->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_relay_splice)->Arg(2)->Unit(benchmark::kMillisecond);
+#endif
@@ -0,0 +1,21 @@
+#include <benchmark/benchmark.h>
+
+#ifndef SOCKSLIB_GIT_COMMIT
+#define SOCKSLIB_GIT_COMMIT "unknown"
+#endif
+
+auto main(int num_args, char** args) -> int {
+	benchmark::Initialize(&num_args, args);
+	if(benchmark::ReportUnrecognizedArguments(num_args, args)) {
+		return 1;
+	}
+
+	// The context is part of the JSON output (--benchmark_out), which identifies the runs being compared
+	benchmark::AddCustomContext("sockslib_git_commit", SOCKSLIB_GIT_COMMIT);
+#ifdef SOCKSLIB_IO_URING
+	benchmark::AddCustomContext("sockslib_io_uring", "enabled");
+#endif
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
@@ -0,0 +1,167 @@
+#pragma once
+#ifdef PLATFORM_LINUX
+#include <kstd/types.hpp>
+#include <kstd/option.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef KSTD_CPP_20
+#include <span>
+#endif
+
+namespace sockslib {
+    class BufferPool;
+
+    namespace detail {
+        // Bookkeeping of a slab, which is kept apart from the slab memory, so the slabs stay densely packed
+        struct BufferSlab final {
+            std::atomic<kstd::u32> reference_count;
+            kstd::u32 size;
+            kstd::u32 capacity;
+            BufferPool* pool;
+            BufferSlab* next;
+            kstd::u8* data;
+        };
+    }// namespace detail
+
+    /**
+     * Reference counted handle on a fixed-size buffer of a BufferPool. Copies share the same buffer, which returns
+     * to the pool when the last handle is dropped. The size is the count of valid bytes, not the capacity.
+     */
+    class PooledBuffer final {
+        detail::BufferSlab* _slab;
+
+        explicit PooledBuffer(detail::BufferSlab* slab) noexcept;
+
+        auto release() noexcept -> void;
+
+        friend class BufferPool;
+
+        public:
+        PooledBuffer() noexcept;
+        PooledBuffer(const PooledBuffer& other) noexcept;
+        PooledBuffer(PooledBuffer&& other) noexcept;
+        ~PooledBuffer() noexcept;
+
+        [[nodiscard]] inline auto is_empty() const noexcept -> bool {
+            return _slab == nullptr;
+        }
+
+        [[nodiscard]] inline auto data() noexcept -> kstd::u8* {
+            return _slab->data;
+        }
+
+        [[nodiscard]] inline auto data() const noexcept -> const kstd::u8* {
+            return _slab->data;
+        }
+
+        [[nodiscard]] inline auto size() const noexcept -> kstd::usize {
+            return _slab->size;
+        }
+
+        [[nodiscard]] inline auto capacity() const noexcept -> kstd::usize {
+            return _slab->capacity;
+        }
+
+        /**
+         * Sets the count of valid bytes, which is limited to the capacity.
+         */
+        inline auto resize(const kstd::usize size) noexcept -> void {
+            _slab->size = static_cast<kstd::u32>(std::min(size, capacity()));
+        }
+
+        [[nodiscard]] inline auto use_count() const noexcept -> kstd::u32 {
+            return _slab == nullptr ? 0 : _slab->reference_count.load(std::memory_order_relaxed);
+        }
+
+#ifdef KSTD_CPP_20
+        [[nodiscard]] inline auto as_span() const noexcept -> std::span<const kstd::u8> {
+            return {data(), size()};
+        }
+#endif
+
+        auto operator=(const PooledBuffer& other) noexcept -> PooledBuffer&;
+        auto operator=(PooledBuffer&& other) noexcept -> PooledBuffer&;
+    };
+
+    /**
+     * Slab allocator for receive buffers of one size. The buffers are carved out of large arenas, which are backed by
+     * huge pages if possible (explicit huge pages first, transparent huge pages otherwise). Released buffers go into
+     * the freelist of the releasing thread, which serves the next allocations of that thread without contention.
+     * Other freelists are only searched before a new arena is mapped. The pool has to outlive its buffers.
+     */
+    class BufferPool final {
+        struct alignas(64) FreeList final {
+            std::mutex mutex;
+            detail::BufferSlab* head = nullptr;
+        };
+
+        struct Arena final {
+            kstd::u8* memory;
+            kstd::usize size;
+            std::unique_ptr<detail::BufferSlab[]> slabs;// NOLINT
+        };
+
+        kstd::usize _buffer_size;
+        kstd::usize _max_buffers;
+        bool _huge_pages;
+        kstd::usize _free_list_count;
+        std::unique_ptr<FreeList[]> _free_lists;// NOLINT
+        std::mutex _arena_mutex;
+        std::vector<Arena> _arenas;
+        std::atomic<kstd::usize> _buffer_count;
+        std::atomic<kstd::usize> _used_count;
+        std::atomic<kstd::usize> _memory_size;
+
+        [[nodiscard]] auto local_free_list() const noexcept -> FreeList&;
+        [[nodiscard]] auto add_arena(FreeList& free_list) noexcept -> detail::BufferSlab*;
+        auto release(detail::BufferSlab* slab) noexcept -> void;
+
+        friend class PooledBuffer;
+
+        public:
+        /**
+         * Creates an empty pool, which maps arenas on demand until max_buffers buffers exist (zero means no limit).
+         * The buffer size is rounded up to a multiple of the cache line size.
+         */
+        explicit BufferPool(kstd::usize buffer_size = 16 * 1024, kstd::usize max_buffers = 0, bool huge_pages = true);
+        BufferPool(const BufferPool& other) = delete;
+        BufferPool(BufferPool&& other) = delete;
+        ~BufferPool() noexcept;
+
+        /**
+         * Borrows a buffer with a size of zero. An empty option is returned if the pool is exhausted or no further
+         * arena could be mapped.
+         */
+        [[nodiscard]] auto allocate() noexcept -> kstd::Option<PooledBuffer>;
+
+        [[nodiscard]] inline auto buffer_size() const noexcept -> kstd::usize {
+            return _buffer_size;
+        }
+
+        /**
+         * Count of buffers carved out of the arenas so far, borrowed or not.
+         */
+        [[nodiscard]] inline auto buffer_count() const noexcept -> kstd::usize {
+            return _buffer_count.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] inline auto used_count() const noexcept -> kstd::usize {
+            return _used_count.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Size of all mapped arenas in bytes.
+         */
+        [[nodiscard]] inline auto memory_size() const noexcept -> kstd::usize {
+            return _memory_size.load(std::memory_order_relaxed);
+        }
+
+        auto operator=(const BufferPool& other) -> BufferPool& = delete;
+        auto operator=(BufferPool&& other) -> BufferPool& = delete;
+    };
+}// namespace sockslib
+#endif
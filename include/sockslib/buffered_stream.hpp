@@ -0,0 +1,283 @@
+#pragma once
+
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "sockslib/socket.hpp"
+#include "sockslib/socket_error.hpp"
+
+namespace sockslib {
+    /**
+     * Buffering layer for a blocking ClientSocket or AcceptedSocket, which has to outlive the stream. Small writes are
+     * collected in the write buffer and sent with one syscall by flush, or once the next write would overflow the
+     * buffer. Reads are served from a ring buffer, which is refilled with one syscall as large as the free space
+     * allows, so a stream of small messages doesn't cost one syscall per message. Pending writes are not flushed
+     * implicitly, neither by reads nor on destruction.
+     */
+    template<typename S>
+    class BufferedStream final {
+        S* _socket;
+        std::unique_ptr<kstd::u8[]> _read_buffer;// NOLINT
+        kstd::usize _read_capacity;// Power of two, so positions wrap with a mask
+        kstd::usize _read_head;
+        kstd::usize _read_tail;
+        std::unique_ptr<kstd::u8[]> _write_buffer;// NOLINT
+        kstd::usize _write_capacity;
+        kstd::usize _write_size;
+
+        [[nodiscard]] static constexpr auto round_up_power_of_two(const kstd::usize value) noexcept -> kstd::usize {
+            kstd::usize result = 1;
+            while(result < value) {
+                result <<= 1U;
+            }
+            return result;
+        }
+
+        // Readable bytes of the ring buffer, the second region is the wrapped part and empty most of the time
+        [[nodiscard]] inline auto first_region() const noexcept -> kstd::usize {
+            const auto start = _read_head & (_read_capacity - 1);
+            return std::min(buffered_size(), _read_capacity - start);
+        }
+
+        inline auto copy_buffered(kstd::u8* data, const kstd::usize size) const noexcept -> void {
+            const auto start = _read_head & (_read_capacity - 1);
+            const auto first_size = std::min(size, _read_capacity - start);
+            std::memcpy(data, _read_buffer.get() + start, first_size);
+            std::memcpy(data + first_size, _read_buffer.get(), size - first_size);
+        }
+
+        inline auto append_buffered(std::vector<kstd::u8>& data, const kstd::usize size) -> void {
+            const auto offset = data.size();
+            data.resize(offset + size);
+            copy_buffered(data.data() + offset, size);
+            _read_head += size;
+        }
+
+        /**
+         * Receives into the largest contiguous free region of the ring buffer and returns the count of received
+         * bytes, zero signals that the peer closed the connection.
+         */
+        [[nodiscard]] auto fill() noexcept -> kstd::Result<kstd::usize, SocketError> {
+            if(buffered_size() == 0) {
+                _read_head = _read_tail = 0;
+            }
+            const auto start = _read_tail & (_read_capacity - 1);
+            const auto free_size = std::min(_read_capacity - buffered_size(), _read_capacity - start);
+            auto result = _socket->read(_read_buffer.get() + start, free_size);
+            if(result.is_error()) {
+                return kstd::Error {result.get_error()};
+            }
+            _read_tail += result.get();
+            return result.get();
+        }
+
+        [[nodiscard]] auto write_fully(const kstd::u8* data, const kstd::usize size) noexcept
+                -> kstd::Result<kstd::usize, SocketError> {
+            kstd::usize bytes_sent = 0;
+            while(bytes_sent < size) {
+                auto result = _socket->write(const_cast<kstd::u8*>(data) + bytes_sent, size - bytes_sent);// NOLINT
+                if(result.is_error()) {
+                    return kstd::Error {result.get_error()};
+                }
+                bytes_sent += result.get();
+            }
+            return bytes_sent;
+        }
+
+        public:
+        /**
+         * Creates a stream with a read buffer of at least read_capacity bytes (rounded up to a power of two) and a
+         * write buffer of write_capacity bytes, which is also the size threshold for flushing.
+         */
+        explicit BufferedStream(S& socket, kstd::usize read_capacity = 64 * 1024,
+                                kstd::usize write_capacity = 64 * 1024) :
+                _socket {&socket},
+                _read_buffer {std::make_unique<kstd::u8[]>(round_up_power_of_two(read_capacity))},// NOLINT
+                _read_capacity {round_up_power_of_two(read_capacity)},
+                _read_head {0},
+                _read_tail {0},
+                _write_buffer {std::make_unique<kstd::u8[]>(std::max<kstd::usize>(write_capacity, 1))},// NOLINT
+                _write_capacity {std::max<kstd::usize>(write_capacity, 1)},
+                _write_size {0} {
+        }
+
+        BufferedStream(const BufferedStream& other) = delete;
+        BufferedStream(BufferedStream&& other) noexcept = default;
+        ~BufferedStream() noexcept = default;
+
+        [[nodiscard]] inline auto socket() const noexcept -> S& {
+            return *_socket;
+        }
+
+        /**
+         * Count of received bytes, which were not consumed by a read yet.
+         */
+        [[nodiscard]] inline auto buffered_size() const noexcept -> kstd::usize {
+            return _read_tail - _read_head;
+        }
+
+        /**
+         * Count of written bytes, which wait for the next flush.
+         */
+        [[nodiscard]] inline auto pending_size() const noexcept -> kstd::usize {
+            return _write_size;
+        }
+
+        [[nodiscard]] inline auto read_capacity() const noexcept -> kstd::usize {
+            return _read_capacity;
+        }
+
+        [[nodiscard]] inline auto write_capacity() const noexcept -> kstd::usize {
+            return _write_capacity;
+        }
+
+        /**
+         * Appends the data to the write buffer. The pending bytes are flushed first if the data doesn't fit, data as
+         * large as the buffer is sent directly after that.
+         */
+        [[nodiscard]] auto write(const void* data, const kstd::usize size) noexcept -> kstd::Result<void, SocketError> {
+            if(_write_size + size > _write_capacity) {
+                if(auto result = flush(); result.is_error()) {
+                    return result;
+                }
+            }
+
+            if(size >= _write_capacity) {
+                if(auto result = write_fully(static_cast<const kstd::u8*>(data), size); result.is_error()) {
+                    return kstd::Error {result.get_error()};
+                }
+                return {};
+            }
+            std::memcpy(_write_buffer.get() + _write_size, data, size);
+            _write_size += size;
+            return {};
+        }
+
+        /**
+         * Sends all pending bytes. If that fails, the bytes which were not sent stay pending.
+         */
+        [[nodiscard]] auto flush() noexcept -> kstd::Result<void, SocketError> {
+            kstd::usize bytes_sent = 0;
+            while(bytes_sent < _write_size) {
+                auto result = _socket->write(_write_buffer.get() + bytes_sent, _write_size - bytes_sent);
+                if(result.is_error()) {
+                    std::memmove(_write_buffer.get(), _write_buffer.get() + bytes_sent, _write_size - bytes_sent);
+                    _write_size -= bytes_sent;
+                    return kstd::Error {result.get_error()};
+                }
+                bytes_sent += result.get();
+            }
+            _write_size = 0;
+            return {};
+        }
+
+        /**
+         * Reads up to size bytes like the read of the socket. Buffered bytes are returned without a syscall, reads
+         * at least as large as the read buffer bypass it if it is empty. Zero signals that the peer closed the
+         * connection.
+         */
+        [[nodiscard]] auto read(kstd::u8* data, const kstd::usize size) noexcept
+                -> kstd::Result<kstd::usize, SocketError> {
+            if(buffered_size() == 0) {
+                if(size >= _read_capacity) {
+                    return _socket->read(data, size);
+                }
+                auto result = fill();
+                if(result.is_error() || result.get() == 0) {
+                    return result;
+                }
+            }
+
+            const auto bytes_read = std::min(size, buffered_size());
+            copy_buffered(data, bytes_read);
+            _read_head += bytes_read;
+            return bytes_read;
+        }
+
+        /**
+         * Reads until size bytes were received and returns their count, which is only less than the size if the peer
+         * closed the connection.
+         */
+        [[nodiscard]] auto read_exact(kstd::u8* data, const kstd::usize size) noexcept
+                -> kstd::Result<kstd::usize, SocketError> {
+            kstd::usize bytes_read = 0;
+            while(bytes_read < size) {
+                auto result = read(data + bytes_read, size - bytes_read);
+                if(result.is_error()) {
+                    return result;
+                }
+                if(result.get() == 0) {
+                    break;
+                }
+                bytes_read += result.get();
+            }
+            return bytes_read;
+        }
+
+        /**
+         * Appends the received bytes up to and including the delimiter to data and returns the count of appended
+         * bytes. The buffered bytes are scanned with memchr, which is vectorized by the C library. If the peer closes
+         * the connection first, the remaining bytes are appended without delimiter, so zero signals a closed
+         * connection without further data.
+         */
+        [[nodiscard]] auto read_until(const kstd::u8 delimiter, std::vector<kstd::u8>& data)
+                -> kstd::Result<kstd::usize, SocketError> {
+            kstd::usize bytes_read = 0;
+            while(true) {
+                // Scan the contiguous region first, then the wrapped part of the ring buffer
+                const auto first_size = first_region();
+                const auto* first_data = _read_buffer.get() + (_read_head & (_read_capacity - 1));
+                const auto* match = static_cast<const kstd::u8*>(std::memchr(first_data, delimiter, first_size));
+                if(match != nullptr) {
+                    const auto size = static_cast<kstd::usize>(match - first_data) + 1;
+                    append_buffered(data, size);
+                    return bytes_read + size;
+                }
+                match = static_cast<const kstd::u8*>(
+                        std::memchr(_read_buffer.get(), delimiter, buffered_size() - first_size));
+                if(match != nullptr) {
+                    const auto size = first_size + static_cast<kstd::usize>(match - _read_buffer.get()) + 1;
+                    append_buffered(data, size);
+                    return bytes_read + size;
+                }
+
+                bytes_read += buffered_size();
+                append_buffered(data, buffered_size());
+                auto result = fill();
+                if(result.is_error()) {
+                    return result;
+                }
+                if(result.get() == 0) {
+                    return bytes_read;
+                }
+            }
+        }
+
+        /**
+         * Copies up to size bytes into data without consuming them, receiving until that many bytes are buffered or
+         * the peer closed the connection. The size is limited to the capacity of the read buffer.
+         */
+        [[nodiscard]] auto peek(kstd::u8* data, kstd::usize size) noexcept -> kstd::Result<kstd::usize, SocketError> {
+            size = std::min(size, _read_capacity);
+            while(buffered_size() < size) {
+                auto result = fill();
+                if(result.is_error()) {
+                    return result;
+                }
+                if(result.get() == 0) {
+                    break;
+                }
+            }
+
+            const auto bytes_peeked = std::min(size, buffered_size());
+            copy_buffered(data, bytes_peeked);
+            return bytes_peeked;
+        }
+
+        auto operator=(const BufferedStream& other) -> BufferedStream& = delete;
+        auto operator=(BufferedStream&& other) noexcept -> BufferedStream& = default;
+    };
+}// namespace sockslib
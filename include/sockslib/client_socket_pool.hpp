@@ -0,0 +1,142 @@
+#pragma once
+#ifdef PLATFORM_LINUX
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "sockslib/socket.hpp"
+
+namespace sockslib {
+    class ClientSocketPool;
+
+    struct ClientSocketPoolMetrics {
+        kstd::u64 lease_count;
+        kstd::u64 hit_count;     // Leases served with an idle connection
+        kstd::u64 miss_count;    // Leases, which had to establish a new connection
+        kstd::u64 stale_count;   // Idle connections closed by the peer, detected when leasing them
+        kstd::u64 eviction_count;// Idle connections closed because of the idle cap or timeout
+        std::chrono::nanoseconds total_wait_time;
+        std::chrono::nanoseconds max_wait_time;
+
+        [[nodiscard]] inline auto hit_rate() const noexcept -> double {
+            return lease_count > 0 ? static_cast<double>(hit_count) / static_cast<double>(lease_count) : 0.0;
+        }
+
+        /**
+         * Average time of a lease including the connection establishment of misses.
+         */
+        [[nodiscard]] inline auto average_wait_time() const noexcept -> std::chrono::nanoseconds {
+            return lease_count > 0 ? total_wait_time / static_cast<kstd::i64>(lease_count) : std::chrono::nanoseconds {0};
+        }
+    };
+
+    /**
+     * Connection leased from a pool, which goes back into the pool when the lease is destroyed. Connections with a
+     * broken state (e.g. a partially read response) have to be discarded instead.
+     */
+    class PooledClientSocket final {
+        ClientSocketPool* _pool;
+        std::string _key;
+        ClientSocket _socket;
+        bool _reusable;
+
+        friend class ClientSocketPool;
+
+        PooledClientSocket(ClientSocketPool* pool, std::string key, ClientSocket socket) noexcept;
+
+        public:
+        PooledClientSocket(const PooledClientSocket& other) = delete;
+        PooledClientSocket(PooledClientSocket&& other) noexcept;
+        ~PooledClientSocket() noexcept;
+
+        [[nodiscard]] inline auto get() noexcept -> ClientSocket& {
+            return _socket;
+        }
+
+        [[nodiscard]] inline auto operator->() noexcept -> ClientSocket* {
+            return &_socket;
+        }
+
+        /**
+         * Closes the connection when the lease ends instead of returning it into the pool.
+         */
+        inline auto discard() noexcept -> void {
+            _reusable = false;
+        }
+
+        auto operator=(const PooledClientSocket& other) -> PooledClientSocket& = delete;
+        auto operator=(PooledClientSocket&& other) -> PooledClientSocket& = delete;
+    };
+
+    /**
+     * Keeps connected client sockets per host, port and protocol alive for reuse, which saves the resolution and
+     * handshake of a new connection. Idle connections are checked with a non-blocking peek before they are leased and
+     * reused in LIFO order, so the most recently used connections stay warm while the oldest ones time out. The pool
+     * has to outlive its leases.
+     */
+    class ClientSocketPool final {
+        struct IdleSocket {
+            ClientSocket socket;
+            std::chrono::steady_clock::time_point idle_since;
+        };
+
+        struct Endpoint {
+            std::deque<IdleSocket> idle_sockets;
+            kstd::usize leased_count;
+        };
+
+        kstd::usize _max_idle_per_endpoint;
+        kstd::usize _max_connections_per_endpoint;
+        std::chrono::milliseconds _idle_timeout;
+        std::chrono::milliseconds _lease_timeout;
+        mutable std::mutex _mutex;
+        std::condition_variable _release_condition;
+        std::unordered_map<std::string, Endpoint> _endpoints;
+        ClientSocketPoolMetrics _metrics;
+
+        friend class PooledClientSocket;
+
+        auto release(const std::string& key, ClientSocket socket, bool reusable) noexcept -> void;
+        auto record_lease(std::chrono::steady_clock::time_point start, bool hit) noexcept -> void;
+
+        public:
+        /**
+         * Keeps up to max_idle_per_endpoint idle connections per endpoint for idle_timeout. With a connection limit
+         * (zero means unlimited), leases wait up to lease_timeout for a connection to be released. Connecting a new
+         * connection is limited by the remaining lease_timeout as well.
+         */
+        explicit ClientSocketPool(kstd::usize max_idle_per_endpoint = 8,
+                                  std::chrono::milliseconds idle_timeout = std::chrono::seconds {60},
+                                  kstd::usize max_connections_per_endpoint = 0,
+                                  std::chrono::milliseconds lease_timeout = std::chrono::seconds {30});
+        ClientSocketPool(const ClientSocketPool& other) = delete;
+        ClientSocketPool(ClientSocketPool&& other) = delete;
+        ~ClientSocketPool() noexcept = default;
+
+        /**
+         * Leases an idle connection to the endpoint or establishes a new one.
+         */
+        [[nodiscard]] auto lease(std::string_view host, kstd::u16 port, ProtocolType protocol_type = ProtocolType::TCP)
+                -> kstd::Result<PooledClientSocket>;
+
+        /**
+         * Closes all connections, which are idle for longer than the idle timeout, and returns their count. Expired
+         * connections are closed when leasing as well, this frees the connections of endpoints, which aren't used
+         * anymore.
+         */
+        auto evict_idle() noexcept -> kstd::usize;
+
+        [[nodiscard]] auto idle_count() const noexcept -> kstd::usize;
+
+        [[nodiscard]] auto metrics() const noexcept -> ClientSocketPoolMetrics;
+
+        auto operator=(const ClientSocketPool& other) -> ClientSocketPool& = delete;
+        auto operator=(ClientSocketPool&& other) -> ClientSocketPool& = delete;
+    };
+}// namespace sockslib
+#endif
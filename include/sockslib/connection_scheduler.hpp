@@ -0,0 +1,128 @@
+#pragma once
+#ifdef PLATFORM_LINUX
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include "sockslib/socket.hpp"
+
+namespace sockslib {
+    /**
+     * Invoked whenever the connection is readable, on the worker which picked it up. The handler may stop before the
+     * socket is drained, it is invoked again for the remaining data. Returning false closes the connection.
+     */
+    using ScheduledHandler = std::function<bool(kstd::usize worker_index, AcceptedSocket& socket)>;
+
+    /**
+     * Multi-core connection runtime with work stealing. Every connection is owned by the epoll instance of one worker
+     * (assigned round-robin), which moves the readable connections into its local run queue. Workers without work
+     * steal half of the run queue of another worker, so a few busy connections can't keep one core saturated while
+     * the other ones sit idle. A worker which queued more connections than it can run wakes up a sleeping worker.
+     *
+     * Connections are armed one-shot, so a connection is never handled by two workers at the same time and its handler
+     * needs no synchronization. Worker i is pinned to CPU i (modulo the CPU count).
+     */
+    class ConnectionScheduler final {
+        struct ScheduledConnection final {
+            AcceptedSocket socket;
+            const ServerSocket* server_socket;// Listeners accept instead of invoking the handler
+            kstd::usize owner_index;
+        };
+
+        struct alignas(64) Worker final {
+            int epoll_handle = -1;
+            int wakeup_handle = -1;
+            std::mutex queue_mutex;
+            std::deque<ScheduledConnection*> run_queue;
+            std::atomic_bool sleeping {false};
+            std::atomic<kstd::usize> handled_count {0};
+            std::atomic<kstd::usize> stolen_count {0};
+            std::thread thread;
+        };
+
+        ScheduledHandler _handler;
+        bool _work_stealing;
+        kstd::usize _worker_count;
+        std::unique_ptr<Worker[]> _workers;// NOLINT
+        std::atomic_bool _running;
+        std::atomic_bool _stopped;// The handles are closed, so the workers can't be started again
+        std::atomic<kstd::usize> _next_worker;
+        std::mutex _connections_mutex;
+        std::unordered_map<ScheduledConnection*, std::unique_ptr<ScheduledConnection>> _connections;
+
+        [[nodiscard]] auto register_connection(std::unique_ptr<ScheduledConnection> connection) noexcept
+                -> kstd::Result<void>;
+        auto release_connection(ScheduledConnection* connection) noexcept -> void;
+        auto run_worker(kstd::usize worker_index) noexcept -> void;
+        auto run_connection(kstd::usize worker_index, ScheduledConnection* connection) noexcept -> void;
+        auto poll_worker(kstd::usize worker_index, int timeout_ms) noexcept -> kstd::usize;
+        [[nodiscard]] auto steal(kstd::usize worker_index) noexcept -> bool;
+        [[nodiscard]] auto has_queued_work() noexcept -> bool;
+        auto wake_sleeping_worker(kstd::usize worker_index) noexcept -> void;
+
+        public:
+        /**
+         * Creates the workers without starting them. Without work stealing, every connection is only handled by the
+         * worker it was assigned to, which is the static sharding of the ServerSocketGroup.
+         */
+        ConnectionScheduler(kstd::usize worker_count, ScheduledHandler handler, bool work_stealing = true);
+        ConnectionScheduler(const ConnectionScheduler& other) = delete;
+        ConnectionScheduler(ConnectionScheduler&& other) noexcept = delete;
+        ~ConnectionScheduler() noexcept;
+
+        /**
+         * Starts the worker threads, which fails once the scheduler was stopped.
+         */
+        [[nodiscard]] auto start() noexcept -> kstd::Result<void>;
+
+        /**
+         * Wakes the workers up, waits for them to finish and closes all connections. The scheduler can't be started
+         * again afterwards.
+         */
+        auto stop() noexcept -> void;
+
+        /**
+         * Hands the connection over to the next worker in round-robin order. The socket is switched into non-blocking
+         * mode. This function is safe to call from any thread.
+         */
+        [[nodiscard]] auto add(AcceptedSocket socket) noexcept -> kstd::Result<void>;
+
+        /**
+         * Accepts the connections of the server socket on the workers and adds them like add. The server socket has to
+         * outlive the scheduler.
+         */
+        [[nodiscard]] auto listen(const ServerSocket& server_socket) noexcept -> kstd::Result<void>;
+
+        [[nodiscard]] inline auto worker_count() const noexcept -> kstd::usize {
+            return _worker_count;
+        }
+
+        /**
+         * Count of handler invocations on the worker.
+         */
+        [[nodiscard]] inline auto handled_count(const kstd::usize worker_index) const noexcept -> kstd::usize {
+            return _workers[worker_index].handled_count.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Count of ready connections, which the worker stole from the run queues of other workers.
+         */
+        [[nodiscard]] inline auto stolen_count(const kstd::usize worker_index) const noexcept -> kstd::usize {
+            return _workers[worker_index].stolen_count.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Count of registered connections, including the listeners.
+         */
+        [[nodiscard]] auto connection_count() noexcept -> kstd::usize;
+
+        auto operator=(const ConnectionScheduler& other) -> ConnectionScheduler& = delete;
+        auto operator=(ConnectionScheduler&& other) noexcept -> ConnectionScheduler& = delete;
+    };
+}// namespace sockslib
+#endif
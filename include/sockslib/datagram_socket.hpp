@@ -0,0 +1,215 @@
+#pragma once
+#ifdef PLATFORM_LINUX
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <kstd/language.hpp>
+#include <algorithm>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include "sockslib/socket.hpp"
+#include "sockslib/socket_address.hpp"
+
+#ifdef KSTD_CPP_20
+#include <span>
+#endif
+
+namespace sockslib {
+    /**
+     * Preallocated set of datagram slots with their peer addresses, which are transferred with one recvmmsg or
+     * sendmmsg call. Datagrams larger than the slot size are truncated when received.
+     */
+    class DatagramBatch final {
+        kstd::usize _max_datagram_size;
+        kstd::usize _size;
+        std::vector<kstd::u8> _buffer;
+        std::vector<SocketAddress> _addresses;
+        std::vector<iovec> _iovecs;
+        std::vector<mmsghdr> _headers;
+
+        friend class DatagramSocket;
+
+        public:
+        DatagramBatch(kstd::usize capacity, kstd::usize max_datagram_size);
+        DatagramBatch(const DatagramBatch& other) = delete;
+        DatagramBatch(DatagramBatch&& other) noexcept = default;
+        ~DatagramBatch() noexcept = default;
+
+        [[nodiscard]] inline auto size() const noexcept -> kstd::usize {
+            return _size;
+        }
+
+        [[nodiscard]] inline auto capacity() const noexcept -> kstd::usize {
+            return _headers.size();
+        }
+
+        [[nodiscard]] inline auto max_datagram_size() const noexcept -> kstd::usize {
+            return _max_datagram_size;
+        }
+
+        [[nodiscard]] inline auto data(const kstd::usize index) const noexcept -> const kstd::u8* {
+            return static_cast<const kstd::u8*>(_iovecs[index].iov_base);
+        }
+
+        [[nodiscard]] inline auto datagram_size(const kstd::usize index) const noexcept -> kstd::usize {
+            return _iovecs[index].iov_len;
+        }
+
+#ifdef KSTD_CPP_20
+        [[nodiscard]] inline auto datagram(const kstd::usize index) const noexcept -> std::span<const kstd::u8> {
+            return {data(index), datagram_size(index)};
+        }
+#endif
+
+        /**
+         * Sender of a received datagram or receiver of a datagram to send.
+         */
+        [[nodiscard]] inline auto address(const kstd::usize index) const noexcept -> const SocketAddress& {
+            return _addresses[index];
+        }
+
+        /**
+         * Copies the datagram into the next free slot, returns false if the batch is full or the datagram too large.
+         */
+        [[nodiscard]] auto push(const void* data, kstd::usize size, const SocketAddress& address) noexcept -> bool;
+
+        auto clear() noexcept -> void;
+
+        auto operator=(const DatagramBatch& other) -> DatagramBatch& = delete;
+        auto operator=(DatagramBatch&& other) noexcept -> DatagramBatch& = default;
+    };
+
+    /**
+     * View on a buffer of equally sized datagrams (except for the last one, which may be shorter), as received with
+     * UDP generic receive offload.
+     */
+    class DatagramSegments final {
+        const kstd::u8* _data;
+        kstd::usize _size;
+        kstd::usize _segment_size;
+
+        public:
+        DatagramSegments(const kstd::u8* data, const kstd::usize size, const kstd::usize segment_size) noexcept :
+                _data {data},
+                _size {size},
+                _segment_size {segment_size > 0 ? segment_size : size} {
+        }
+
+        [[nodiscard]] inline auto count() const noexcept -> kstd::usize {
+            return _segment_size > 0 ? (_size + _segment_size - 1) / _segment_size : 0;
+        }
+
+        [[nodiscard]] inline auto total_size() const noexcept -> kstd::usize {
+            return _size;
+        }
+
+        [[nodiscard]] inline auto data(const kstd::usize index) const noexcept -> const kstd::u8* {
+            return _data + index * _segment_size;
+        }
+
+        [[nodiscard]] inline auto size(const kstd::usize index) const noexcept -> kstd::usize {
+            return std::min(_segment_size, _size - index * _segment_size);
+        }
+
+#ifdef KSTD_CPP_20
+        [[nodiscard]] inline auto operator[](const kstd::usize index) const noexcept -> std::span<const kstd::u8> {
+            return {data(index), size(index)};
+        }
+#endif
+    };
+
+    class DatagramSocket final : Socket {
+        AddressType _address_type;
+
+        public:
+        /**
+         * Creates an unbound socket, which gets an ephemeral port assigned with the first send.
+         */
+        explicit DatagramSocket(AddressType address_type = AddressType::IPV4);
+
+        /**
+         * Creates a socket bound to the port on all interfaces.
+         */
+        DatagramSocket(kstd::u16 port, AddressType address_type = AddressType::IPV4);
+        DatagramSocket(const DatagramSocket& other) = delete;
+        DatagramSocket(DatagramSocket&& other) noexcept;
+        ~DatagramSocket() noexcept final;
+
+        using Socket::set_blocking;
+        using Socket::set_options;
+        using Socket::get_options;
+        using Socket::set_statistics;
+        using Socket::statistics;
+        using Socket::set_timestamping;
+        using Socket::try_read_transmit_timestamp;
+
+        [[nodiscard]] inline auto address_type() const noexcept -> AddressType {
+            return _address_type;
+        }
+
+        [[nodiscard]] inline auto socket_handle() const noexcept -> SocketHandle {
+            return _socket_handle;
+        }
+
+        [[nodiscard]] auto local_address() const noexcept -> kstd::Result<SocketAddress>;
+
+        [[nodiscard]] auto send_to(const void* data, kstd::usize size, const SocketAddress& address) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+        [[nodiscard]] auto receive_from(kstd::u8* data, kstd::usize size, SocketAddress& address) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+
+        /**
+         * Non-blocking variants of send_to and receive_from. An empty option signals that the operation would block.
+         */
+        [[nodiscard]] auto try_send_to(const void* data, kstd::usize size, const SocketAddress& address) const noexcept
+                -> kstd::Result<kstd::Option<kstd::usize>, SocketError>;
+        [[nodiscard]] auto try_receive_from(kstd::u8* data, kstd::usize size, SocketAddress& address) const noexcept
+                -> kstd::Result<kstd::Option<kstd::usize>, SocketError>;
+
+        /**
+         * Variant of receive_from, which also returns the receive timestamp of the kernel, see
+         * Socket::set_timestamping.
+         */
+        [[nodiscard]] auto receive_from_timestamped(kstd::u8* data, kstd::usize size,
+                                                    SocketAddress& address) const noexcept
+                -> kstd::Result<TimestampedRead, SocketError>;
+
+        /**
+         * Sends all datagrams of the batch with as few sendmmsg calls as possible and returns the count of sent
+         * datagrams, which is only less than the batch size (down to zero) if the socket would block.
+         */
+        [[nodiscard]] auto send_batch(DatagramBatch& batch) const noexcept -> kstd::Result<kstd::usize, SocketError>;
+
+        /**
+         * Replaces the content of the batch with up to its capacity of datagrams from one recvmmsg call. A blocking
+         * socket waits for the first datagram only and returns the count of received datagrams, which is zero if the
+         * socket would block.
+         */
+        [[nodiscard]] auto receive_batch(DatagramBatch& batch) const noexcept -> kstd::Result<kstd::usize, SocketError>;
+
+        /**
+         * Sends the buffer as datagrams of segment_size bytes (the last one may be shorter) with one syscall, the
+         * kernel or NIC splits it up (UDP generic segmentation offload, Linux 4.18+). The buffer is limited to 64KB.
+         */
+        [[nodiscard]] auto send_segmented(const void* data, kstd::usize size, kstd::u16 segment_size,
+                                          const SocketAddress& address) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+
+        /**
+         * Lets the kernel coalesce consecutive datagrams of the same sender into one buffer (UDP generic receive
+         * offload, Linux 5.0+), which are received with receive_coalesced.
+         */
+        [[nodiscard]] auto set_receive_offload(bool enabled) const noexcept -> kstd::Result<void, SocketError>;
+
+        /**
+         * Receives one or multiple coalesced datagrams of one sender. The buffer should hold 64KB, otherwise
+         * coalesced datagrams get truncated.
+         */
+        [[nodiscard]] auto receive_coalesced(kstd::u8* data, kstd::usize size, SocketAddress& address) const noexcept
+                -> kstd::Result<DatagramSegments, SocketError>;
+
+        auto operator=(const DatagramSocket& other) -> DatagramSocket& = delete;
+        auto operator=(DatagramSocket&& other) noexcept -> DatagramSocket&;
+    };
+}// namespace sockslib
+#endif
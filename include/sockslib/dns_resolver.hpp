@@ -0,0 +1,124 @@
+#pragma once
+#ifdef PLATFORM_LINUX
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <kstd/option.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "sockslib/socket_address.hpp"
+#include "sockslib/socket_error.hpp"
+
+namespace sockslib {
+    using ResolveCallback = std::function<void(kstd::Result<std::vector<SocketAddress>> result)>;
+
+    /**
+     * Caching resolver, which returns all addresses of a host. Asynchronous lookups run on a small pool of worker
+     * threads. The destructor waits until the pending asynchronous lookups are finished.
+     *
+     * With the system configuration, the lookups go through getaddrinfo, so /etc/hosts, the search domains and all
+     * name servers of resolv.conf and nsswitch.conf apply. getaddrinfo doesn't return TTLs, so results (and names
+     * without addresses) are cached for 30 seconds.
+     *
+     * With a specific name server, it works as a stub resolver, which queries the A and AAAA records in parallel over
+     * UDP. Results are cached for the smallest TTL of the records, failed lookups (NXDOMAIN or no address records) for
+     * the negative TTL of the SOA record in the response (RFC 2308), or 30 seconds without it. The name is queried as
+     * is without search domains and truncated responses are used as is, there is no TCP fallback.
+     */
+    class DnsResolver final {
+        struct CacheEntry {
+            std::vector<SocketAddress> addresses;
+            std::string error;// Set for negative entries
+            kstd::i32 error_code;// ENOENT for names without addresses, ETIMEDOUT without response, see resolve
+            std::chrono::steady_clock::time_point expiry;
+        };
+
+        struct Job {
+            std::string host;
+            kstd::u16 port;
+            ResolveCallback callback;
+        };
+
+        kstd::Option<SocketAddress> _name_server;// Empty with the system configuration
+        std::chrono::milliseconds _timeout;
+        kstd::u32 _attempts;
+
+        mutable std::mutex _cache_mutex;
+        std::unordered_map<std::string, CacheEntry> _cache;
+
+        std::mutex _job_mutex;
+        std::condition_variable _job_condition;
+        std::deque<Job> _jobs;
+        bool _stopping;
+        std::vector<std::thread> _worker_threads;
+
+        auto start_workers(kstd::usize worker_count) -> void;
+        [[nodiscard]] auto lookup(const std::string& host) const noexcept -> CacheEntry;
+        [[nodiscard]] auto lookup_system(const std::string& host) const noexcept -> CacheEntry;
+        [[nodiscard]] auto resolve_entry(std::string_view host, kstd::u16 port) noexcept -> CacheEntry;
+        [[nodiscard]] auto resolve_uncached(const std::string& host) noexcept -> CacheEntry;
+
+        public:
+        /**
+         * Resolves with the system configuration (getaddrinfo).
+         */
+        explicit DnsResolver(kstd::usize worker_count = 2);
+
+        /**
+         * Queries the specified name server only, a lookup fails after all attempts timed out.
+         */
+        explicit DnsResolver(const SocketAddress& name_server, kstd::usize worker_count = 2,
+                             std::chrono::milliseconds timeout = std::chrono::milliseconds {1000},
+                             kstd::u32 attempts = 2);
+        DnsResolver(const DnsResolver& other) = delete;
+        DnsResolver(DnsResolver&& other) = delete;
+        ~DnsResolver() noexcept;
+
+        /**
+         * Shared resolver with the system configuration, which is created on first use.
+         */
+        [[nodiscard]] static auto shared() -> DnsResolver&;
+
+        /**
+         * The specified name server, which is empty with the system configuration.
+         */
+        [[nodiscard]] inline auto name_server() const noexcept -> const kstd::Option<SocketAddress>& {
+            return _name_server;
+        }
+
+        /**
+         * Returns all IPv6 and IPv4 addresses (in this order) of the host with the specified port. Address literals
+         * are returned without lookup.
+         */
+        [[nodiscard]] auto resolve(std::string_view host, kstd::u16 port = 0) noexcept
+                -> kstd::Result<std::vector<SocketAddress>>;
+
+        /**
+         * Like resolve, but fails with a resolve error, whose code is ENOENT if the host has no addresses, ETIMEDOUT
+         * if the name servers didn't respond in time and EINVAL for invalid names.
+         */
+        [[nodiscard]] auto resolve_addresses(std::string_view host, kstd::u16 port = 0) noexcept
+                -> kstd::Result<std::vector<SocketAddress>, SocketError>;
+
+        /**
+         * Resolves the host on a worker thread and passes the result to the callback. Literals and cached
+         * results are passed directly on the calling thread.
+         */
+        auto resolve_async(std::string_view host, kstd::u16 port, ResolveCallback callback) -> void;
+
+        [[nodiscard]] auto cache_size() const noexcept -> kstd::usize;
+
+        auto clear_cache() noexcept -> void;
+
+        auto operator=(const DnsResolver& other) -> DnsResolver& = delete;
+        auto operator=(DnsResolver&& other) -> DnsResolver& = delete;
+    };
+}// namespace sockslib
+#endif
@@ -0,0 +1,129 @@
+#pragma once
+#ifdef PLATFORM_LINUX
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <sys/epoll.h>
+#include "sockslib/socket.hpp"
+#include "sockslib/timing_wheel.hpp"
+
+namespace sockslib {
+    enum class EventType : kstd::u32 {
+        NONE = 0,
+        READ = EPOLLIN,
+        WRITE = EPOLLOUT,
+        HANGUP = EPOLLHUP | EPOLLRDHUP,
+        ERROR = EPOLLERR
+    };
+
+    [[nodiscard]] constexpr auto operator|(const EventType left, const EventType right) noexcept -> EventType {
+        return static_cast<EventType>(static_cast<kstd::u32>(left) | static_cast<kstd::u32>(right));
+    }
+
+    [[nodiscard]] constexpr auto operator&(const EventType left, const EventType right) noexcept -> EventType {
+        return static_cast<EventType>(static_cast<kstd::u32>(left) & static_cast<kstd::u32>(right));
+    }
+
+    [[nodiscard]] constexpr auto has_event(const EventType events, const EventType event) noexcept -> bool {
+        return (events & event) != EventType::NONE;
+    }
+
+    using EventCallback = std::function<void(EventType events)>;
+    using AcceptCallback = std::function<void(AcceptedSocket socket)>;
+    using AcceptErrorCallback = std::function<void(SocketError error)>;
+    using IdleCallback = std::function<void(SocketHandle socket_handle)>;
+
+    /**
+     * Edge-triggered epoll reactor. A callback is only invoked again once new data or buffer space arrives, so it has
+     * to drain the socket with try_read/try_write until these report that the operation would block. Callbacks run
+     * on the thread calling poll/run and may add, modify or remove registrations (including their own).
+     */
+    class EventLoop final {
+        struct Registration {
+            SocketHandle socket_handle;
+            EventCallback callback;
+            bool active;
+            bool idle_tracked;// Server sockets are never idle
+            TimerId idle_timer;
+        };
+
+        int _epoll_handle;
+        int _wakeup_handle;
+        bool _running;
+        std::vector<epoll_event> _events;
+        std::unordered_map<SocketHandle, std::unique_ptr<Registration>> _registrations;
+        std::vector<std::unique_ptr<Registration>> _retired_registrations;
+        std::chrono::milliseconds _idle_timeout;
+        IdleCallback _idle_callback;
+        TimingWheel<SocketHandle> _idle_timers;
+
+        auto touch(Registration& registration, std::chrono::steady_clock::time_point now) -> void;
+
+        public:
+        explicit EventLoop(kstd::usize max_events_per_poll = 256);
+        EventLoop(const EventLoop& other) = delete;
+        EventLoop(EventLoop&& other) noexcept;
+        ~EventLoop() noexcept;
+
+        /**
+         * Registers interest in the specified events on the socket handle. The socket is switched into non-blocking
+         * mode and has to stay open until it's removed from the loop.
+         */
+        [[nodiscard]] auto add(SocketHandle socket_handle, EventType interest, EventCallback callback) noexcept
+                -> kstd::Result<void>;
+
+        /**
+         * Registers accept interest on the server socket. Every pending connection is accepted and handed over to the
+         * callback as non-blocking socket. Accepting stops at errors other than connection resets (e.g. EMFILE), which
+         * are passed to the error callback. The remaining connections are accepted with the next incoming connection,
+         * or earlier by re-arming the event with modify(server_socket.socket_handle(), EventType::READ).
+         */
+        [[nodiscard]] auto add(const ServerSocket& server_socket, AcceptCallback callback,
+                               AcceptErrorCallback error_callback = {}) noexcept -> kstd::Result<void>;
+
+        /**
+         * Reports sockets, which received no events for the timeout, to the callback. It usually removes and closes
+         * them. The sockets are tracked by a timing wheel with ticks of 10 milliseconds, so idle connections cost no
+         * syscalls and the timeouts may expire up to one tick late. Only sockets added afterwards are tracked, server
+         * sockets are never reported.
+         */
+        auto set_idle_timeout(std::chrono::milliseconds timeout, IdleCallback callback) -> void;
+
+        [[nodiscard]] auto modify(SocketHandle socket_handle, EventType interest) noexcept -> kstd::Result<void>;
+        [[nodiscard]] auto remove(SocketHandle socket_handle) noexcept -> kstd::Result<void>;
+
+        /**
+         * Waits for events (timeout of -1 waits forever) and dispatches them. Returns the count of dispatched events.
+         */
+        [[nodiscard]] auto poll(int timeout_ms = -1) noexcept -> kstd::Result<kstd::usize>;
+
+        /**
+         * Polls and dispatches events until stop gets called.
+         */
+        [[nodiscard]] auto run() noexcept -> kstd::Result<void>;
+
+        /**
+         * Wakes the loop up and lets run return. This is the only function which is safe to call from other threads.
+         */
+        auto stop() const noexcept -> void;
+
+        [[nodiscard]] inline auto registration_count() const noexcept -> kstd::usize {
+            return _registrations.size();
+        }
+
+        /**
+         * Count of sockets, whose idle timeout is running.
+         */
+        [[nodiscard]] inline auto idle_timer_count() const noexcept -> kstd::usize {
+            return _idle_timers.size();
+        }
+
+        auto operator=(const EventLoop& other) -> EventLoop& = delete;
+        auto operator=(EventLoop&& other) noexcept -> EventLoop&;
+    };
+}// namespace sockslib
+#endif
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <kstd/option.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "sockslib/socket_error.hpp"
+
+#ifdef KSTD_CPP_20
+#include <span>
+#endif
+
+namespace sockslib {
+    enum class LengthPrefix : kstd::u8 {
+        VARINT,  // Unsigned LEB128 like protobuf, one byte for frames up to 127 bytes
+        FIXED_32 // Big-endian 32-bit integer
+    };
+
+    constexpr kstd::usize max_length_prefix_size = 10;
+
+    /**
+     * Writes the length prefix of a frame with size bytes of payload into data, which has to provide room for
+     * max_length_prefix_size bytes, and returns the size of the prefix. Fails if the size doesn't fit into a
+     * FIXED_32 prefix.
+     */
+    [[nodiscard]] inline auto encode_length_prefix(const LengthPrefix prefix, kstd::u64 size, kstd::u8* data) noexcept
+            -> kstd::Result<kstd::usize> {
+        if(prefix == LengthPrefix::FIXED_32) {
+            if(size > 0xFFFFFFFFU) {
+                return kstd::Error {fmt::format("Unable to encode frame => Frame size of {} exceeds the 32-bit prefix",
+                                                size)};
+            }
+            for(kstd::usize i = 0; i < 4; ++i) {
+                data[i] = static_cast<kstd::u8>(size >> (24U - i * 8U));
+            }
+            return 4;
+        }
+
+        kstd::usize prefix_size = 0;
+        while(size >= 0x80U) {
+            data[prefix_size++] = static_cast<kstd::u8>(size | 0x80U);
+            size >>= 7U;
+        }
+        data[prefix_size++] = static_cast<kstd::u8>(size);
+        return {prefix_size};
+    }
+
+    /**
+     * View on the payload of a decoded frame inside the receive buffer of the decoder, which stays valid until the
+     * decoder receives again.
+     */
+    struct Frame final {
+        const kstd::u8* data;
+        kstd::usize size;
+
+#ifdef KSTD_CPP_20
+        [[nodiscard]] inline auto as_span() const noexcept -> std::span<const kstd::u8> {
+            return {data, size};
+        }
+#endif
+    };
+
+    /**
+     * Splits the received byte stream into length-prefixed frames. One read fills the buffer with as many frames as
+     * fit, which are then returned by next as views into the buffer without copying. A frame split across reads is
+     * moved to the front of the buffer and, if it is larger than the buffer, the buffer grows once to the frame size
+     * announced by the prefix, so the rest of the frame is received directly behind its start.
+     */
+    class FrameDecoder final {
+        LengthPrefix _prefix;
+        kstd::usize _max_frame_size;
+        kstd::usize _min_read_size;
+        std::vector<kstd::u8> _buffer;
+        kstd::usize _head;// Start of the first frame, which was not returned yet
+        kstd::usize _tail;// End of the received bytes
+        kstd::usize _prefix_size;// Prefix and total size of the frame at the head, zero while unknown
+        kstd::usize _frame_size;
+
+        /**
+         * Decodes the prefix of the frame at the head, returns false if the prefix is incomplete.
+         */
+        [[nodiscard]] auto decode_prefix() noexcept -> kstd::Result<bool> {
+            const auto* data = _buffer.data() + _head;
+            const auto size = _tail - _head;
+            kstd::u64 payload_size = 0;
+            kstd::usize prefix_size = 0;
+            if(_prefix == LengthPrefix::FIXED_32) {
+                if(size < 4) {
+                    return false;
+                }
+                for(; prefix_size < 4; ++prefix_size) {
+                    payload_size = (payload_size << 8U) | data[prefix_size];
+                }
+            }
+            else {
+                while(true) {
+                    if(prefix_size == size) {
+                        return false;
+                    }
+                    if(prefix_size == max_length_prefix_size) {
+                        return kstd::Error {std::string {"Unable to decode frame => Length prefix is too long"}};
+                    }
+                    // The 10th byte only holds the highest bit of the 64-bit size, larger values would be cut off
+                    const auto value = data[prefix_size];
+                    if(prefix_size == max_length_prefix_size - 1 && value > 0x01U) {
+                        return kstd::Error {std::string {"Unable to decode frame => Length prefix is too long"}};
+                    }
+                    payload_size |= static_cast<kstd::u64>(value & 0x7FU) << (prefix_size * 7U);
+                    ++prefix_size;
+                    if((value & 0x80U) == 0) {
+                        break;
+                    }
+                }
+            }
+
+            if(payload_size > _max_frame_size) {
+                return kstd::Error {fmt::format("Unable to decode frame => Frame size of {} exceeds limit of {}",
+                                                payload_size, _max_frame_size)};
+            }
+            _prefix_size = prefix_size;
+            _frame_size = prefix_size + static_cast<kstd::usize>(payload_size);
+            return true;
+        }
+
+        public:
+        /**
+         * Creates a decoder, which rejects frames with more than max_frame_size bytes of payload. Reads are at least
+         * a quarter of the initial capacity large.
+         */
+        explicit FrameDecoder(LengthPrefix prefix = LengthPrefix::VARINT,
+                              kstd::usize max_frame_size = 16 * 1024 * 1024,
+                              kstd::usize initial_capacity = 64 * 1024) :
+                _prefix {prefix},
+                _max_frame_size {max_frame_size},
+                _min_read_size {std::max<kstd::usize>(initial_capacity / 4, 1)},
+                _buffer(std::max<kstd::usize>(initial_capacity, max_length_prefix_size)),
+                _head {0},
+                _tail {0},
+                _prefix_size {0},
+                _frame_size {0} {
+        }
+
+        [[nodiscard]] inline auto prefix() const noexcept -> LengthPrefix {
+            return _prefix;
+        }
+
+        /**
+         * Count of received bytes, which belong to frames not returned by next yet.
+         */
+        [[nodiscard]] inline auto buffered_size() const noexcept -> kstd::usize {
+            return _tail - _head;
+        }
+
+        [[nodiscard]] inline auto capacity() const noexcept -> kstd::usize {
+            return _buffer.size();
+        }
+
+        /**
+         * Makes room for the next read and returns the count of bytes, which may be received into writable_data.
+         * This invalidates the frames returned so far.
+         */
+        auto prepare() -> kstd::usize {
+            if(_head == _tail) {
+                _head = _tail = 0;
+            }
+
+            const auto pending_size = _tail - _head;
+            const auto required_size = std::max(_frame_size, pending_size + _min_read_size);
+            if(_buffer.size() - _head < required_size) {
+                if(_head > 0) {
+                    std::memmove(_buffer.data(), _buffer.data() + _head, pending_size);
+                    _head = 0;
+                    _tail = pending_size;
+                }
+                if(_buffer.size() < required_size) {
+                    _buffer.resize(required_size);
+                }
+            }
+            return _buffer.size() - _tail;
+        }
+
+        [[nodiscard]] inline auto writable_data() noexcept -> kstd::u8* {
+            return _buffer.data() + _tail;
+        }
+
+        /**
+         * Marks size bytes received into writable_data as part of the stream.
+         */
+        inline auto commit(const kstd::usize size) noexcept -> void {
+            _tail += size;
+        }
+
+        /**
+         * Receives once from the socket and returns the count of received bytes, zero signals that the peer closed
+         * the connection.
+         */
+        template<typename S>
+        [[nodiscard]] auto read_from(const S& socket) -> kstd::Result<kstd::usize, SocketError> {
+            const auto writable_size = prepare();
+            auto result = socket.read(writable_data(), writable_size);
+            if(result) {
+                commit(result.get());
+            }
+            return result;
+        }
+
+        /**
+         * Non-blocking variant of read_from, an empty option signals that the read would block.
+         */
+        template<typename S>
+        [[nodiscard]] auto try_read_from(const S& socket) -> kstd::Result<kstd::Option<kstd::usize>, SocketError> {
+            const auto writable_size = prepare();
+            auto result = socket.try_read(writable_data(), writable_size);
+            if(result && !result.get().is_empty()) {
+                commit(result.get().get());
+            }
+            return result;
+        }
+
+        /**
+         * Returns the next complete frame or an empty option if more bytes have to be received first. A malformed or
+         * oversized length prefix is an error, after which the stream can't be decoded any further.
+         */
+        [[nodiscard]] auto next() noexcept -> kstd::Result<kstd::Option<Frame>> {
+            if(_frame_size == 0) {
+                auto result = decode_prefix();
+                if(result.is_error()) {
+                    return kstd::Error {result.get_error()};
+                }
+                if(!result.get()) {
+                    return {kstd::Option<Frame> {}};
+                }
+            }
+            if(_tail - _head < _frame_size) {
+                return {kstd::Option<Frame> {}};
+            }
+
+            const Frame frame {_buffer.data() + _head + _prefix_size, _frame_size - _prefix_size};
+            _head += _frame_size;
+            _prefix_size = _frame_size = 0;
+            return {kstd::Option<Frame> {frame}};
+        }
+    };
+
+    /**
+     * Collects length-prefixed frames in one buffer, so a batch of frames is sent with one write instead of one per
+     * prefix and one per payload.
+     */
+    class FrameEncoder final {
+        LengthPrefix _prefix;
+        std::vector<kstd::u8> _buffer;
+
+        public:
+        explicit FrameEncoder(LengthPrefix prefix = LengthPrefix::VARINT) :
+                _prefix {prefix} {
+        }
+
+        [[nodiscard]] inline auto prefix() const noexcept -> LengthPrefix {
+            return _prefix;
+        }
+
+        [[nodiscard]] inline auto data() const noexcept -> const kstd::u8* {
+            return _buffer.data();
+        }
+
+        [[nodiscard]] inline auto size() const noexcept -> kstd::usize {
+            return _buffer.size();
+        }
+
+        inline auto clear() noexcept -> void {
+            _buffer.clear();
+        }
+
+        /**
+         * Appends the prefix and the payload of a frame, fails without changes if the prefix can't hold the size.
+         */
+        [[nodiscard]] auto encode(const void* data, const kstd::usize size) -> kstd::Result<void> {
+            std::array<kstd::u8, max_length_prefix_size> prefix {};
+            const auto prefix_size = encode_length_prefix(_prefix, size, prefix.data());
+            if(!prefix_size) {
+                return kstd::Error {prefix_size.get_error()};
+            }
+
+            const auto offset = _buffer.size();
+            _buffer.resize(offset + prefix_size.get() + size);
+            std::memcpy(_buffer.data() + offset, prefix.data(), prefix_size.get());
+            if(size > 0) {
+                std::memcpy(_buffer.data() + offset + prefix_size.get(), data, size);
+            }
+            return {};
+        }
+
+        /**
+         * Writes all encoded frames to the socket and clears the buffer afterwards. If the write fails, the bytes
+         * which were not written stay in the buffer.
+         */
+        template<typename S>
+        [[nodiscard]] auto write_to(const S& socket) -> kstd::Result<void, SocketError> {
+            kstd::usize bytes_sent = 0;
+            while(bytes_sent < _buffer.size()) {
+                auto result = socket.write(_buffer.data() + bytes_sent, _buffer.size() - bytes_sent);
+                if(result.is_error()) {
+                    _buffer.erase(_buffer.begin(), _buffer.begin() + static_cast<kstd::isize>(bytes_sent));
+                    return kstd::Error {result.get_error()};
+                }
+                bytes_sent += result.get();
+            }
+            _buffer.clear();
+            return {};
+        }
+    };
+}// namespace sockslib
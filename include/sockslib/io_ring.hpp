@@ -0,0 +1,135 @@
+#pragma once
+#ifdef PLATFORM_LINUX
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <vector>
+#include "sockslib/socket.hpp"
+
+namespace sockslib {
+    struct IoCompletion {
+        kstd::u64 user_data;
+        kstd::i32 result;// Transferred bytes or accepted socket handle, negated errno on failure
+    };
+
+    /**
+     * Batched submission of accept, receive and send operations. Prepared operations are handed over to the kernel
+     * with a single io_uring_enter call, receives can land in buffers registered with the ring (fixed buffers).
+     *
+     * The io_uring backend has to be enabled with the SOCKSLIB_IO_URING CMake option and is probed on construction.
+     * Without it (or if the kernel lacks support) the operations are executed one by one with plain syscalls in
+     * submission order when calling submit, so the completions look the same for both backends.
+     *
+     * The read and write functions of the sockets don't go through the ring. They complete one operation per call,
+     * which would still take one io_uring_enter each, so only callers batching operations across sockets gain
+     * anything and use the ring directly with the socket handles.
+     */
+    class IoRing final {
+        enum class Operation : kstd::u8 {
+            ACCEPT,
+            RECEIVE,
+            SEND
+        };
+
+        struct PendingOperation {
+            Operation operation;
+            SocketHandle socket_handle;
+            void* data;
+            kstd::usize size;
+            kstd::u64 user_data;
+        };
+
+        int _ring_handle;
+        bool _buffers_registered;
+        kstd::u32 _queue_depth;
+        kstd::u32 _buffer_count;
+        kstd::usize _buffer_size;
+        kstd::u8* _buffers;
+
+        // Shared rings with the kernel, only mapped if io_uring is used
+        void* _submission_ring;
+        kstd::usize _submission_ring_size;
+        void* _completion_ring;
+        kstd::usize _completion_ring_size;
+        void* _submission_entries;
+        kstd::usize _submission_entries_size;
+        kstd::u32* _submission_head;
+        kstd::u32* _submission_tail;
+        kstd::u32* _submission_mask;
+        kstd::u32* _submission_array;
+        kstd::u32* _completion_head;
+        kstd::u32* _completion_tail;
+        kstd::u32* _completion_mask;
+        void* _completion_entries;
+        kstd::u32 _local_submission_tail;
+
+        // Queues of the syscall fallback
+        std::vector<PendingOperation> _pending_operations;
+        std::vector<IoCompletion> _fallback_completions;
+
+        auto setup_io_uring() noexcept -> bool;
+        auto release_ring() noexcept -> void;
+        auto release() noexcept -> void;
+        [[nodiscard]] auto prepare(Operation operation, SocketHandle socket_handle, void* data, kstd::usize size,
+                                   kstd::i32 buffer_index, kstd::u64 user_data) noexcept -> kstd::Result<void>;
+
+        public:
+        /**
+         * Creates a ring for up to queue_depth operations in flight per submit and allocates buffer_count buffers of
+         * buffer_size bytes, which are registered with the kernel if io_uring is used.
+         */
+        IoRing(kstd::u32 queue_depth, kstd::u32 buffer_count, kstd::usize buffer_size, bool prefer_io_uring = true);
+        IoRing(const IoRing& other) = delete;
+        IoRing(IoRing&& other) noexcept;
+        ~IoRing() noexcept;
+
+        [[nodiscard]] inline auto uses_io_uring() const noexcept -> bool {
+            return _ring_handle >= 0;
+        }
+
+        [[nodiscard]] inline auto buffer(const kstd::u32 index) const noexcept -> kstd::u8* {
+            return _buffers + static_cast<kstd::usize>(index) * _buffer_size;
+        }
+
+        [[nodiscard]] inline auto buffer_count() const noexcept -> kstd::u32 {
+            return _buffer_count;
+        }
+
+        [[nodiscard]] inline auto buffer_size() const noexcept -> kstd::usize {
+            return _buffer_size;
+        }
+
+        /**
+         * Accepts a connection of the server socket, the completion result is the handle of the accepted socket.
+         */
+        [[nodiscard]] auto prepare_accept(const ServerSocket& server_socket, kstd::u64 user_data) noexcept
+                -> kstd::Result<void>;
+
+        [[nodiscard]] auto prepare_receive(SocketHandle socket_handle, kstd::u8* data, kstd::usize size,
+                                           kstd::u64 user_data) noexcept -> kstd::Result<void>;
+        [[nodiscard]] auto prepare_send(SocketHandle socket_handle, const void* data, kstd::usize size,
+                                        kstd::u64 user_data) noexcept -> kstd::Result<void>;
+
+        /**
+         * Receives into or sends from the buffer with the specified index of this ring.
+         */
+        [[nodiscard]] auto prepare_receive_fixed(SocketHandle socket_handle, kstd::u32 buffer_index,
+                                                 kstd::u64 user_data) noexcept -> kstd::Result<void>;
+        [[nodiscard]] auto prepare_send_fixed(SocketHandle socket_handle, kstd::u32 buffer_index, kstd::usize size,
+                                              kstd::u64 user_data) noexcept -> kstd::Result<void>;
+
+        /**
+         * Submits all prepared operations with one syscall and waits until at least wait_count operations completed.
+         * Returns the count of submitted operations.
+         */
+        [[nodiscard]] auto submit(kstd::u32 wait_count = 0) noexcept -> kstd::Result<kstd::u32>;
+
+        /**
+         * Moves up to max_completions completions into the specified array and returns their count.
+         */
+        [[nodiscard]] auto reap(IoCompletion* completions, kstd::usize max_completions) noexcept -> kstd::usize;
+
+        auto operator=(const IoRing& other) -> IoRing& = delete;
+        auto operator=(IoRing&& other) noexcept -> IoRing&;
+    };
+}// namespace sockslib
+#endif
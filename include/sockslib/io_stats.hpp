@@ -0,0 +1,327 @@
+#pragma once
+#include <kstd/types.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "sockslib/tracing.hpp"
+#include "sockslib/utils.hpp"
+
+#ifndef PLATFORM_WINDOWS
+#include <errno.h>
+#endif
+
+namespace sockslib {
+    enum class IoOperation : kstd::u8 {
+        READ,
+        WRITE,
+        ACCEPT
+    };
+
+    constexpr kstd::usize io_operation_count = 3;
+    constexpr kstd::usize io_error_slot_count = 128;
+    constexpr kstd::usize io_latency_bucket_count = 32;
+
+    /**
+     * Counters of one kind of socket call. Calls which failed because they would block (or their timeout expired) only
+     * count as would_block_count, accepted connections count as calls without bytes.
+     */
+    struct IoCounters final {
+        kstd::u64 calls = 0;
+        kstd::u64 bytes = 0;
+        kstd::u64 short_count = 0;// Calls which transferred less bytes than requested, including end of stream
+        kstd::u64 would_block_count = 0;
+        kstd::u64 error_count = 0;
+        std::array<kstd::u64, io_latency_bucket_count> latency_histogram {};// Bucket i: [2^i, 2^(i+1)) ns
+
+        [[nodiscard]] inline auto average_bytes() const noexcept -> double {
+            const auto transfer_count = calls - would_block_count - error_count;
+            return transfer_count == 0 ? 0.0 : static_cast<double>(bytes) / static_cast<double>(transfer_count);
+        }
+    };
+
+    /**
+     * Slot of the platform error code (errno or WSA error) in IoStatistics::error_counts. Slot 0 collects the codes
+     * which are out of range.
+     */
+    [[nodiscard]] constexpr auto io_error_slot(kstd::i32 error_code) noexcept -> kstd::usize {
+#ifdef PLATFORM_WINDOWS
+        error_code -= WSABASEERR;
+#endif
+        return error_code > 0 && static_cast<kstd::usize>(error_code) < io_error_slot_count
+                       ? static_cast<kstd::usize>(error_code)
+                       : 0;
+    }
+
+    /**
+     * Snapshot of the I/O counters of a socket or all threads. Snapshots of different times can be subtracted to
+     * get the counters of the interval, like the accept rate.
+     */
+    struct IoStatistics final {
+        std::array<IoCounters, io_operation_count> counters {};
+        std::array<kstd::u64, io_error_slot_count> error_counts {};
+
+        [[nodiscard]] inline auto operator[](const IoOperation operation) const noexcept -> const IoCounters& {
+            return counters[static_cast<kstd::usize>(operation)];
+        }
+
+        [[nodiscard]] inline auto error_count(const kstd::i32 error_code) const noexcept -> kstd::u64 {
+            return error_counts[io_error_slot(error_code)];
+        }
+
+        inline auto operator+=(const IoStatistics& other) noexcept -> IoStatistics& {
+            for(kstd::usize i = 0; i < io_operation_count; ++i) {
+                auto& counter = counters[i];
+                const auto& other_counter = other.counters[i];
+                counter.calls += other_counter.calls;
+                counter.bytes += other_counter.bytes;
+                counter.short_count += other_counter.short_count;
+                counter.would_block_count += other_counter.would_block_count;
+                counter.error_count += other_counter.error_count;
+                for(kstd::usize j = 0; j < io_latency_bucket_count; ++j) {
+                    counter.latency_histogram[j] += other_counter.latency_histogram[j];
+                }
+            }
+            for(kstd::usize i = 0; i < io_error_slot_count; ++i) {
+                error_counts[i] += other.error_counts[i];
+            }
+            return *this;
+        }
+
+        [[nodiscard]] inline auto operator-(const IoStatistics& other) const noexcept -> IoStatistics {
+            auto result = *this;
+            for(kstd::usize i = 0; i < io_operation_count; ++i) {
+                auto& counter = result.counters[i];
+                const auto& other_counter = other.counters[i];
+                counter.calls -= other_counter.calls;
+                counter.bytes -= other_counter.bytes;
+                counter.short_count -= other_counter.short_count;
+                counter.would_block_count -= other_counter.would_block_count;
+                counter.error_count -= other_counter.error_count;
+                for(kstd::usize j = 0; j < io_latency_bucket_count; ++j) {
+                    counter.latency_histogram[j] -= other_counter.latency_histogram[j];
+                }
+            }
+            for(kstd::usize i = 0; i < io_error_slot_count; ++i) {
+                result.error_counts[i] -= other.error_counts[i];
+            }
+            return result;
+        }
+    };
+
+    namespace detail {
+        inline std::atomic_bool io_latency_enabled {false};
+
+        // Single writers (the counters of a thread) skip the atomic read-modify-write, the readers only need
+        // untorn values
+        template<bool SHARED>
+        class alignas(64) AtomicIoStatistics {
+            struct Counters final {
+                std::atomic<kstd::u64> calls;
+                std::atomic<kstd::u64> bytes;
+                std::atomic<kstd::u64> short_count;
+                std::atomic<kstd::u64> would_block_count;
+                std::atomic<kstd::u64> error_count;
+                std::array<std::atomic<kstd::u64>, io_latency_bucket_count> latency_histogram;
+            };
+
+            std::array<Counters, io_operation_count> _counters {};
+            std::array<std::atomic<kstd::u64>, io_error_slot_count> _error_counts {};
+
+            static inline auto add(std::atomic<kstd::u64>& counter, const kstd::u64 value) noexcept -> void {
+                if constexpr(SHARED) {
+                    counter.fetch_add(value, std::memory_order_relaxed);
+                }
+                else {
+                    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+                }
+            }
+
+            public:
+            auto record(const IoOperation operation, const bool failed, const kstd::usize transferred,
+                        const kstd::usize requested, const kstd::i32 error_code,
+                        const std::chrono::nanoseconds latency) noexcept -> void {
+                auto& counters = _counters[static_cast<kstd::usize>(operation)];
+                add(counters.calls, 1);
+                if(failed) {
+#ifdef PLATFORM_WINDOWS
+                    const auto would_block = error_code == WSAEWOULDBLOCK || error_code == WSAETIMEDOUT;
+#else
+                    const auto would_block = error_code == EAGAIN || error_code == EWOULDBLOCK;
+#endif
+                    add(would_block ? counters.would_block_count : counters.error_count, 1);
+                    if(!would_block) {
+                        add(_error_counts[io_error_slot(error_code)], 1);
+                    }
+                }
+                else {
+                    add(counters.bytes, transferred);
+                    if(transferred < requested) {
+                        add(counters.short_count, 1);
+                    }
+                }
+
+                if(latency.count() > 0) {
+                    kstd::usize bucket = 0;
+                    for(auto value = static_cast<kstd::u64>(latency.count()); value > 1; value >>= 1) {
+                        ++bucket;
+                    }
+                    add(counters.latency_histogram[std::min(bucket, io_latency_bucket_count - 1)], 1);
+                }
+            }
+
+            [[nodiscard]] auto snapshot() const noexcept -> IoStatistics {
+                IoStatistics statistics {};
+                for(kstd::usize i = 0; i < io_operation_count; ++i) {
+                    const auto& counters = _counters[i];
+                    auto& result = statistics.counters[i];
+                    result.calls = counters.calls.load(std::memory_order_relaxed);
+                    result.bytes = counters.bytes.load(std::memory_order_relaxed);
+                    result.short_count = counters.short_count.load(std::memory_order_relaxed);
+                    result.would_block_count = counters.would_block_count.load(std::memory_order_relaxed);
+                    result.error_count = counters.error_count.load(std::memory_order_relaxed);
+                    for(kstd::usize j = 0; j < io_latency_bucket_count; ++j) {
+                        result.latency_histogram[j] = counters.latency_histogram[j].load(std::memory_order_relaxed);
+                    }
+                }
+                for(kstd::usize i = 0; i < io_error_slot_count; ++i) {
+                    statistics.error_counts[i] = _error_counts[i].load(std::memory_order_relaxed);
+                }
+                return statistics;
+            }
+        };
+
+        using ThreadIoStatistics = AtomicIoStatistics<false>;
+
+        // Knows the counters of all running threads, the counters of finished threads are folded into _retired
+        class IoStatisticsRegistry final {
+            std::mutex _mutex;
+            std::vector<const ThreadIoStatistics*> _threads;
+            IoStatistics _retired;
+
+            public:
+            [[nodiscard]] static auto instance() -> IoStatisticsRegistry& {
+                static IoStatisticsRegistry registry {};
+                return registry;
+            }
+
+            auto add(const ThreadIoStatistics* statistics) -> void {
+                const std::lock_guard<std::mutex> lock {_mutex};
+                _threads.push_back(statistics);
+            }
+
+            auto remove(const ThreadIoStatistics* statistics) -> void {
+                const std::lock_guard<std::mutex> lock {_mutex};
+                _retired += statistics->snapshot();
+                _threads.erase(std::remove(_threads.begin(), _threads.end(), statistics), _threads.end());
+            }
+
+            [[nodiscard]] auto aggregate() -> IoStatistics {
+                const std::lock_guard<std::mutex> lock {_mutex};
+                auto statistics = _retired;
+                for(const auto* thread_statistics : _threads) {
+                    statistics += thread_statistics->snapshot();
+                }
+                return statistics;
+            }
+        };
+
+        struct ThreadIoStatisticsSlot final {
+            ThreadIoStatistics statistics {};
+
+            ThreadIoStatisticsSlot() {
+                IoStatisticsRegistry::instance().add(&statistics);
+            }
+
+            ~ThreadIoStatisticsSlot() noexcept {
+                IoStatisticsRegistry::instance().remove(&statistics);
+            }
+        };
+
+        [[nodiscard]] inline auto thread_io_statistics() -> ThreadIoStatistics& {
+            thread_local ThreadIoStatisticsSlot slot {};
+            return slot.statistics;
+        }
+    }// namespace detail
+
+    /**
+     * Counters of one socket, which are shared between the threads using the socket. They are attached with
+     * Socket::set_statistics and have to outlive the socket.
+     */
+    using SocketStatistics = detail::AtomicIoStatistics<true>;
+
+    /**
+     * Enables the histogram of the syscall latencies, which costs two clock reads per call.
+     */
+    inline auto set_io_latency_histogram(const bool enabled) noexcept -> void {
+        detail::io_latency_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * Sums the counters of all threads up, including the ones which already finished. Without SOCKSLIB_IO_STATS,
+     * nothing is counted and all counters are zero.
+     */
+    [[nodiscard]] inline auto global_io_statistics() -> IoStatistics {
+        return detail::IoStatisticsRegistry::instance().aggregate();
+    }
+
+    /**
+     * Runs the socket call and counts it for the thread and the socket statistics (if attached). The call returns
+     * the result of the syscall, failed is checked on it and the transferred byte count is taken from it. The call is
+     * traced as well, see trace_call. Without SOCKSLIB_IO_STATS, this only runs the call.
+     */
+    template<typename F, typename P>
+    inline auto measure_io(const SocketHandle socket_handle, SocketStatistics* statistics, const IoOperation operation,
+                           const kstd::usize requested, F&& call, P&& failed) noexcept -> decltype(call()) {
+        const auto event = operation == IoOperation::READ    ? TraceEvent::RECV
+                           : operation == IoOperation::WRITE ? TraceEvent::SEND
+                                                             : TraceEvent::ACCEPT;
+#ifdef SOCKSLIB_IO_STATS
+        const auto measure_latency = detail::io_latency_enabled.load(std::memory_order_relaxed);
+        const auto start = measure_latency ? std::chrono::steady_clock::now() : Deadline {};
+        const auto result = trace_call(event, socket_handle, call);
+        const auto latency = measure_latency ? std::chrono::steady_clock::now() - start : Deadline::duration::zero();
+
+        const auto call_failed = failed(result);
+        const auto error_code = call_failed ? get_last_error_code() : 0;
+        const auto transferred =
+                operation == IoOperation::ACCEPT || call_failed ? 0 : static_cast<kstd::usize>(result);
+        const auto latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(latency);
+        detail::thread_io_statistics().record(operation, call_failed, transferred, requested, error_code, latency_ns);
+        if(statistics != nullptr) {
+            statistics->record(operation, call_failed, transferred, requested, error_code, latency_ns);
+        }
+
+        // The error code is read by the caller, counting may have overwritten it
+        if(call_failed) {
+#ifdef PLATFORM_WINDOWS
+            WSASetLastError(error_code);
+#else
+            errno = error_code;
+#endif
+        }
+        return result;
+#else
+        static_cast<void>(statistics);
+        static_cast<void>(operation);
+        static_cast<void>(requested);
+        static_cast<void>(failed);
+        return trace_call(event, socket_handle, std::forward<F>(call));
+#endif
+    }
+
+    /**
+     * Variant of measure_io for read and write calls, which fail with a negative result.
+     */
+    template<typename F>
+    inline auto measure_io(const SocketHandle socket_handle, SocketStatistics* statistics, const IoOperation operation,
+                           const kstd::usize requested, F&& call) noexcept -> decltype(call()) {
+        const auto failed = [](const auto result) {
+            return result < 0;
+        };
+        return measure_io(socket_handle, statistics, operation, requested, std::forward<F>(call), failed);
+    }
+}// namespace sockslib
@@ -0,0 +1,106 @@
+#pragma once
+#include <kstd/language.hpp>
+#if defined(PLATFORM_LINUX) && defined(KSTD_CPP_20)
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <atomic>
+#include <coroutine>
+#include <unordered_map>
+#include <unordered_set>
+#include "sockslib/event_loop.hpp"
+#include "sockslib/socket_error.hpp"
+#include "sockslib/task.hpp"
+
+namespace sockslib {
+    /**
+     * Readiness reactor, which drives the async_* functions of the sockets. A coroutine, whose operation would block,
+     * waits on the event loop until the socket gets ready and is resumed by poll/run on the thread of the reactor.
+     * Sockets are only registered while a coroutine waits on them, so they may be closed at any other time.
+     */
+    class Reactor final {
+        struct Waiters final {
+            std::coroutine_handle<> reader;
+            std::coroutine_handle<> writer;
+        };
+
+        EventLoop _event_loop;
+        std::unordered_map<SocketHandle, Waiters> _waiters;
+        std::unordered_set<void*> _tasks;// Frame addresses of the spawned tasks, which did not complete yet
+        std::atomic_bool _stop_requested;
+
+        [[nodiscard]] auto update_registration(SocketHandle socket_handle) noexcept -> kstd::Result<void>;
+        auto dispatch(SocketHandle socket_handle, EventType events) noexcept -> void;
+
+        public:
+        /**
+         * Suspends the awaiting coroutine until the socket is ready for the operation. Waiting fails with the error of
+         * the event loop registration, only one reader and one writer may wait on a socket at the same time.
+         */
+        class WaitAwaiter final {
+            Reactor* _reactor;
+            SocketHandle _socket_handle;
+            SocketOperation _operation;
+            SocketError _error;
+
+            public:
+            WaitAwaiter(Reactor& reactor, SocketHandle socket_handle, SocketOperation operation) noexcept;
+
+            [[nodiscard]] constexpr auto await_ready() const noexcept -> bool {
+                return false;
+            }
+
+            [[nodiscard]] auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool;
+            [[nodiscard]] auto await_resume() const noexcept -> kstd::Result<void, SocketError>;
+        };
+
+        explicit Reactor(kstd::usize max_events_per_poll = 256);
+        Reactor(const Reactor& other) = delete;
+        Reactor(Reactor&& other) noexcept = delete;
+        /**
+         * Destroys the spawned tasks, which did not complete yet, together with the tasks they await.
+         */
+        ~Reactor() noexcept;
+
+        /**
+         * Starts the task right away, it runs until its first suspension and is owned by the reactor afterwards.
+         * Exceptions leaving a spawned task terminate the program.
+         */
+        auto spawn(Task<void> task) -> void;
+
+        [[nodiscard]] auto wait(SocketHandle socket_handle, SocketOperation operation) noexcept -> WaitAwaiter;
+
+        /**
+         * Waits for events (timeout of -1 waits forever) and resumes the waiting coroutines. Returns the count of
+         * dispatched events.
+         */
+        [[nodiscard]] auto poll(int timeout_ms = -1) noexcept -> kstd::Result<kstd::usize>;
+
+        /**
+         * Resumes waiting coroutines until all spawned tasks completed or stop gets called.
+         */
+        [[nodiscard]] auto run() noexcept -> kstd::Result<void>;
+
+        /**
+         * Lets run return, this is the only function which is safe to call from other threads.
+         */
+        auto stop() noexcept -> void;
+
+        /**
+         * Count of spawned tasks, which did not complete yet.
+         */
+        [[nodiscard]] inline auto task_count() const noexcept -> kstd::usize {
+            return _tasks.size();
+        }
+
+        /**
+         * Count of sockets with waiting coroutines.
+         */
+        [[nodiscard]] inline auto waiting_count() const noexcept -> kstd::usize {
+            return _waiters.size();
+        }
+
+        auto operator=(const Reactor& other) -> Reactor& = delete;
+        auto operator=(Reactor&& other) noexcept -> Reactor& = delete;
+    };
+}// namespace sockslib
+#endif
@@ -27,7 +27,7 @@ namespace sockslib {
 
     [[nodiscard]] auto address_type_enabled(AddressType type) noexcept -> kstd::Result<bool>;
 
-    [[nodiscard]] inline auto recognize_address_type(std::string& address) noexcept -> kstd::Option<AddressType> {
+    [[nodiscard]] inline auto recognize_address_type(const std::string_view address) noexcept -> kstd::Option<AddressType> {
         if (is_ipv4_address(address)) {
             return {AddressType::IPV4};
         }
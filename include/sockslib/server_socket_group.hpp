@@ -0,0 +1,57 @@
+#pragma once
+#ifdef PLATFORM_LINUX
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "sockslib/socket.hpp"
+
+namespace sockslib {
+    using ConnectionHandler = std::function<void(kstd::usize worker_index, AcceptedSocket socket)>;
+    using AcceptErrorHandler = std::function<void(kstd::usize worker_index, SocketError error)>;
+
+    /**
+     * Group of TCP listeners sharing one port with SO_REUSEPORT. The kernel spreads incoming connections across the
+     * listeners, so every worker thread accepts from its own listener without a shared accept lock. Worker i is pinned
+     * to CPU i (modulo the CPU count).
+     *
+     * With CPU steering, a classic BPF program is attached to the group which selects the listener by the CPU that
+     * received the connection, keeping the connection on the CPU that already handled its packets.
+     */
+    class ServerSocketGroup final {
+        std::vector<ServerSocket> _server_sockets;
+        std::vector<std::thread> _worker_threads;
+
+        auto attach_cpu_steering() const -> void;
+
+        public:
+        ServerSocketGroup(kstd::u16 port, kstd::usize listener_count, bool steer_by_cpu = false);
+        ServerSocketGroup(const ServerSocketGroup& other) = delete;
+        ServerSocketGroup(ServerSocketGroup&& other) noexcept = default;
+        ~ServerSocketGroup() noexcept;
+
+        /**
+         * Starts one worker thread per listener, which blocks in accept and calls the handler for every connection.
+         * The handler runs on the worker thread, so it should hand long-living connections over to other threads.
+         * Accept errors other than connection resets (e.g. EMFILE) are passed to the error handler on the worker
+         * thread, which retries after 10 milliseconds.
+         */
+        [[nodiscard]] auto start(ConnectionHandler handler, AcceptErrorHandler error_handler = {}) noexcept
+                -> kstd::Result<void>;
+
+        /**
+         * Wakes the worker threads up by shutting the listeners down and waits for them to finish. The group can't be
+         * started again afterwards.
+         */
+        auto stop() noexcept -> void;
+
+        [[nodiscard]] inline auto server_sockets() const noexcept -> const std::vector<ServerSocket>& {
+            return _server_sockets;
+        }
+
+        auto operator=(const ServerSocketGroup& other) -> ServerSocketGroup& = delete;
+        auto operator=(ServerSocketGroup&& other) noexcept -> ServerSocketGroup&;
+    };
+}// namespace sockslib
+#endif
@@ -2,11 +2,20 @@
 
 #include <kstd/types.hpp>
 #include <kstd/result.hpp>
+#include <kstd/option.hpp>
 #include <kstd/language.hpp>
 #include <kstd/defaults.hpp>
+#include <chrono>
 #include <string>
+#include <vector>
 #include "sockslib/utils.hpp"
+#include "sockslib/io_stats.hpp"
+#include "sockslib/tcp_info.hpp"
 #include "sockslib/resolve.hpp"
+#include "sockslib/socket_address.hpp"
+#include "sockslib/socket_error.hpp"
+#include "sockslib/socket_options.hpp"
+#include "sockslib/timestamping.hpp"
 
 #ifdef KSTD_CPP_20
 #include <span>
@@ -22,6 +31,16 @@
 namespace sockslib {
     constexpr SocketHandle invalid_socket_handle = -1;
 
+#ifdef PLATFORM_LINUX
+    class BufferPool;
+    class PooledBuffer;
+#ifdef KSTD_CPP_20
+    class Reactor;
+    template<typename T>
+    class Task;
+#endif
+#endif
+
     enum class ProtocolType : kstd::u8 {
         TCP = SOCK_STREAM,
         UDP = SOCK_DGRAM
@@ -30,11 +49,73 @@ namespace sockslib {
     class Socket {
         protected:
         SocketHandle _socket_handle;// NOLINT
+        SocketStatistics* _statistics = nullptr;// NOLINT
 
         public:
         Socket();
         KSTD_DEFAULT_MOVE_COPY(Socket, Socket);
         virtual ~Socket() = default;
+
+        /**
+         * Switches the socket between blocking and non-blocking mode. The try_* functions of the sockets are meant to
+         * be used with non-blocking sockets.
+         */
+        [[nodiscard]] auto set_blocking(bool blocking) const noexcept -> kstd::Result<void>;
+
+        /**
+         * Sets the default timeouts of the blocking read/accept and write functions (SO_RCVTIMEO and SO_SNDTIMEO), a
+         * timeout of zero waits forever. An expired timeout fails the function with a timed out error.
+         */
+        [[nodiscard]] auto set_timeouts(std::chrono::milliseconds read_timeout,
+                                        std::chrono::milliseconds write_timeout) const noexcept -> kstd::Result<void>;
+
+        /**
+         * Applies the options with a value in the order of their declaration and stops at the first one, which
+         * fails. The options can be changed at any time, but some of them only take effect before connect or listen,
+         * which is why the constructors accept them as well.
+         */
+        [[nodiscard]] auto set_options(const SocketOptions& options) const noexcept -> kstd::Result<void, SocketError>;
+
+        /**
+         * Reads the current options. Options, which the platform or the protocol of the socket doesn't support, are
+         * left empty.
+         */
+        [[nodiscard]] auto get_options() const noexcept -> kstd::Result<SocketOptions, SocketError>;
+
+        /**
+         * Attaches counters for the calls on this socket, which are counted in addition to the counters of the calling
+         * thread (see global_io_statistics). nullptr detaches them. Only counted with SOCKSLIB_IO_STATS.
+         */
+        inline auto set_statistics(SocketStatistics* statistics) noexcept -> void {
+            _statistics = statistics;
+        }
+
+        [[nodiscard]] inline auto statistics() const noexcept -> SocketStatistics* {
+            return _statistics;
+        }
+
+        /**
+         * Reads the kernel state of the TCP connection, like the RTT and the congestion window. Fails for UDP sockets.
+         */
+        [[nodiscard]] inline auto tcp_info() const noexcept -> kstd::Result<TcpInfo, SocketError> {
+            return get_tcp_info(_socket_handle);
+        }
+
+#ifdef PLATFORM_LINUX
+        /**
+         * Enables the kernel timestamps of received and sent packets (SO_TIMESTAMPING), options without any
+         * timestamp disable them again.
+         */
+        [[nodiscard]] auto set_timestamping(const TimestampingOptions& options) const noexcept
+                -> kstd::Result<void, SocketError>;
+
+        /**
+         * Reads the next transmit timestamp from the error queue without blocking, an empty option signals that none
+         * is queued. The kernel drops timestamps, which are not read, once the queue exceeds the receive buffer.
+         */
+        [[nodiscard]] auto try_read_transmit_timestamp() const noexcept
+                -> kstd::Result<kstd::Option<TransmitTimestamp>, SocketError>;
+#endif
     };
 
     class AcceptedSocket final : Socket {
@@ -44,29 +125,158 @@ namespace sockslib {
         AcceptedSocket(AcceptedSocket&& other) noexcept;
         ~AcceptedSocket() noexcept final;
 
-        [[nodiscard]] auto write(void* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize>;
-        [[nodiscard]] auto read(kstd::u8* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize>;
+        using Socket::set_blocking;
+        using Socket::set_timeouts;
+        using Socket::set_options;
+        using Socket::get_options;
+        using Socket::set_statistics;
+        using Socket::statistics;
+        using Socket::tcp_info;
+#ifdef PLATFORM_LINUX
+        using Socket::set_timestamping;
+        using Socket::try_read_transmit_timestamp;
+#endif
+
+        [[nodiscard]] inline auto socket_handle() const noexcept -> SocketHandle {
+            return _socket_handle;
+        }
+
+        [[nodiscard]] auto write(void* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize, SocketError>;
+        [[nodiscard]] auto read(kstd::u8* data, kstd::usize size) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+
+        /**
+         * Variants of write and read, which wait until the socket gets ready (poll) but not past the deadline. They
+         * fail with a timed out error once the deadline passed and work with blocking and non-blocking sockets.
+         */
+        [[nodiscard]] auto write(const void* data, kstd::usize size, Deadline deadline) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+        [[nodiscard]] auto read(kstd::u8* data, kstd::usize size, Deadline deadline) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+#ifdef KSTD_CPP_20
+        [[nodiscard]] auto read(std::span<kstd::u8> data) const noexcept -> kstd::Result<kstd::usize, SocketError>;
+
+        /**
+         * Scatter/gather variants of write and read, which transfer multiple buffers with one syscall. Like the
+         * single buffer variants, they may transfer less bytes than the buffers hold.
+         */
+        [[nodiscard]] auto write(std::span<const std::span<const kstd::u8>> buffers) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+        [[nodiscard]] auto read(std::span<const std::span<kstd::u8>> buffers) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+
+        /**
+         * Writes the buffers completely, continuing after partial writes where the last write stopped.
+         */
+        [[nodiscard]] auto write_all(std::span<const std::span<const kstd::u8>> buffers) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+#endif
+
+        /**
+         * Non-blocking variants of write and read. An empty option signals that the operation would block, a read of
+         * zero bytes signals that the peer closed the connection.
+         */
+        [[nodiscard]] auto try_write(const void* data, kstd::usize size) const noexcept
+                -> kstd::Result<kstd::Option<kstd::usize>, SocketError>;
+        [[nodiscard]] auto try_read(kstd::u8* data, kstd::usize size) const noexcept
+                -> kstd::Result<kstd::Option<kstd::usize>, SocketError>;
+
+#ifdef PLATFORM_LINUX
+        /**
+         * Variants of read and try_read, which borrow a buffer from the pool for the received bytes instead of
+         * keeping one per connection. The buffer returns to the pool when the last copy of it is dropped, and right
+         * away if nothing was read. Fails with ENOBUFS if the pool is exhausted.
+         */
+        [[nodiscard]] auto read(BufferPool& pool) const noexcept -> kstd::Result<PooledBuffer, SocketError>;
+        [[nodiscard]] auto try_read(BufferPool& pool) const noexcept
+                -> kstd::Result<kstd::Option<PooledBuffer>, SocketError>;
+
+        /**
+         * Variant of read, which also returns the receive timestamp of the kernel, see Socket::set_timestamping. With
+         * TCP, it's the timestamp of the latest segment, which the read returned bytes of.
+         */
+        [[nodiscard]] auto read_timestamped(kstd::u8* data, kstd::usize size) const noexcept
+                -> kstd::Result<TimestampedRead, SocketError>;
+
 #ifdef KSTD_CPP_20
-        [[nodiscard]] auto read(std::span<kstd::u8> data) const noexcept -> kstd::Result<kstd::usize>;
+        /**
+         * Awaitable variants of try_read and try_write, which suspend the awaiting coroutine on the reactor while the
+         * operation would block. async_write completes once all bytes were written. The socket has to outlive the
+         * returned task.
+         */
+        [[nodiscard]] auto async_read(Reactor& reactor, kstd::u8* data, kstd::usize size) const
+                -> Task<kstd::Result<kstd::usize, SocketError>>;
+        [[nodiscard]] auto async_write(Reactor& reactor, const void* data, kstd::usize size) const
+                -> Task<kstd::Result<kstd::usize, SocketError>>;
 #endif
+#endif
+
+        /**
+         * Sends length bytes of the file descriptor starting at offset. The kernel copies them directly from the page
+         * cache into the socket (sendfile), Windows falls back to a copy loop. Stops early at the end of the file or
+         * if a non-blocking socket would block and returns the count of sent bytes, which is zero if the socket would
+         * block before the first byte, so the call can be retried once the socket is writable.
+         */
+        [[nodiscard]] auto send_file(int file_handle, kstd::u64 offset, kstd::usize length) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
 
         auto operator=(const AcceptedSocket& other) -> AcceptedSocket& = delete;
         auto operator=(AcceptedSocket&& other) noexcept -> AcceptedSocket&;
     };
 
-    // TODO: Support for UDP
+    // UDP server sockets are only bound, datagrams are exchanged with the DatagramSocket on Linux
     class ServerSocket final : Socket {
         ProtocolType _protocol_type;
-#ifdef PLATFORM_WINDOWS
-        PADDRINFOW _addr_info;
-#endif
+
+        ServerSocket(ProtocolType protocol_type, SocketHandle socket_handle) noexcept;
+
         public:
-        ServerSocket(kstd::u16 port, ProtocolType protocol_type);
+        /**
+         * Binds the socket to the port on all interfaces. With reuse_port, multiple sockets may bind to the same port
+         * (SO_REUSEPORT) and the kernel spreads incoming connections across them. The options are applied before
+         * binding, accepted sockets inherit most of them. Throws if that fails, see create.
+         */
+        ServerSocket(kstd::u16 port, ProtocolType protocol_type, bool reuse_port = false,
+                     const SocketOptions& options = {});
+
+        /**
+         * Non-throwing variant of the constructor, which returns the error code of the failed step instead.
+         */
+        [[nodiscard]] static auto create(kstd::u16 port, ProtocolType protocol_type, bool reuse_port = false,
+                                         const SocketOptions& options = {}) noexcept
+                -> kstd::Result<ServerSocket, SocketError>;
         ServerSocket(const ServerSocket& other) = delete;
         ServerSocket(ServerSocket&& other) noexcept;
         ~ServerSocket() noexcept final;
 
-        [[nodiscard]] auto accept() const noexcept -> kstd::Result<AcceptedSocket>;
+        using Socket::set_blocking;
+        using Socket::set_timeouts;
+        using Socket::set_options;
+        using Socket::get_options;
+        using Socket::set_statistics;
+        using Socket::statistics;
+
+        [[nodiscard]] auto accept() const noexcept -> kstd::Result<AcceptedSocket, SocketError>;
+
+        /**
+         * Variant of accept, which fails with a timed out error if no connection is pending until the deadline. The
+         * accepted socket is blocking.
+         */
+        [[nodiscard]] auto accept(Deadline deadline) const noexcept -> kstd::Result<AcceptedSocket, SocketError>;
+
+        /**
+         * Non-blocking variant of accept. An empty option signals that no connection is pending. The accepted socket
+         * is non-blocking itself.
+         */
+        [[nodiscard]] auto try_accept() const noexcept -> kstd::Result<kstd::Option<AcceptedSocket>, SocketError>;
+
+#if defined(PLATFORM_LINUX) && defined(KSTD_CPP_20)
+        /**
+         * Awaitable variant of accept, which switches the socket into non-blocking mode and suspends the awaiting
+         * coroutine on the reactor until a connection is pending. The accepted socket is non-blocking.
+         */
+        [[nodiscard]] auto async_accept(Reactor& reactor) const -> Task<kstd::Result<AcceptedSocket, SocketError>>;
+#endif
 
         [[nodiscard]] inline auto protocol_type() const noexcept -> ProtocolType {
             return _protocol_type;
@@ -83,8 +293,39 @@ namespace sockslib {
     class ClientSocket final : Socket {
         ProtocolType _protocol_type;
 
+        ClientSocket(ProtocolType protocol_type, SocketHandle socket_handle) noexcept;
+
         public:
-        ClientSocket(std::string address, kstd::u16 port, ProtocolType protocol_type);
+        /**
+         * Connects to the address literal or all resolved addresses of the domain, see the constructor below.
+         */
+        ClientSocket(std::string address, kstd::u16 port, ProtocolType protocol_type,
+                     const SocketOptions& options = {});
+
+        /**
+         * Connects to the first reachable address (Happy Eyeballs, RFC 8305). The addresses are interleaved by family
+         * and a non-blocking connection attempt is started every attempt_delay, or right after the previous attempt
+         * failed, until one of them succeeds. The other attempts are closed and the socket is blocking afterwards.
+         * Windows tries the addresses one after another. The options are applied to every attempt before connecting.
+         */
+        ClientSocket(const std::vector<SocketAddress>& addresses, ProtocolType protocol_type,
+                     std::chrono::milliseconds attempt_delay = std::chrono::milliseconds {250},
+                     const SocketOptions& options = {});
+
+        /**
+         * Non-throwing variants of the constructors. A failed lookup of the domain is reported as RESOLVE error, a
+         * failed connect with the error of the last attempt. If no attempt succeeded until the deadline, the connect
+         * fails with a timed out error.
+         */
+        [[nodiscard]] static auto create(const std::string& address, kstd::u16 port, ProtocolType protocol_type,
+                                         const SocketOptions& options = {},
+                                         Deadline deadline = Deadline::max()) noexcept
+                -> kstd::Result<ClientSocket, SocketError>;
+        [[nodiscard]] static auto
+        create(const std::vector<SocketAddress>& addresses, ProtocolType protocol_type,
+               std::chrono::milliseconds attempt_delay = std::chrono::milliseconds {250},
+               Deadline deadline = Deadline::max(), const SocketOptions& options = {}) noexcept
+                -> kstd::Result<ClientSocket, SocketError>;
         ClientSocket(const ClientSocket& other) = delete;
         ClientSocket(ClientSocket&& other) noexcept;
         ~ClientSocket() noexcept final;
@@ -97,12 +338,90 @@ namespace sockslib {
             return _socket_handle;
         }
 
-        [[nodiscard]] auto write(void* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize>;
-        [[nodiscard]] auto read(kstd::u8* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize>;
+        using Socket::set_blocking;
+        using Socket::set_timeouts;
+        using Socket::set_options;
+        using Socket::get_options;
+        using Socket::set_statistics;
+        using Socket::statistics;
+        using Socket::tcp_info;
+#ifdef PLATFORM_LINUX
+        using Socket::set_timestamping;
+        using Socket::try_read_transmit_timestamp;
+#endif
+
+        [[nodiscard]] auto write(void* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize, SocketError>;
+        [[nodiscard]] auto read(kstd::u8* data, kstd::usize size) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+
+        /**
+         * Deadline variants of write and read, see AcceptedSocket::write and AcceptedSocket::read.
+         */
+        [[nodiscard]] auto write(const void* data, kstd::usize size, Deadline deadline) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+        [[nodiscard]] auto read(kstd::u8* data, kstd::usize size, Deadline deadline) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
 #ifdef KSTD_CPP_20
-        [[nodiscard]] auto read(std::span<kstd::u8> data) const noexcept -> kstd::Result<kstd::usize>;
+        [[nodiscard]] auto read(std::span<kstd::u8> data) const noexcept -> kstd::Result<kstd::usize, SocketError>;
+
+        /**
+         * Scatter/gather variants of write and read, see AcceptedSocket::write and AcceptedSocket::read.
+         */
+        [[nodiscard]] auto write(std::span<const std::span<const kstd::u8>> buffers) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+        [[nodiscard]] auto read(std::span<const std::span<kstd::u8>> buffers) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+        [[nodiscard]] auto write_all(std::span<const std::span<const kstd::u8>> buffers) const noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
 #endif
 
+        /**
+         * Non-blocking variants of write and read, see AcceptedSocket::try_write and AcceptedSocket::try_read.
+         */
+        [[nodiscard]] auto try_write(const void* data, kstd::usize size) const noexcept
+                -> kstd::Result<kstd::Option<kstd::usize>, SocketError>;
+        [[nodiscard]] auto try_read(kstd::u8* data, kstd::usize size) const noexcept
+                -> kstd::Result<kstd::Option<kstd::usize>, SocketError>;
+
+#ifdef PLATFORM_LINUX
+        /**
+         * Pooled variants of read and try_read, see AcceptedSocket::read and AcceptedSocket::try_read.
+         */
+        [[nodiscard]] auto read(BufferPool& pool) const noexcept -> kstd::Result<PooledBuffer, SocketError>;
+        [[nodiscard]] auto try_read(BufferPool& pool) const noexcept
+                -> kstd::Result<kstd::Option<PooledBuffer>, SocketError>;
+
+        /**
+         * Timestamped variant of read, see AcceptedSocket::read_timestamped.
+         */
+        [[nodiscard]] auto read_timestamped(kstd::u8* data, kstd::usize size) const noexcept
+                -> kstd::Result<TimestampedRead, SocketError>;
+
+#ifdef KSTD_CPP_20
+        /**
+         * Connects to the address without blocking, the awaiting coroutine is suspended on the reactor until the
+         * connection is established. The socket stays non-blocking.
+         */
+        [[nodiscard]] static auto async_connect(Reactor& reactor, SocketAddress address, ProtocolType protocol_type)
+                -> Task<kstd::Result<ClientSocket, SocketError>>;
+
+        /**
+         * Awaitable variants of try_read and try_write, see AcceptedSocket::async_read and AcceptedSocket::async_write.
+         */
+        [[nodiscard]] auto async_read(Reactor& reactor, kstd::u8* data, kstd::usize size) const
+                -> Task<kstd::Result<kstd::usize, SocketError>>;
+        [[nodiscard]] auto async_write(Reactor& reactor, const void* data, kstd::usize size) const
+                -> Task<kstd::Result<kstd::usize, SocketError>>;
+#endif
+#endif
+
+        /**
+         * Like try_read, but leaves the data in the socket (MSG_PEEK). Works with blocking sockets as well, which
+         * makes it a cheap check whether the peer closed an idle connection.
+         */
+        [[nodiscard]] auto try_peek(kstd::u8* data, kstd::usize size) const noexcept
+                -> kstd::Result<kstd::Option<kstd::usize>, SocketError>;
+
         auto operator=(const ClientSocket& other) -> ClientSocket& = delete;
         auto operator=(ClientSocket&& other) noexcept -> ClientSocket&;
     };
@@ -0,0 +1,194 @@
+#pragma once
+#ifdef PLATFORM_WINDOWS
+#define NOMINMAX
+#include <WS2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+#include <kstd/types.hpp>
+#include <kstd/option.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fmt/format.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sockslib/resolve.hpp"
+#include "sockslib/utils.hpp"
+
+namespace sockslib {
+    /**
+     * IPv4 or IPv6 address with port in the binary representation of the socket API.
+     */
+    class SocketAddress final {
+        sockaddr_storage _storage;
+        socklen_t _length;
+
+        public:
+        SocketAddress() noexcept :
+                _storage {},
+                _length {0} {
+        }
+
+        SocketAddress(const IPv4Address& address, const kstd::u16 port) noexcept :
+                _storage {},
+                _length {sizeof(sockaddr_in)} {
+            auto* ipv4_address = reinterpret_cast<sockaddr_in*>(&_storage);// NOLINT
+            ipv4_address->sin_family = AF_INET;
+            ipv4_address->sin_port = htons(port);
+            std::memcpy(&ipv4_address->sin_addr, address.octets.data(), address.octets.size());
+        }
+
+        SocketAddress(const IPv6Address& address, const kstd::u16 port) noexcept :
+                _storage {},
+                _length {sizeof(sockaddr_in6)} {
+            auto* ipv6_address = reinterpret_cast<sockaddr_in6*>(&_storage);// NOLINT
+            ipv6_address->sin6_family = AF_INET6;
+            ipv6_address->sin6_port = htons(port);
+            std::memcpy(&ipv6_address->sin6_addr, address.octets.data(), address.octets.size());
+
+            // The zone is either the numeric scope ID or the name of an interface
+            kstd::u32 scope_id = 0;
+            for(const auto character : address.zone) {
+                if(!detail::is_digit(character)) {
+                    scope_id = 0;
+#ifndef PLATFORM_WINDOWS
+                    scope_id = if_nametoindex(std::string {address.zone}.c_str());
+#endif
+                    break;
+                }
+                scope_id = scope_id * 10 + static_cast<kstd::u32>(character - '0');
+            }
+            ipv6_address->sin6_scope_id = scope_id;
+        }
+
+        /**
+         * Parses an IPv4 or IPv6 literal, an empty option is returned if the literal is neither of both.
+         */
+        [[nodiscard]] static auto from_literal(const std::string_view address, const kstd::u16 port) noexcept
+                -> kstd::Option<SocketAddress> {
+            if(const auto ipv4_address = parse_ipv4_address(address); ipv4_address) {
+                return {SocketAddress {ipv4_address.get(), port}};
+            }
+            if(const auto ipv6_address = parse_ipv6_address(address); ipv6_address) {
+                return {SocketAddress {ipv6_address.get(), port}};
+            }
+            return {};
+        }
+
+        [[nodiscard]] inline auto is_empty() const noexcept -> bool {
+            return _length == 0;
+        }
+
+        [[nodiscard]] inline auto address_type() const noexcept -> AddressType {
+            return _storage.ss_family == AF_INET6 ? AddressType::IPV6 : AddressType::IPV4;
+        }
+
+        [[nodiscard]] inline auto port() const noexcept -> kstd::u16 {
+            if(_storage.ss_family == AF_INET6) {
+                return ntohs(reinterpret_cast<const sockaddr_in6*>(&_storage)->sin6_port);// NOLINT
+            }
+            return ntohs(reinterpret_cast<const sockaddr_in*>(&_storage)->sin_port);// NOLINT
+        }
+
+        inline auto set_port(const kstd::u16 port) noexcept -> void {
+            if(_storage.ss_family == AF_INET6) {
+                reinterpret_cast<sockaddr_in6*>(&_storage)->sin6_port = htons(port);// NOLINT
+                return;
+            }
+            reinterpret_cast<sockaddr_in*>(&_storage)->sin_port = htons(port);// NOLINT
+        }
+
+        [[nodiscard]] inline auto data() noexcept -> sockaddr* {
+            return reinterpret_cast<sockaddr*>(&_storage);// NOLINT
+        }
+
+        [[nodiscard]] inline auto data() const noexcept -> const sockaddr* {
+            return reinterpret_cast<const sockaddr*>(&_storage);// NOLINT
+        }
+
+        [[nodiscard]] inline auto length() const noexcept -> socklen_t {
+            return _length;
+        }
+
+        /**
+         * Size of the underlying storage, which is passed to the functions filling in the address.
+         */
+        [[nodiscard]] static constexpr auto capacity() noexcept -> socklen_t {
+            return sizeof(sockaddr_storage);
+        }
+
+        inline auto set_length(const socklen_t length) noexcept -> void {
+            _length = length;
+        }
+
+        /**
+         * Formats the IP address without the port.
+         */
+        [[nodiscard]] auto address_to_string() const -> std::string {
+            std::array<char, INET6_ADDRSTRLEN> address {};
+            if(_storage.ss_family == AF_INET6) {
+                const auto* ipv6_address = reinterpret_cast<const sockaddr_in6*>(&_storage);// NOLINT
+                inet_ntop(AF_INET6, &ipv6_address->sin6_addr, address.data(), address.size());
+            }
+            else {
+                const auto* ipv4_address = reinterpret_cast<const sockaddr_in*>(&_storage);// NOLINT
+                inet_ntop(AF_INET, &ipv4_address->sin_addr, address.data(), address.size());
+            }
+            return address.data();
+        }
+
+        /**
+         * Formats the address as 'address:port' for IPv4 and '[address]:port' for IPv6.
+         */
+        [[nodiscard]] auto to_string() const -> std::string {
+            if(_storage.ss_family == AF_INET6) {
+                return fmt::format("[{}]:{}", address_to_string(), port());
+            }
+            return fmt::format("{}:{}", address_to_string(), port());
+        }
+
+        [[nodiscard]] auto operator==(const SocketAddress& other) const noexcept -> bool {
+            return _length == other._length && std::memcmp(&_storage, &other._storage, _length) == 0;
+        }
+
+        [[nodiscard]] auto operator!=(const SocketAddress& other) const noexcept -> bool {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * Orders the addresses alternating by family, starting with the family of the first address, while keeping the
+     * order within each family (RFC 8305, section 4).
+     */
+    [[nodiscard]] inline auto interleave_address_families(const std::vector<SocketAddress>& addresses)
+            -> std::vector<SocketAddress> {
+        if(addresses.empty()) {
+            return {};
+        }
+
+        std::vector<SocketAddress> preferred {};
+        std::vector<SocketAddress> other {};
+        const auto preferred_type = addresses.front().address_type();
+        for(const auto& address : addresses) {
+            (address.address_type() == preferred_type ? preferred : other).push_back(address);
+        }
+
+        std::vector<SocketAddress> interleaved {};
+        interleaved.reserve(addresses.size());
+        for(kstd::usize i = 0; i < std::max(preferred.size(), other.size()); ++i) {
+            if(i < preferred.size()) {
+                interleaved.push_back(preferred[i]);
+            }
+            if(i < other.size()) {
+                interleaved.push_back(other[i]);
+            }
+        }
+        return interleaved;
+    }
+}// namespace sockslib
@@ -0,0 +1,142 @@
+#pragma once
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <fmt/format.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "sockslib/utils.hpp"
+
+#ifndef PLATFORM_WINDOWS
+#include <errno.h>
+#endif
+
+namespace sockslib {
+    /**
+     * Step of a socket function, which failed with a SocketError.
+     */
+    enum class SocketOperation : kstd::u8 {
+        CREATE,
+        CONFIGURE,
+        BIND,
+        LISTEN,
+        ACCEPT,
+        RESOLVE,
+        CONNECT,
+        READ,
+        WRITE
+    };
+
+    [[nodiscard]] constexpr auto to_string(const SocketOperation operation) noexcept -> std::string_view {
+        switch(operation) {
+            case SocketOperation::CREATE: return "Unable to initialize socket";
+            case SocketOperation::CONFIGURE: return "Unable to configure socket";
+            case SocketOperation::BIND: return "Unable to bind socket";
+            case SocketOperation::LISTEN: return "Unable to listen with socket";
+            case SocketOperation::ACCEPT: return "Unable to accept socket";
+            case SocketOperation::RESOLVE: return "Unable to resolve address";
+            case SocketOperation::CONNECT: return "Unable to connect with socket";
+            case SocketOperation::READ: return "Unable to read from socket";
+            case SocketOperation::WRITE: return "Unable to write to socket";
+        }
+        return "Unable to use socket";
+    }
+
+    /**
+     * Error of a socket function as the platform error code (errno or WSA error) and the failed operation. It is
+     * copied around without allocating, the message is only formatted if to_string is called.
+     */
+    class SocketError final {
+        kstd::i32 _code;
+        SocketOperation _operation;
+
+        public:
+        constexpr SocketError(const SocketOperation operation, const kstd::i32 code) noexcept :
+                _code {code},
+                _operation {operation} {
+        }
+
+        /**
+         * Captures the error code of the last failed socket call, see get_last_error_code.
+         */
+        [[nodiscard]] static auto last(const SocketOperation operation) noexcept -> SocketError {
+            return {operation, get_last_error_code()};
+        }
+
+        [[nodiscard]] constexpr auto code() const noexcept -> kstd::i32 {
+            return _code;
+        }
+
+        [[nodiscard]] constexpr auto operation() const noexcept -> SocketOperation {
+            return _operation;
+        }
+
+        /**
+         * Checks whether a non-blocking operation failed, because it would block.
+         */
+        [[nodiscard]] constexpr auto would_block() const noexcept -> bool {
+#ifdef PLATFORM_WINDOWS
+            return _code == WSAEWOULDBLOCK;
+#else
+            return _code == EAGAIN || _code == EWOULDBLOCK;
+#endif
+        }
+
+        /**
+         * Checks whether the peer reset or aborted the connection, which is expected with short-lived connections.
+         */
+        [[nodiscard]] constexpr auto connection_reset() const noexcept -> bool {
+#ifdef PLATFORM_WINDOWS
+            return _code == WSAECONNRESET || _code == WSAECONNABORTED;
+#else
+            return _code == ECONNRESET || _code == ECONNABORTED || _code == EPIPE;
+#endif
+        }
+
+        /**
+         * Checks whether the operation missed its deadline or the timeout of the socket, see Socket::set_timeouts.
+         */
+        [[nodiscard]] constexpr auto timed_out() const noexcept -> bool {
+#ifdef PLATFORM_WINDOWS
+            return _code == WSAETIMEDOUT;
+#else
+            return _code == ETIMEDOUT;
+#endif
+        }
+
+        [[nodiscard]] auto to_string() const -> std::string {
+#ifndef PLATFORM_WINDOWS
+            // Resolvers report unknown hosts as ENOENT, whose message is about files
+            if(_operation == SocketOperation::RESOLVE && _code == ENOENT) {
+                return fmt::format("{} => Host not found", sockslib::to_string(_operation));
+            }
+#endif
+            return fmt::format("{} => {}", sockslib::to_string(_operation), format_error(_code));
+        }
+
+        // The conversion lets errors be thrown and forwarded like the string errors of the other functions
+        operator std::string() const {// NOLINT
+            return to_string();
+        }
+
+        [[nodiscard]] constexpr auto operator==(const SocketError& other) const noexcept -> bool {
+            return _code == other._code && _operation == other._operation;
+        }
+
+        [[nodiscard]] constexpr auto operator!=(const SocketError& other) const noexcept -> bool {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * Returns the value of the result or throws the formatted error, which is how the constructors report errors.
+     */
+    template<typename T>
+    [[nodiscard]] auto get_or_throw(kstd::Result<T, SocketError>&& result) -> T {
+        if(result.is_error()) {
+            throw std::runtime_error {result.get_error().to_string()};
+        }
+        return std::move(result.get());
+    }
+}// namespace sockslib
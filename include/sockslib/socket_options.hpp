@@ -0,0 +1,27 @@
+#pragma once
+#include <kstd/types.hpp>
+#include <kstd/option.hpp>
+#include <chrono>
+
+namespace sockslib {
+    /**
+     * Latency related options of a socket. Only the options with a value are applied, the others keep the default of
+     * the kernel. Options, which the platform doesn't support, fail with ENOPROTOOPT (WSAENOPROTOOPT on Windows):
+     * macOS has no quick_ack, busy_poll, fast_open_connect, defer_accept and incoming_cpu and Windows supports only
+     * no_delay, the buffer sizes and fast_open.
+     */
+    struct SocketOptions final {
+        kstd::Option<bool> no_delay;// TCP_NODELAY, sends small segments without waiting for outstanding ACKs
+        // TCP_QUICKACK, the kernel may return to delayed ACKs later, the library doesn't reapply it after reads
+        kstd::Option<bool> quick_ack;
+        kstd::Option<bool> cork;// TCP_CORK (TCP_NOPUSH on macOS), holds back partial segments until cleared
+        kstd::Option<kstd::i32> send_buffer_size;// SO_SNDBUF, Linux reports twice the requested size
+        kstd::Option<kstd::i32> receive_buffer_size;// SO_RCVBUF, applied before connect/listen to affect the window
+        kstd::Option<std::chrono::microseconds> busy_poll;// SO_BUSY_POLL, time to spin on the device queue in reads
+        kstd::Option<kstd::u32> not_sent_low_watermark;// TCP_NOTSENT_LOWAT, unsent bytes before writable again
+        kstd::Option<kstd::i32> fast_open;// TCP_FASTOPEN, queue length of TFO requests of listeners
+        kstd::Option<bool> fast_open_connect;// TCP_FASTOPEN_CONNECT, sends the first write with the SYN
+        kstd::Option<std::chrono::seconds> defer_accept;// TCP_DEFER_ACCEPT, accepts once the first data arrived
+        kstd::Option<kstd::i32> incoming_cpu;// SO_INCOMING_CPU, CPU which handles the receive path
+    };
+}// namespace sockslib
@@ -0,0 +1,62 @@
+#pragma once
+#ifdef PLATFORM_LINUX
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <kstd/option.hpp>
+#include "sockslib/socket.hpp"
+
+namespace sockslib {
+    /**
+     * Forwards bytes between two sockets through a kernel pipe (splice), so proxy-style relays never copy the data
+     * into user space. Bytes, which could not be written into a non-blocking destination yet, stay in the pipe and are
+     * forwarded first with the next call.
+     */
+    class SpliceRelay final {
+        int _pipe_read_handle;
+        int _pipe_write_handle;
+        kstd::usize _pipe_size;
+        kstd::usize _pending_size;
+
+        auto release() noexcept -> void;
+
+        public:
+        /**
+         * Creates the pipe and tries to resize it to pipe_size bytes. The kernel limits the size for unprivileged
+         * processes (/proc/sys/fs/pipe-max-size), in which case the default size is kept.
+         */
+        explicit SpliceRelay(kstd::usize pipe_size = 256 * 1024);
+        SpliceRelay(const SpliceRelay& other) = delete;
+        SpliceRelay(SpliceRelay&& other) noexcept;
+        ~SpliceRelay() noexcept;
+
+        [[nodiscard]] inline auto pipe_size() const noexcept -> kstd::usize {
+            return _pipe_size;
+        }
+
+        /**
+         * Count of bytes, which were read from the source but not written into the destination yet.
+         */
+        [[nodiscard]] inline auto pending_size() const noexcept -> kstd::usize {
+            return _pending_size;
+        }
+
+        /**
+         * Moves up to max_size bytes (limited by the pipe size) from the source into the destination and returns the
+         * count of read bytes. Zero bytes signal that the source closed the connection. An empty option signals that a
+         * non-blocking source has no data yet or that the pending bytes still don't fit into the destination.
+         */
+        [[nodiscard]] auto forward(SocketHandle source, SocketHandle destination, kstd::usize max_size) noexcept
+                -> kstd::Result<kstd::Option<kstd::usize>>;
+
+        /**
+         * Forwards bytes until the source closed the connection and returns the count of forwarded bytes. Only works
+         * with blocking sockets, it fails if one of them would block.
+         */
+        [[nodiscard]] auto forward_all(SocketHandle source, SocketHandle destination) noexcept
+                -> kstd::Result<kstd::usize>;
+
+        auto operator=(const SpliceRelay& other) -> SpliceRelay& = delete;
+        auto operator=(SpliceRelay&& other) noexcept -> SpliceRelay&;
+    };
+}// namespace sockslib
+#endif
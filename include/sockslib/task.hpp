@@ -0,0 +1,192 @@
+#pragma once
+#include <kstd/language.hpp>
+#if defined(PLATFORM_LINUX) && defined(KSTD_CPP_20)
+#include <kstd/types.hpp>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace sockslib {
+    namespace detail {
+        /**
+         * Coroutine frames are taken from thread-local freelists, one per size class of 64 bytes. Frames above the
+         * largest size class are allocated directly.
+         */
+        [[nodiscard]] auto allocate_frame(std::size_t size) -> void*;
+        auto release_frame(void* frame, std::size_t size) noexcept -> void;
+
+        /**
+         * Count of frames allocated by this thread, which were served from the freelists.
+         */
+        [[nodiscard]] auto reused_frame_count() noexcept -> kstd::usize;
+
+        // The promise types inherit the allocation functions, which the compiler uses for the coroutine frame
+        struct PooledFrame {
+            [[nodiscard]] static auto operator new(const std::size_t size) -> void* {
+                return allocate_frame(size);
+            }
+
+            static auto operator delete(void* frame, const std::size_t size) noexcept -> void {
+                release_frame(frame, size);
+            }
+        };
+
+        template<typename P>
+        struct TaskFinalAwaiter final {
+            [[nodiscard]] constexpr auto await_ready() const noexcept -> bool {
+                return false;
+            }
+
+            // Symmetric transfer to the awaiting coroutine, so long chains of tasks don't grow the stack
+            [[nodiscard]] auto await_suspend(std::coroutine_handle<P> handle) const noexcept
+                    -> std::coroutine_handle<> {
+                const auto continuation = handle.promise().continuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+
+            constexpr auto await_resume() const noexcept -> void {
+            }
+        };
+
+        struct TaskPromiseBase : PooledFrame {
+            std::coroutine_handle<> continuation;
+            std::exception_ptr exception;
+
+            [[nodiscard]] constexpr auto initial_suspend() const noexcept -> std::suspend_always {
+                return {};
+            }
+
+            auto unhandled_exception() noexcept -> void {
+                exception = std::current_exception();
+            }
+        };
+    }// namespace detail
+
+    template<typename T>
+    class Task;
+
+    namespace detail {
+        template<typename T>
+        struct TaskPromise final : TaskPromiseBase {
+            std::optional<T> value;
+
+            [[nodiscard]] auto get_return_object() noexcept -> Task<T>;
+
+            [[nodiscard]] auto final_suspend() const noexcept -> TaskFinalAwaiter<TaskPromise> {
+                return {};
+            }
+
+            template<typename V>
+            auto return_value(V&& return_value) -> void {
+                value.emplace(std::forward<V>(return_value));
+            }
+
+            [[nodiscard]] auto result() -> T {
+                if(exception) {
+                    std::rethrow_exception(exception);
+                }
+                return std::move(*value);
+            }
+        };
+
+        template<>
+        struct TaskPromise<void> final : TaskPromiseBase {
+            [[nodiscard]] auto get_return_object() noexcept -> Task<void>;
+
+            [[nodiscard]] auto final_suspend() const noexcept -> TaskFinalAwaiter<TaskPromise> {
+                return {};
+            }
+
+            constexpr auto return_void() const noexcept -> void {
+            }
+
+            auto result() const -> void {
+                if(exception) {
+                    std::rethrow_exception(exception);
+                }
+            }
+        };
+    }// namespace detail
+
+    /**
+     * Lazily started coroutine, which runs once it gets awaited and resumes the awaiting coroutine with its result.
+     * Tasks, which are not awaited by another coroutine, are started with Reactor::spawn.
+     */
+    template<typename T = void>
+    class Task final {
+        public:
+        using promise_type = detail::TaskPromise<T>;
+
+        private:
+        std::coroutine_handle<promise_type> _handle;
+
+        struct Awaiter final {
+            std::coroutine_handle<promise_type> handle;
+
+            [[nodiscard]] constexpr auto await_ready() const noexcept -> bool {
+                return false;
+            }
+
+            [[nodiscard]] auto await_suspend(std::coroutine_handle<> awaiting_handle) const noexcept
+                    -> std::coroutine_handle<> {
+                handle.promise().continuation = awaiting_handle;
+                return handle;
+            }
+
+            auto await_resume() const -> T {
+                return handle.promise().result();
+            }
+        };
+
+        public:
+        explicit Task(std::coroutine_handle<promise_type> handle) noexcept :
+                _handle {handle} {
+        }
+
+        Task(const Task& other) = delete;
+
+        Task(Task&& other) noexcept :
+                _handle {std::exchange(other._handle, nullptr)} {
+        }
+
+        ~Task() noexcept {
+            if(_handle) {
+                _handle.destroy();
+            }
+        }
+
+        [[nodiscard]] inline auto is_done() const noexcept -> bool {
+            return !_handle || _handle.done();
+        }
+
+        auto operator co_await() && noexcept -> Awaiter {
+            return {_handle};
+        }
+
+        auto operator=(const Task& other) -> Task& = delete;
+
+        auto operator=(Task&& other) noexcept -> Task& {
+            if(this != &other) {
+                if(_handle) {
+                    _handle.destroy();
+                }
+                _handle = std::exchange(other._handle, nullptr);
+            }
+            return *this;
+        }
+    };
+
+    namespace detail {
+        template<typename T>
+        auto TaskPromise<T>::get_return_object() noexcept -> Task<T> {
+            return Task<T> {std::coroutine_handle<TaskPromise>::from_promise(*this)};
+        }
+
+        inline auto TaskPromise<void>::get_return_object() noexcept -> Task<void> {
+            return Task<void> {std::coroutine_handle<TaskPromise>::from_promise(*this)};
+        }
+    }// namespace detail
+}// namespace sockslib
+#endif
@@ -0,0 +1,142 @@
+#pragma once
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "sockslib/socket_error.hpp"
+#include "sockslib/utils.hpp"
+
+namespace sockslib {
+    /**
+     * Snapshot of the kernel state of a TCP connection (TCP_INFO, TCP_CONNECTION_INFO on macOS and SIO_TCP_INFO on
+     * Windows). A growing RTT with a steady congestion window and no retransmits points to queueing in the network,
+     * retransmits to loss, and a low RTT while the latency of the application is high to the application itself.
+     */
+    struct TcpInfo final {
+        std::chrono::microseconds rtt {};// Smoothed round-trip time
+        std::chrono::microseconds rtt_variance {};// Mean deviation of the RTT, zero on Windows
+        kstd::u64 congestion_window = 0;// Bytes, which may be sent without waiting for an ACK
+        kstd::u64 bytes_in_flight = 0;// Sent but not acknowledged bytes, includes the unsent bytes on macOS
+        kstd::u64 retransmits = 0;// Retransmitted segments since the connection was established
+        kstd::u64 delivery_rate = 0;// Bytes per second of the recent ACKs, only reported by Linux 4.9+
+    };
+
+    /**
+     * Reads the TCP_INFO of the socket, see Socket::tcp_info.
+     */
+    [[nodiscard]] auto get_tcp_info(SocketHandle socket_handle) noexcept -> kstd::Result<TcpInfo, SocketError>;
+
+    struct TcpInfoSample final {
+        SocketHandle socket_handle;
+        std::chrono::steady_clock::time_point time;
+        TcpInfo info;
+    };
+
+    /**
+     * Polls the TCP_INFO of a set of sockets into a ring buffer, which keeps the latest samples. With an interval,
+     * a thread of the sampler polls the sockets, otherwise they are only polled by calling sample. Sockets, which
+     * fail to report their state, are skipped. Sockets have to be removed before they are closed, or the sampler may
+     * poll another socket with the same handle.
+     */
+    class TcpInfoSampler final {
+        mutable std::mutex _mutex;
+        std::condition_variable _stop_condition;
+        bool _stopping;
+        std::vector<SocketHandle> _socket_handles;
+        std::vector<TcpInfoSample> _samples;
+        kstd::usize _capacity;
+        kstd::usize _next_sample;// Index, which is overwritten next once the buffer is full
+        std::thread _thread;
+
+        public:
+        explicit TcpInfoSampler(const kstd::usize capacity,
+                                const std::chrono::milliseconds interval = std::chrono::milliseconds::zero()) :
+                _stopping {false},
+                _capacity {std::max<kstd::usize>(capacity, 1)},
+                _next_sample {0} {
+            _samples.reserve(_capacity);
+            if(interval > std::chrono::milliseconds::zero()) {
+                _thread = std::thread {[this, interval]() {
+                    std::unique_lock<std::mutex> lock {_mutex};
+                    while(!_stop_condition.wait_for(lock, interval, [this]() { return _stopping; })) {
+                        lock.unlock();
+                        sample();
+                        lock.lock();
+                    }
+                }};
+            }
+        }
+
+        TcpInfoSampler(const TcpInfoSampler& other) = delete;
+        TcpInfoSampler(TcpInfoSampler&& other) = delete;
+
+        ~TcpInfoSampler() noexcept {
+            {
+                const std::lock_guard<std::mutex> lock {_mutex};
+                _stopping = true;
+            }
+            _stop_condition.notify_all();
+            if(_thread.joinable()) {
+                _thread.join();
+            }
+        }
+
+        auto add(const SocketHandle socket_handle) -> void {
+            const std::lock_guard<std::mutex> lock {_mutex};
+            if(std::find(_socket_handles.begin(), _socket_handles.end(), socket_handle) == _socket_handles.end()) {
+                _socket_handles.push_back(socket_handle);
+            }
+        }
+
+        auto remove(const SocketHandle socket_handle) -> void {
+            const std::lock_guard<std::mutex> lock {_mutex};
+            _socket_handles.erase(std::remove(_socket_handles.begin(), _socket_handles.end(), socket_handle),
+                                  _socket_handles.end());
+        }
+
+        /**
+         * Polls all sockets once and returns the count of stored samples.
+         */
+        auto sample() -> kstd::usize {
+            const std::lock_guard<std::mutex> lock {_mutex};
+            const auto now = std::chrono::steady_clock::now();
+            kstd::usize sample_count = 0;
+            for(const auto socket_handle : _socket_handles) {
+                auto info = get_tcp_info(socket_handle);
+                if(!info) {
+                    continue;
+                }
+                TcpInfoSample sample {socket_handle, now, info.get()};
+                if(_samples.size() < _capacity) {
+                    _samples.push_back(sample);
+                }
+                else {
+                    _samples[_next_sample] = sample;
+                }
+                _next_sample = (_next_sample + 1) % _capacity;
+                ++sample_count;
+            }
+            return sample_count;
+        }
+
+        /**
+         * Copies the samples out of the ring buffer, the oldest one first.
+         */
+        [[nodiscard]] auto samples() const -> std::vector<TcpInfoSample> {
+            const std::lock_guard<std::mutex> lock {_mutex};
+            if(_samples.size() < _capacity) {
+                return _samples;
+            }
+            std::vector<TcpInfoSample> samples {};
+            samples.reserve(_samples.size());
+            const auto oldest_sample = _samples.begin() + static_cast<std::ptrdiff_t>(_next_sample);
+            samples.insert(samples.end(), oldest_sample, _samples.end());
+            samples.insert(samples.end(), _samples.begin(), oldest_sample);
+            return samples;
+        }
+    };
+}// namespace sockslib
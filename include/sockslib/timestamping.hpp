@@ -0,0 +1,40 @@
+#pragma once
+#ifdef PLATFORM_LINUX
+#include <kstd/types.hpp>
+#include <kstd/option.hpp>
+#include <chrono>
+
+namespace sockslib {
+    /**
+     * Time of the realtime clock (CLOCK_REALTIME), which the kernel takes its software timestamps from. It's only
+     * comparable with timestamps of other hosts as far as their clocks are synchronized.
+     */
+    using KernelTimestamp = std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>;
+
+    /**
+     * Software timestamps of SO_TIMESTAMPING, which are disabled by default. The receive timestamp is taken when the
+     * packet enters the network stack, so the difference to the time of the read is the queueing time in the kernel
+     * and the application. The transmit timestamp is taken when the packet is passed to the device. TCP sockets
+     * have to be connected to enable the id. The kernel reports receive timestamps to sockets with only transmit
+     * timestamps as well, once any socket enabled receive timestamps. It turns receive timestamps on in the
+     * background when the first socket of the system enables them, so the first packets may come without one.
+     */
+    struct TimestampingOptions final {
+        bool receive = true;// SOF_TIMESTAMPING_RX_SOFTWARE, returned by the *_timestamped reads
+        bool transmit = true;// SOF_TIMESTAMPING_TX_SOFTWARE, queued on the error queue of the socket
+        bool id = false;// SOF_TIMESTAMPING_OPT_ID, numbers the transmit timestamps, see TransmitTimestamp::id
+    };
+
+    struct TimestampedRead final {
+        kstd::usize size;
+        kstd::Option<KernelTimestamp> timestamp;// Empty if timestamping is disabled or nothing was received
+    };
+
+    struct TransmitTimestamp final {
+        // Without OPT_ID zero, otherwise the number of the datagram (UDP) or the offset of the last byte of the write
+        // (TCP), counted from zero since timestamping was enabled
+        kstd::u32 id;
+        KernelTimestamp timestamp;
+    };
+}// namespace sockslib
+#endif
@@ -0,0 +1,303 @@
+#pragma once
+#include <kstd/types.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "sockslib/utils.hpp"
+
+namespace sockslib {
+    /**
+     * Handle of a scheduled timer. It turns stale once the timer expired or got cancelled, stale handles are ignored.
+     */
+    struct TimerId final {
+        kstd::u32 index = std::numeric_limits<kstd::u32>::max();
+        kstd::u32 generation = 0;
+
+        [[nodiscard]] constexpr auto is_valid() const noexcept -> bool {
+            return index != std::numeric_limits<kstd::u32>::max();
+        }
+    };
+
+    /**
+     * Hierarchical timing wheel with 4 levels of 64 slots each. Scheduling, rescheduling and cancelling a timer are
+     * O(1) and advancing the wheel costs O(1) per tick plus the expired timers, no matter how many timers are pending.
+     * Timers of the upper levels cascade down once the level below wrapped around. The timers live in one slab with
+     * intrusive slot lists, so they don't allocate once the slab grew to the count of pending timers.
+     *
+     * A timer expires on the first tick at or after its deadline, never earlier. Deadlines beyond the range of the
+     * wheel (64^4 ticks) expire at the end of the range. The value type has to be default constructible.
+     */
+    template<typename T>
+    class TimingWheel final {
+        using clock = std::chrono::steady_clock;
+
+        static constexpr kstd::u32 slot_bits = 6;
+        static constexpr kstd::u32 slots_per_level = 1U << slot_bits;
+        static constexpr kstd::u32 slot_mask = slots_per_level - 1;
+        static constexpr kstd::u32 level_count = 4;
+        static constexpr kstd::u64 max_ticks = (1ULL << (slot_bits * level_count)) - 1;
+        static constexpr kstd::u32 no_node = std::numeric_limits<kstd::u32>::max();
+
+        // Nodes, which are not linked into a slot, are either expiring right now or free
+        static constexpr kstd::u32 expiring_slot = level_count * slots_per_level;
+        static constexpr kstd::u32 free_slot = expiring_slot + 1;
+
+        struct Node final {
+            T value;
+            kstd::u64 expiry_tick;
+            kstd::u32 previous;
+            kstd::u32 next;
+            kstd::u32 generation;
+            kstd::u32 slot;
+        };
+
+        clock::duration _tick;
+        clock::time_point _start;
+        kstd::u64 _current_tick;// Next tick to be processed
+        std::vector<Node> _nodes;
+        kstd::u32 _free_node;
+        kstd::usize _size;
+        std::array<kstd::u32, level_count * slots_per_level> _slots;
+        std::vector<kstd::u32> _expiring_nodes;
+
+        [[nodiscard]] auto to_tick(const clock::time_point time_point) const noexcept -> kstd::u64 {
+            return time_point <= _start ? 0 : static_cast<kstd::u64>((time_point - _start) / _tick);
+        }
+
+        // Rounds up, so the timer doesn't expire before its deadline
+        [[nodiscard]] auto to_expiry_tick(const clock::time_point deadline) const noexcept -> kstd::u64 {
+            if(deadline <= _start) {
+                return 0;
+            }
+            const auto elapsed = deadline - _start;
+            return static_cast<kstd::u64>(elapsed / _tick) + (elapsed % _tick != clock::duration::zero() ? 1 : 0);
+        }
+
+        [[nodiscard]] auto is_scheduled(const TimerId timer_id) const noexcept -> bool {
+            return timer_id.index < _nodes.size() && _nodes[timer_id.index].generation == timer_id.generation &&
+                   _nodes[timer_id.index].slot != free_slot;
+        }
+
+        auto link(const kstd::u32 index) noexcept -> void {
+            auto& node = _nodes[index];
+            if(node.expiry_tick > _current_tick && node.expiry_tick - _current_tick > max_ticks) {
+                node.expiry_tick = _current_tick + max_ticks;
+            }
+
+            // Overdue timers expire with the next processed tick
+            kstd::u32 slot = _current_tick & slot_mask;
+            if(node.expiry_tick >= _current_tick) {
+                const auto remaining_ticks = node.expiry_tick - _current_tick;
+                kstd::u32 level = 0;
+                while(level + 1 < level_count && remaining_ticks >> (slot_bits * (level + 1)) != 0) {
+                    ++level;
+                }
+                slot = level * slots_per_level + ((node.expiry_tick >> (slot_bits * level)) & slot_mask);
+            }
+
+            node.slot = slot;
+            node.previous = no_node;
+            node.next = _slots[slot];
+            if(node.next != no_node) {
+                _nodes[node.next].previous = index;
+            }
+            _slots[slot] = index;
+        }
+
+        auto unlink(const kstd::u32 index) noexcept -> void {
+            auto& node = _nodes[index];
+            if(node.slot >= expiring_slot) {
+                return;
+            }
+            if(node.previous != no_node) {
+                _nodes[node.previous].next = node.next;
+            }
+            else {
+                _slots[node.slot] = node.next;
+            }
+            if(node.next != no_node) {
+                _nodes[node.next].previous = node.previous;
+            }
+        }
+
+        auto release(const kstd::u32 index) noexcept -> void {
+            auto& node = _nodes[index];
+            node.value = T {};
+            node.slot = free_slot;
+            ++node.generation;
+            node.next = _free_node;
+            _free_node = index;
+            --_size;
+        }
+
+        // Moves the timers of the slot into the lower levels, returns the index of the slot within its level
+        auto cascade(const kstd::u32 level) noexcept -> kstd::u32 {
+            const auto slot_index = static_cast<kstd::u32>((_current_tick >> (slot_bits * level)) & slot_mask);
+            auto index = _slots[level * slots_per_level + slot_index];
+            _slots[level * slots_per_level + slot_index] = no_node;
+            while(index != no_node) {
+                const auto next = _nodes[index].next;
+                link(index);
+                index = next;
+            }
+            return slot_index;
+        }
+
+        template<typename F>
+        auto process_tick(F& callback) -> kstd::usize {
+            const auto slot_index = static_cast<kstd::u32>(_current_tick & slot_mask);
+            for(kstd::u32 level = 1; level < level_count && (level > 1 || slot_index == 0); ++level) {
+                if(cascade(level) != 0) {
+                    break;
+                }
+            }
+            ++_current_tick;
+
+            // The slot is detached first, the callbacks may schedule new timers into it
+            _expiring_nodes.clear();
+            for(auto index = _slots[slot_index]; index != no_node; index = _nodes[index].next) {
+                _expiring_nodes.push_back(index);
+            }
+            _slots[slot_index] = no_node;
+            for(const auto index : _expiring_nodes) {
+                _nodes[index].slot = expiring_slot;
+            }
+
+            kstd::usize expired_count = 0;
+            for(kstd::usize i = 0; i < _expiring_nodes.size(); ++i) {
+                const auto index = _expiring_nodes[i];
+                if(_nodes[index].slot != expiring_slot) {
+                    continue;// Cancelled or rescheduled by an earlier callback
+                }
+                auto value = std::move(_nodes[index].value);
+                release(index);
+                callback(std::move(value));
+                ++expired_count;
+            }
+            return expired_count;
+        }
+
+        public:
+        explicit TimingWheel(const std::chrono::nanoseconds tick = std::chrono::milliseconds {1},
+                             const clock::time_point start = clock::now()) :
+                _tick {std::chrono::duration_cast<clock::duration>(tick)},
+                _start {start},
+                _current_tick {0},
+                _free_node {no_node},
+                _size {0},
+                _slots {} {
+            if(_tick <= clock::duration::zero()) {
+                _tick = clock::duration {1};
+            }
+            _slots.fill(no_node);
+        }
+
+        /**
+         * Schedules the value to expire at the deadline and returns the handle of the timer.
+         */
+        auto schedule(const clock::time_point deadline, T value) -> TimerId {
+            kstd::u32 index = _free_node;
+            if(index != no_node) {
+                _free_node = _nodes[index].next;
+            }
+            else {
+                index = static_cast<kstd::u32>(_nodes.size());
+                _nodes.push_back(Node {T {}, 0, no_node, no_node, 0, free_slot});
+            }
+
+            auto& node = _nodes[index];
+            node.value = std::move(value);
+            node.expiry_tick = to_expiry_tick(deadline);
+            link(index);
+            ++_size;
+            return {index, node.generation};
+        }
+
+        /**
+         * Moves the timer to the new deadline, which is how idle timeouts are extended on activity. Returns false if
+         * the handle is stale.
+         */
+        auto reschedule(const TimerId timer_id, const clock::time_point deadline) noexcept -> bool {
+            if(!is_scheduled(timer_id)) {
+                return false;
+            }
+            unlink(timer_id.index);
+            _nodes[timer_id.index].expiry_tick = to_expiry_tick(deadline);
+            link(timer_id.index);
+            return true;
+        }
+
+        /**
+         * Removes the timer without expiring it. Returns false if the handle is stale.
+         */
+        auto cancel(const TimerId timer_id) noexcept -> bool {
+            if(!is_scheduled(timer_id)) {
+                return false;
+            }
+            unlink(timer_id.index);
+            release(timer_id.index);
+            return true;
+        }
+
+        /**
+         * Processes all ticks up to the specified time and passes the value of every expired timer to the callback.
+         * The callback may schedule, reschedule and cancel timers, but must not advance the wheel. Returns the count of
+         * expired timers.
+         */
+        template<typename F>
+        auto advance(const clock::time_point now, F&& callback) -> kstd::usize {
+            const auto target_tick = to_tick(now);
+            if(_size == 0) {
+                _current_tick = std::max(_current_tick, target_tick + 1);
+                return 0;
+            }
+
+            kstd::usize expired_count = 0;
+            while(_current_tick <= target_tick && _size > 0) {
+                expired_count += process_tick(callback);
+            }
+            if(_size == 0) {
+                _current_tick = std::max(_current_tick, target_tick + 1);
+            }
+            return expired_count;
+        }
+
+        /**
+         * Point in time, when advancing the wheel may expire timers next. This is the next tick with timers in the
+         * lowest level or the next cascade, which makes it a poll timeout that never wakes up too late.
+         */
+        [[nodiscard]] auto next_expiry() const noexcept -> clock::time_point {
+            if(_size == 0) {
+                return clock::time_point::max();
+            }
+
+            // The lowest level holds the timers of the current rotation, the next cascade may refill it
+            auto tick = _current_tick;
+            if((tick & slot_mask) == 0) {
+                return _start + _tick * static_cast<clock::rep>(tick);
+            }
+            do {
+                if(_slots[tick & slot_mask] != no_node) {
+                    break;
+                }
+                ++tick;
+            } while((tick & slot_mask) != 0);
+            return _start + _tick * static_cast<clock::rep>(tick);
+        }
+
+        [[nodiscard]] inline auto size() const noexcept -> kstd::usize {
+            return _size;
+        }
+
+        [[nodiscard]] inline auto is_empty() const noexcept -> bool {
+            return _size == 0;
+        }
+
+        [[nodiscard]] inline auto tick() const noexcept -> std::chrono::nanoseconds {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(_tick);
+        }
+    };
+}// namespace sockslib
@@ -0,0 +1,276 @@
+#pragma once
+#include <kstd/types.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "sockslib/utils.hpp"
+
+#ifndef PLATFORM_WINDOWS
+#include <errno.h>
+#endif
+
+namespace sockslib {
+    enum class TraceEvent : kstd::u8 {
+        CONNECT,
+        ACCEPT,
+        SEND,
+        RECV
+    };
+
+    [[nodiscard]] constexpr auto to_string(const TraceEvent event) noexcept -> std::string_view {
+        switch(event) {
+            case TraceEvent::CONNECT: return "connect";
+            case TraceEvent::ACCEPT: return "accept";
+            case TraceEvent::SEND: return "send";
+            case TraceEvent::RECV: return "recv";
+        }
+        return "unknown";
+    }
+
+    /**
+     * Nanoseconds of the monotonic clock (CLOCK_MONOTONIC on Linux), which all trace timestamps are taken from.
+     */
+    [[nodiscard]] inline auto trace_timestamp() noexcept -> kstd::u64 {
+        const auto time = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<kstd::u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+    }
+
+    /**
+     * Receives the start and the end of the traced socket calls. Both are called on the thread of the call, which
+     * may be any thread, and the calls of one thread never nest. The result is the return value of the syscall.
+     */
+    class TraceSink {
+        public:
+        virtual ~TraceSink() noexcept = default;
+
+        virtual auto begin(TraceEvent event, SocketHandle socket_handle, kstd::u64 timestamp) noexcept -> void = 0;
+        virtual auto end(TraceEvent event, SocketHandle socket_handle, kstd::u64 timestamp,
+                         kstd::i64 result) noexcept -> void = 0;
+    };
+
+    namespace detail {
+        inline std::atomic<TraceSink*> trace_sink {nullptr};
+    }// namespace detail
+
+    /**
+     * Installs the sink of the tracing hooks, nullptr removes it. The sink has to outlive the socket calls, which may
+     * still use it after it was replaced. The hooks only exist with SOCKSLIB_TRACING, otherwise the sink is never
+     * called.
+     */
+    inline auto set_trace_sink(TraceSink* sink) noexcept -> void {
+        detail::trace_sink.store(sink, std::memory_order_release);
+    }
+
+    /**
+     * Runs the socket call between the hooks of the trace sink. Without SOCKSLIB_TRACING, this only runs the call.
+     */
+    template<typename F>
+    inline auto trace_call(const TraceEvent event, const SocketHandle socket_handle, F&& call) noexcept
+            -> decltype(call()) {
+#ifdef SOCKSLIB_TRACING
+        auto* sink = detail::trace_sink.load(std::memory_order_acquire);
+        if(sink == nullptr) {
+            return call();
+        }
+        sink->begin(event, socket_handle, trace_timestamp());
+        const auto result = call();
+        const auto end_timestamp = trace_timestamp();
+
+        // The error code is read by the caller, the sink may overwrite it
+        const auto error_code = get_last_error_code();
+        sink->end(event, socket_handle, end_timestamp, static_cast<kstd::i64>(result));
+#ifdef PLATFORM_WINDOWS
+        WSASetLastError(error_code);
+#else
+        errno = error_code;
+#endif
+        return result;
+#else
+        static_cast<void>(event);
+        static_cast<void>(socket_handle);
+        return call();
+#endif
+    }
+
+    struct TraceRecord final {
+        TraceEvent event;
+        kstd::u32 thread_index;// Order in which the threads traced their first call
+        kstd::i64 socket_handle;
+        kstd::u64 start;
+        kstd::u64 end;
+        kstd::i64 result;
+    };
+
+    /**
+     * Sink which keeps the latest calls of every thread in a ring buffer of the thread. Recording is wait-free, a
+     * thread only takes a lock for the first call it traces. If its buffer can't be allocated, the calls of the thread
+     * are dropped. The records can be read at any time, records which are overwritten while they are read are
+     * dropped. The buffers of finished threads are kept until the sink is destroyed.
+     */
+    class RingBufferTraceSink final : public TraceSink {
+        struct Slot final {
+            std::atomic<kstd::u64> start;
+            std::atomic<kstd::u64> end;
+            std::atomic<kstd::i64> socket_handle;
+            std::atomic<kstd::i64> result;
+            std::atomic<TraceEvent> event;
+        };
+
+        struct alignas(64) ThreadBuffer final {
+            std::unique_ptr<Slot[]> slots;// NOLINT
+            std::atomic<kstd::u64> head;// Count of written records
+            kstd::u64 pending_start;
+            kstd::u32 thread_index;
+        };
+
+        struct ThreadBufferEntry final {
+            kstd::u64 sink_id;
+            ThreadBuffer* buffer;
+            std::weak_ptr<ThreadBuffer> owner;// Expires with the sink, which frees the buffers
+        };
+
+        kstd::u64 _id;
+        kstd::usize _capacity;
+        mutable std::mutex _mutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+
+        [[nodiscard]] static auto next_id() noexcept -> kstd::u64 {
+            static std::atomic<kstd::u64> id {0};
+            return id.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        // The buffers of the thread are looked up by the id of their sink, which is never reused, so recording only
+        // takes the lock once per thread. Entries of destroyed sinks are never matched and dropped with the next
+        // registration. Returns nullptr if the buffer can't be allocated, the call is not recorded then.
+        [[nodiscard]] auto thread_buffer() noexcept -> ThreadBuffer* {
+            thread_local std::vector<ThreadBufferEntry> thread_buffers {};
+            for(const auto& entry : thread_buffers) {
+                if(entry.sink_id == _id) {
+                    return entry.buffer;
+                }
+            }
+
+            try {
+                thread_buffers.erase(std::remove_if(thread_buffers.begin(), thread_buffers.end(),
+                                                    [](const ThreadBufferEntry& entry) {
+                                                        return entry.owner.expired();
+                                                    }),
+                                     thread_buffers.end());
+                thread_buffers.reserve(thread_buffers.size() + 1);
+
+                auto buffer = std::make_shared<ThreadBuffer>();
+                buffer->slots = std::make_unique<Slot[]>(_capacity);// NOLINT
+                buffer->head = 0;
+                buffer->pending_start = 0;
+                const std::lock_guard<std::mutex> lock {_mutex};
+                buffer->thread_index = static_cast<kstd::u32>(_buffers.size());
+                _buffers.push_back(buffer);
+                thread_buffers.push_back({_id, buffer.get(), buffer});
+                return buffer.get();
+            }
+            catch(const std::exception&) {
+                return nullptr;
+            }
+        }
+
+        public:
+        /**
+         * Creates the sink with the capacity of the ring buffer per thread, which is rounded up to a power of two.
+         */
+        explicit RingBufferTraceSink(const kstd::usize capacity = 4096) :
+                _id {next_id()},
+                _capacity {1} {
+            while(_capacity < capacity) {
+                _capacity <<= 1;
+            }
+        }
+
+        RingBufferTraceSink(const RingBufferTraceSink& other) = delete;
+        RingBufferTraceSink(RingBufferTraceSink&& other) = delete;
+        ~RingBufferTraceSink() noexcept final = default;
+
+        auto begin(const TraceEvent event, const SocketHandle socket_handle, const kstd::u64 timestamp) noexcept
+                -> void final {
+            static_cast<void>(event);
+            static_cast<void>(socket_handle);
+            if(auto* buffer = thread_buffer(); buffer != nullptr) {
+                buffer->pending_start = timestamp;
+            }
+        }
+
+        auto end(const TraceEvent event, const SocketHandle socket_handle, const kstd::u64 timestamp,
+                 const kstd::i64 result) noexcept -> void final {
+            auto* buffer = thread_buffer();
+            if(buffer == nullptr) {
+                return;
+            }
+            const auto head = buffer->head.load(std::memory_order_relaxed);
+            auto& slot = buffer->slots[head & (_capacity - 1)];
+            slot.start.store(buffer->pending_start, std::memory_order_relaxed);
+            slot.end.store(timestamp, std::memory_order_relaxed);
+            slot.socket_handle.store(static_cast<kstd::i64>(socket_handle), std::memory_order_relaxed);
+            slot.result.store(result, std::memory_order_relaxed);
+            slot.event.store(event, std::memory_order_relaxed);
+            buffer->head.store(head + 1, std::memory_order_release);
+        }
+
+        /**
+         * Copies the records of all threads, the ones of a thread are ordered by their end.
+         */
+        [[nodiscard]] auto records() const -> std::vector<TraceRecord> {
+            const std::lock_guard<std::mutex> lock {_mutex};
+            std::vector<TraceRecord> records {};
+            for(const auto& buffer : _buffers) {
+                const auto head = buffer->head.load(std::memory_order_acquire);
+                const auto first = head > _capacity ? head - _capacity : 0;
+                const auto thread_records_start = records.size();
+                for(auto index = first; index < head; ++index) {
+                    const auto& slot = buffer->slots[index & (_capacity - 1)];
+                    records.push_back({slot.event.load(std::memory_order_relaxed), buffer->thread_index,
+                                       slot.socket_handle.load(std::memory_order_relaxed),
+                                       slot.start.load(std::memory_order_relaxed),
+                                       slot.end.load(std::memory_order_relaxed),
+                                       slot.result.load(std::memory_order_relaxed)});
+                }
+
+                // The writer may have lapped the reader in the meantime
+                std::atomic_thread_fence(std::memory_order_acquire);
+                const auto new_head = buffer->head.load(std::memory_order_relaxed);
+                const auto valid_first = new_head > _capacity ? new_head - _capacity : 0;
+                if(valid_first > first) {
+                    const auto overwritten_count = static_cast<std::ptrdiff_t>(std::min(valid_first, head) - first);
+                    const auto thread_records = records.begin() + static_cast<std::ptrdiff_t>(thread_records_start);
+                    records.erase(thread_records, thread_records + overwritten_count);
+                }
+            }
+            return records;
+        }
+
+        /**
+         * Writes the records as Chrome trace event JSON, which chrome://tracing and Perfetto open. Every call is a
+         * complete event on the track of its thread with the socket handle and the result as arguments.
+         */
+        auto write_chrome_trace(std::ostream& stream) const -> void {
+            stream << R"({"displayTimeUnit":"ns","traceEvents":[)";
+            bool first = true;
+            for(const auto& record : records()) {
+                const auto duration = record.end - record.start;
+                stream << fmt::format(R"({}{{"name":"{}","cat":"sockslib","ph":"X","ts":{}.{:03},"dur":{}.{:03},)"
+                                      R"("pid":0,"tid":{},"args":{{"fd":{},"result":{}}}}})",
+                                      first ? "" : ",", to_string(record.event), record.start / 1000,
+                                      record.start % 1000, duration / 1000, duration % 1000, record.thread_index,
+                                      record.socket_handle, record.result);
+                first = false;
+            }
+            stream << "]}";
+        }
+    };
+}// namespace sockslib
@@ -1,8 +1,13 @@
 #pragma once
+#include <array>
+#include <chrono>
+#include <limits>
 #include <string>
+#include <string_view>
+#include <kstd/types.hpp>
 #include <kstd/result.hpp>
+#include <kstd/option.hpp>
 #include <fmt/format.h>
-#include <regex>
 
 #ifdef PLATFORM_WINDOWS
 #define NOMINMAX
@@ -14,6 +19,12 @@
 namespace sockslib {
     [[nodiscard]] auto get_last_error() noexcept -> std::string;
 
+    /**
+     * Error code of the last failed socket call (errno or WSAGetLastError), which is formatted with format_error.
+     */
+    [[nodiscard]] auto get_last_error_code() noexcept -> kstd::i32;
+    [[nodiscard]] auto format_error(kstd::i32 error_code) noexcept -> std::string;
+
 #ifdef PLATFORM_WINDOWS
     using SocketHandle = SOCKET;
     static kstd::atomic_usize _wsa_user_count = 0;// NOLINT
@@ -53,15 +64,267 @@ namespace sockslib {
     }
 #endif
 
-    inline auto is_domain(const std::string& address) noexcept -> bool {
-        return address == "localhost" || std::regex_match(address, std::regex(R"(\b((?=[a-z0-9-]{1,63}\.)[a-z0-9]+(-[a-z0-9]+)*\.)+[a-z]{2,63}\b)"));
+    /**
+     * Point in time, after which a blocking operation gives up with a timed out error.
+     */
+    using Deadline = std::chrono::steady_clock::time_point;
+
+    /**
+     * Remaining time until the deadline as poll timeout in milliseconds. It's rounded up, so the deadline has passed
+     * once the poll times out. The maximal deadline waits forever (-1).
+     */
+    [[nodiscard]] inline auto poll_timeout(const Deadline deadline) noexcept -> int {
+        if(deadline == Deadline::max()) {
+            return -1;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if(deadline <= now) {
+            return 0;
+        }
+        const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count();
+        return remaining > std::numeric_limits<int>::max() ? std::numeric_limits<int>::max()
+                                                            : static_cast<int>(remaining);
+    }
+
+    struct IPv4Address {
+        std::array<kstd::u8, 4> octets;// Network byte order
+    };
+
+    struct IPv6Address {
+        std::array<kstd::u8, 16> octets;// Network byte order
+        std::string_view zone;          // Scope after the '%', empty if not specified
+    };
+
+    namespace detail {
+        [[nodiscard]] constexpr auto is_digit(const char character) noexcept -> bool {
+            return character >= '0' && character <= '9';
+        }
+
+        [[nodiscard]] constexpr auto is_alpha(const char character) noexcept -> bool {
+            return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z');
+        }
+
+        [[nodiscard]] constexpr auto hex_value(const char character) noexcept -> kstd::i32 {
+            if(is_digit(character)) {
+                return character - '0';
+            }
+            if(character >= 'a' && character <= 'f') {
+                return character - 'a' + 10;
+            }
+            if(character >= 'A' && character <= 'F') {
+                return character - 'A' + 10;
+            }
+            return -1;
+        }
+    }// namespace detail
+
+    /**
+     * Parses a dotted-quad IPv4 literal (like inet_pton, without leading zeros) in a single pass without allocating.
+     */
+    [[nodiscard]] constexpr auto parse_ipv4_address(const std::string_view address) noexcept
+            -> kstd::Option<IPv4Address> {
+        IPv4Address result {};
+        kstd::usize position = 0;
+        for(kstd::usize octet_index = 0; octet_index < result.octets.size(); ++octet_index) {
+            if(octet_index > 0) {
+                if(position >= address.size() || address[position] != '.') {
+                    return {};
+                }
+                ++position;
+            }
+
+            const auto octet_start = position;
+            kstd::u32 value = 0;
+            while(position < address.size() && detail::is_digit(address[position])) {
+                value = value * 10 + static_cast<kstd::u32>(address[position] - '0');
+                if(++position - octet_start > 3) {
+                    return {};
+                }
+            }
+
+            const auto digits = position - octet_start;
+            if(digits == 0 || value > 255 || (digits > 1 && address[octet_start] == '0')) {
+                return {};
+            }
+            result.octets[octet_index] = static_cast<kstd::u8>(value);
+        }
+
+        if(position != address.size()) {
+            return {};
+        }
+        return {result};
+    }
+
+    /**
+     * Parses an IPv6 literal (RFC 4291 text form, with optional embedded IPv4 tail and %zone) in a single pass without
+     * allocating. The zone of the result points into the specified string.
+     */
+    [[nodiscard]] constexpr auto parse_ipv6_address(std::string_view address) noexcept -> kstd::Option<IPv6Address> {
+        constexpr auto no_gap = std::string_view::npos;
+        IPv6Address result {};
+
+        // Split off and validate the zone
+        if(const auto zone_position = address.find('%'); zone_position != std::string_view::npos) {
+            result.zone = address.substr(zone_position + 1);
+            if(result.zone.empty()) {
+                return {};
+            }
+            for(const auto character : result.zone) {
+                if(!detail::is_digit(character) && !detail::is_alpha(character) && character != '-' &&
+                   character != '_' && character != '.') {
+                    return {};
+                }
+            }
+            address = address.substr(0, zone_position);
+        }
+
+        if(address.size() < 2) {
+            return {};
+        }
+
+        // A leading colon is only valid as the start of '::'
+        kstd::usize position = 0;
+        if(address[0] == ':') {
+            if(address[1] != ':') {
+                return {};
+            }
+            position = 1;
+        }
+
+        auto& octets = result.octets;
+        kstd::usize octet_count = 0;
+        kstd::usize gap_position = no_gap;
+        kstd::usize group_start = position;
+        kstd::usize digits = 0;
+        kstd::u32 value = 0;
+        while(position < address.size()) {
+            const auto character = address[position++];
+            if(const auto nibble = detail::hex_value(character); nibble >= 0) {
+                if(++digits > 4) {
+                    return {};
+                }
+                value = (value << 4U) | static_cast<kstd::u32>(nibble);
+                continue;
+            }
+
+            if(character == ':') {
+                group_start = position;
+                if(digits == 0) {
+                    if(gap_position != no_gap) {
+                        return {};
+                    }
+                    gap_position = octet_count;
+                    continue;
+                }
+                if(position >= address.size() || octet_count + 2 > octets.size()) {
+                    return {};
+                }
+                octets[octet_count++] = static_cast<kstd::u8>(value >> 8U);
+                octets[octet_count++] = static_cast<kstd::u8>(value & 0xFFU);
+                digits = 0;
+                value = 0;
+                continue;
+            }
+
+            // Embedded IPv4 address, which is only valid as the last four octets
+            if(character == '.' && octet_count + 4 <= octets.size()) {
+                const auto ipv4_address = parse_ipv4_address(address.substr(group_start));
+                if(!ipv4_address) {
+                    return {};
+                }
+                for(const auto octet : ipv4_address.get().octets) {
+                    octets[octet_count++] = octet;
+                }
+                digits = 0;
+                break;
+            }
+            return {};
+        }
+
+        if(digits > 0) {
+            if(octet_count + 2 > octets.size()) {
+                return {};
+            }
+            octets[octet_count++] = static_cast<kstd::u8>(value >> 8U);
+            octets[octet_count++] = static_cast<kstd::u8>(value & 0xFFU);
+        }
+
+        // Expand the '::' by moving the tail to the end and zeroing the gap
+        if(gap_position != no_gap) {
+            if(octet_count == octets.size()) {
+                return {};
+            }
+            const auto tail_size = octet_count - gap_position;
+            for(kstd::usize i = 1; i <= tail_size; ++i) {
+                octets[octets.size() - i] = octets[octet_count - i];
+                octets[octet_count - i] = 0;
+            }
+            octet_count = octets.size();
+        }
+
+        if(octet_count != octets.size()) {
+            return {};
+        }
+        return {result};
+    }
+
+    /**
+     * Checks for 'localhost' or a dot-separated host name of LDH labels (max. 63 characters each) ending in an
+     * alphabetic top-level label with at least two characters.
+     */
+    [[nodiscard]] constexpr auto is_domain(const std::string_view address) noexcept -> bool {
+        if(address == "localhost") {
+            return true;
+        }
+
+        if(address.empty() || address.size() > 253) {
+            return false;
+        }
+
+        kstd::usize label_count = 0;
+        kstd::usize label_length = 0;
+        bool label_alphabetic = true;
+        char previous = '.';
+        for(const auto character : address) {
+            if(character == '.') {
+                if(label_length == 0 || previous == '-') {
+                    return false;
+                }
+                ++label_count;
+                label_length = 0;
+                label_alphabetic = true;
+                previous = character;
+                continue;
+            }
+
+            if(character == '-') {
+                if(label_length == 0) {
+                    return false;
+                }
+                label_alphabetic = false;
+            }
+            else if(detail::is_digit(character)) {
+                label_alphabetic = false;
+            }
+            else if(!detail::is_alpha(character)) {
+                return false;
+            }
+
+            if(++label_length > 63) {
+                return false;
+            }
+            previous = character;
+        }
+
+        return label_count > 0 && label_length >= 2 && label_alphabetic;
     }
 
-    inline auto is_ipv4_address(const std::string& address) noexcept -> bool {
-        return std::regex_match(address, std::regex(R"(([0-9]{1,3})\.([0-9]{1,3})\.([0-9]{1,3})\.([0-9]{1,3}))"));
+    [[nodiscard]] constexpr auto is_ipv4_address(const std::string_view address) noexcept -> bool {
+        return !parse_ipv4_address(address).is_empty();
     }
 
-    inline auto is_ipv6_address(const std::string& address) noexcept -> bool {
-        return std::regex_match(address, std::regex("(([0-9a-fA-F]{1,4}:){7,7}[0-9a-fA-F]{1,4}|([0-9a-fA-F]{1,4}:){1,7}:|([0-9a-fA-F]{1,4}:){1,6}:[0-9a-fA-F]{1,4}|([0-9a-fA-F]{1,4}:){1,5}(:[0-9a-fA-F]{1,4}){1,2}|([0-9a-fA-F]{1,4}:){1,4}(:[0-9a-fA-F]{1,4}){1,3}|([0-9a-fA-F]{1,4}:){1,3}(:[0-9a-fA-F]{1,4}){1,4}|([0-9a-fA-F]{1,4}:){1,2}(:[0-9a-fA-F]{1,4}){1,5}|[0-9a-fA-F]{1,4}:((:[0-9a-fA-F]{1,4}){1,6})|:((:[0-9a-fA-F]{1,4}){1,7}|:)|fe80:(:[0-9a-fA-F]{0,4}){0,4}%[0-9a-zA-Z]{1,}|::(ffff(:0{1,4}){0,1}:){0,1}((25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])\\.){3,3}(25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])|([0-9a-fA-F]{1,4}:){1,4}:((25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])\\.){3,3}(25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9]))"));
+    [[nodiscard]] constexpr auto is_ipv6_address(const std::string_view address) noexcept -> bool {
+        return !parse_ipv6_address(address).is_empty();
     }
 }
\ No newline at end of file
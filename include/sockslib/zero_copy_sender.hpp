@@ -0,0 +1,76 @@
+#pragma once
+#ifdef PLATFORM_LINUX
+#include <kstd/types.hpp>
+#include <kstd/result.hpp>
+#include <deque>
+#include <functional>
+#include "sockslib/socket.hpp"
+
+namespace sockslib {
+    /**
+     * Invoked once per completed send with its user data. Copied signals that the kernel had to copy the buffer
+     * anyway (e.g. over loopback or when the device lacks scatter/gather support), so zero-copy gained nothing.
+     */
+    using ZeroCopyCallback = std::function<void(kstd::u64 user_data, bool copied)>;
+
+    /**
+     * Transmits buffers of a TCP socket with MSG_ZEROCOPY (Linux 4.14+). The kernel pins the pages of the buffer
+     * instead of copying them into the socket buffer, so a buffer must stay untouched until its completion was
+     * reported by reap or flush. Completions arrive on the error queue of the socket, which epoll reports as
+     * EventType::ERROR. Zero-copy only pays off for large buffers (~10KB and more) because of the page pinning and
+     * notification overhead.
+     */
+    class ZeroCopySender final {
+        struct PendingSend {
+            kstd::u64 user_data;
+            bool completed;
+        };
+
+        SocketHandle _socket_handle;
+        kstd::u32 _first_sequence;// Kernel sequence number of the first pending send
+        std::deque<PendingSend> _pending_sends;
+
+        public:
+        /**
+         * Enables SO_ZEROCOPY on the socket, which has to outlive the sender.
+         */
+        explicit ZeroCopySender(SocketHandle socket_handle);
+        ZeroCopySender(const ZeroCopySender& other) = delete;
+        ZeroCopySender(ZeroCopySender&& other) noexcept = default;
+        ~ZeroCopySender() noexcept = default;
+
+        [[nodiscard]] inline auto socket_handle() const noexcept -> SocketHandle {
+            return _socket_handle;
+        }
+
+        /**
+         * Count of sends, which were not reported as completed yet.
+         */
+        [[nodiscard]] inline auto pending_count() const noexcept -> kstd::usize {
+            return _pending_sends.size();
+        }
+
+        /**
+         * Sends the buffer like write and returns the count of sent bytes. The user data is reported once the kernel
+         * released the buffer, even if only a part of it was sent.
+         */
+        [[nodiscard]] auto send(const void* data, kstd::usize size, kstd::u64 user_data) noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+
+        /**
+         * Reports all completions queued on the socket without blocking and returns their count.
+         */
+        [[nodiscard]] auto reap(const ZeroCopyCallback& callback) noexcept -> kstd::Result<kstd::usize, SocketError>;
+
+        /**
+         * Waits until all pending sends completed, which requires the peer to acknowledge the data. Fails with
+         * ETIMEDOUT once the deadline passed, the remaining sends stay pending then.
+         */
+        [[nodiscard]] auto flush(const ZeroCopyCallback& callback, Deadline deadline = Deadline::max()) noexcept
+                -> kstd::Result<kstd::usize, SocketError>;
+
+        auto operator=(const ZeroCopySender& other) -> ZeroCopySender& = delete;
+        auto operator=(ZeroCopySender&& other) noexcept -> ZeroCopySender& = default;
+    };
+}// namespace sockslib
+#endif
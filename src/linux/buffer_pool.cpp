@@ -0,0 +1,203 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/buffer_pool.hpp"
+
+#include <sys/mman.h>
+#include <thread>
+
+namespace sockslib {
+    namespace {
+        constexpr kstd::usize cache_line_size = 64;
+        constexpr kstd::usize huge_page_size = 2 * 1024 * 1024;
+
+        [[nodiscard]] constexpr auto round_up(const kstd::usize value, const kstd::usize alignment) noexcept
+                -> kstd::usize {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        // Threads are numbered once, the number selects the freelist of the thread in every pool
+        [[nodiscard]] auto thread_index() noexcept -> kstd::usize {
+            static std::atomic<kstd::usize> next_thread_index {0};
+            thread_local const auto index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+            return index;
+        }
+
+        [[nodiscard]] auto map_arena(const kstd::usize size, const bool huge_pages) noexcept -> kstd::u8* {
+            // Explicit huge pages have to be reserved by the administrator, so this fails on most systems
+            if(huge_pages) {
+                auto* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                                    -1, 0);
+                if(memory != MAP_FAILED) {
+                    return static_cast<kstd::u8*>(memory);
+                }
+            }
+
+            auto* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if(memory == MAP_FAILED) {
+                return nullptr;
+            }
+            if(huge_pages) {
+                madvise(memory, size, MADV_HUGEPAGE);// Best effort, transparent huge pages may be disabled
+            }
+            return static_cast<kstd::u8*>(memory);
+        }
+    }// namespace
+
+    PooledBuffer::PooledBuffer(detail::BufferSlab* slab) noexcept :
+            _slab {slab} {
+    }
+
+    PooledBuffer::PooledBuffer() noexcept :
+            _slab {nullptr} {
+    }
+
+    PooledBuffer::PooledBuffer(const PooledBuffer& other) noexcept :
+            _slab {other._slab} {
+        if(_slab != nullptr) {
+            _slab->reference_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept :
+            _slab {other._slab} {
+        other._slab = nullptr;
+    }
+
+    PooledBuffer::~PooledBuffer() noexcept {
+        release();
+    }
+
+    auto PooledBuffer::release() noexcept -> void {
+        if(_slab != nullptr && _slab->reference_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            _slab->pool->release(_slab);
+        }
+        _slab = nullptr;
+    }
+
+    auto PooledBuffer::operator=(const PooledBuffer& other) noexcept -> PooledBuffer& {
+        if(this != &other) {
+            release();
+            _slab = other._slab;
+            if(_slab != nullptr) {
+                _slab->reference_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        return *this;
+    }
+
+    auto PooledBuffer::operator=(PooledBuffer&& other) noexcept -> PooledBuffer& {
+        if(this != &other) {
+            release();
+            _slab = other._slab;
+            other._slab = nullptr;
+        }
+        return *this;
+    }
+
+    BufferPool::BufferPool(const kstd::usize buffer_size, const kstd::usize max_buffers, const bool huge_pages) :
+            _buffer_size {round_up(std::max<kstd::usize>(buffer_size, 1), cache_line_size)},
+            _max_buffers {max_buffers},
+            _huge_pages {huge_pages},
+            _free_list_count {std::max<kstd::usize>(std::thread::hardware_concurrency(), 1)},
+            _free_lists {std::make_unique<FreeList[]>(_free_list_count)},// NOLINT
+            _buffer_count {0},
+            _used_count {0},
+            _memory_size {0} {
+    }
+
+    BufferPool::~BufferPool() noexcept {
+        for(const auto& arena : _arenas) {
+            munmap(arena.memory, arena.size);
+        }
+    }
+
+    auto BufferPool::local_free_list() const noexcept -> FreeList& {
+        return _free_lists[thread_index() % _free_list_count];
+    }
+
+    auto BufferPool::allocate() noexcept -> kstd::Option<PooledBuffer> {
+        auto& local_list = local_free_list();
+        detail::BufferSlab* slab = nullptr;
+        {
+            const std::lock_guard<std::mutex> lock {local_list.mutex};
+            slab = local_list.head;
+            if(slab != nullptr) {
+                local_list.head = slab->next;
+            }
+        }
+
+        // Buffers released by other threads are reused before the pool grows
+        for(kstd::usize i = 0; slab == nullptr && i < _free_list_count; ++i) {
+            auto& free_list = _free_lists[i];
+            const std::lock_guard<std::mutex> lock {free_list.mutex};
+            slab = free_list.head;
+            if(slab != nullptr) {
+                free_list.head = slab->next;
+            }
+        }
+
+        if(slab == nullptr) {
+            slab = add_arena(local_list);
+            if(slab == nullptr) {
+                return {};
+            }
+        }
+
+        slab->reference_count.store(1, std::memory_order_relaxed);
+        slab->size = 0;
+        slab->next = nullptr;
+        _used_count.fetch_add(1, std::memory_order_relaxed);
+        return {PooledBuffer {slab}};
+    }
+
+    auto BufferPool::add_arena(FreeList& free_list) noexcept -> detail::BufferSlab* {
+        const std::lock_guard<std::mutex> arena_lock {_arena_mutex};
+        auto slab_count = std::max<kstd::usize>(huge_page_size / _buffer_size, 1);
+        if(_max_buffers > 0) {
+            const auto buffer_count = _buffer_count.load(std::memory_order_relaxed);
+            if(buffer_count >= _max_buffers) {
+                return nullptr;
+            }
+            slab_count = std::min(slab_count, _max_buffers - buffer_count);
+        }
+
+        const auto arena_size = round_up(slab_count * _buffer_size, huge_page_size);
+        auto* memory = map_arena(arena_size, _huge_pages);
+        if(memory == nullptr) {
+            return nullptr;
+        }
+
+        Arena arena {memory, arena_size, std::make_unique<detail::BufferSlab[]>(slab_count)};// NOLINT
+        for(kstd::usize i = 0; i < slab_count; ++i) {
+            auto& slab = arena.slabs[i];
+            slab.reference_count.store(0, std::memory_order_relaxed);
+            slab.size = 0;
+            slab.capacity = static_cast<kstd::u32>(_buffer_size);
+            slab.pool = this;
+            slab.next = i + 1 < slab_count ? &arena.slabs[i + 1] : nullptr;
+            slab.data = memory + i * _buffer_size;
+        }
+
+        // The first slab is handed out right away, the others go into the freelist of the allocating thread
+        auto* first_slab = &arena.slabs[0];
+        if(slab_count > 1) {
+            const std::lock_guard<std::mutex> lock {free_list.mutex};
+            arena.slabs[slab_count - 1].next = free_list.head;
+            free_list.head = &arena.slabs[1];
+        }
+        _arenas.push_back(std::move(arena));
+        _buffer_count.fetch_add(slab_count, std::memory_order_relaxed);
+        _memory_size.fetch_add(arena_size, std::memory_order_relaxed);
+        return first_slab;
+    }
+
+    auto BufferPool::release(detail::BufferSlab* slab) noexcept -> void {
+        auto& free_list = local_free_list();
+        {
+            const std::lock_guard<std::mutex> lock {free_list.mutex};
+            slab->next = free_list.head;
+            free_list.head = slab;
+        }
+        _used_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+}// namespace sockslib
+#endif
@@ -0,0 +1,161 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/client_socket_pool.hpp"
+
+#include <algorithm>
+#include <fmt/format.h>
+#include <stdexcept>
+#include <vector>
+
+namespace sockslib {
+    PooledClientSocket::PooledClientSocket(ClientSocketPool* pool, std::string key, ClientSocket socket) noexcept :
+            _pool {pool},
+            _key {std::move(key)},
+            _socket {std::move(socket)},
+            _reusable {true} {
+    }
+
+    PooledClientSocket::PooledClientSocket(PooledClientSocket&& other) noexcept :
+            _pool {other._pool},
+            _key {std::move(other._key)},
+            _socket {std::move(other._socket)},
+            _reusable {other._reusable} {
+        other._pool = nullptr;
+    }
+
+    PooledClientSocket::~PooledClientSocket() noexcept {
+        if(_pool != nullptr) {
+            _pool->release(_key, std::move(_socket), _reusable);
+        }
+    }
+
+    ClientSocketPool::ClientSocketPool(const kstd::usize max_idle_per_endpoint,
+                                       const std::chrono::milliseconds idle_timeout,
+                                       const kstd::usize max_connections_per_endpoint,
+                                       const std::chrono::milliseconds lease_timeout) :
+            _max_idle_per_endpoint {max_idle_per_endpoint},
+            _max_connections_per_endpoint {max_connections_per_endpoint},
+            _idle_timeout {idle_timeout},
+            _lease_timeout {lease_timeout},
+            _metrics {} {
+    }
+
+    auto ClientSocketPool::lease(const std::string_view host, const kstd::u16 port, const ProtocolType protocol_type)
+            -> kstd::Result<PooledClientSocket> {
+        const auto start = std::chrono::steady_clock::now();
+        const auto deadline = start + _lease_timeout;
+        auto key = fmt::format("{}|{}|{}", host, port, static_cast<int>(protocol_type));
+
+        // Expired and stale connections are closed after releasing the lock, it's declared after them
+        std::vector<ClientSocket> closed_sockets {};
+        std::unique_lock<std::mutex> lock {_mutex};
+        auto& endpoint = _endpoints[key];
+        while(true) {
+            // Take the most recently released connection, which is the least likely one to be closed by the peer
+            while(!endpoint.idle_sockets.empty()) {
+                auto idle_socket = std::move(endpoint.idle_sockets.back());
+                endpoint.idle_sockets.pop_back();
+                if(std::chrono::steady_clock::now() - idle_socket.idle_since > _idle_timeout) {
+                    closed_sockets.push_back(std::move(idle_socket.socket));
+                    ++_metrics.eviction_count;
+                    continue;
+                }
+
+                // Would block means alive, EOF or unexpected data means the connection can't be reused
+                ++endpoint.leased_count;
+                lock.unlock();
+                kstd::u8 byte = 0;
+                const auto peek_result = idle_socket.socket.try_peek(&byte, sizeof(byte));
+                if(peek_result && peek_result.get().is_empty()) {
+                    record_lease(start, true);
+                    return PooledClientSocket {this, std::move(key), std::move(idle_socket.socket)};
+                }
+                lock.lock();
+                closed_sockets.push_back(std::move(idle_socket.socket));
+                --endpoint.leased_count;
+                ++_metrics.stale_count;
+            }
+
+            if(_max_connections_per_endpoint == 0 || endpoint.leased_count < _max_connections_per_endpoint) {
+                break;
+            }
+            if(_release_condition.wait_until(lock, deadline) == std::cv_status::timeout &&
+               endpoint.idle_sockets.empty() && endpoint.leased_count >= _max_connections_per_endpoint) {
+                return kstd::Error {fmt::format("Unable to lease socket => No connection to {}:{} was released in time",
+                                                host, port)};
+            }
+        }
+
+        // The connection is established without holding the lock, the slot is reserved already
+        ++endpoint.leased_count;
+        lock.unlock();
+        closed_sockets.clear();
+        auto socket_result = ClientSocket::create(std::string {host}, port, protocol_type, {}, deadline);
+        if(!socket_result) {
+            lock.lock();
+            --endpoint.leased_count;
+            lock.unlock();
+            _release_condition.notify_one();
+            return kstd::Error {socket_result.get_error().to_string()};
+        }
+        record_lease(start, false);
+        return PooledClientSocket {this, std::move(key), std::move(socket_result.get())};
+    }
+
+    auto ClientSocketPool::release(const std::string& key, ClientSocket socket, const bool reusable) noexcept -> void {
+        {
+            const std::lock_guard<std::mutex> lock {_mutex};
+            auto& endpoint = _endpoints[key];
+            --endpoint.leased_count;
+            if(reusable && endpoint.idle_sockets.size() < _max_idle_per_endpoint) {
+                endpoint.idle_sockets.push_back({std::move(socket), std::chrono::steady_clock::now()});
+            }
+            else if(reusable) {
+                ++_metrics.eviction_count;
+            }
+        }
+        _release_condition.notify_one();
+    }
+
+    auto ClientSocketPool::record_lease(const std::chrono::steady_clock::time_point start, const bool hit) noexcept
+            -> void {
+        const auto wait_time = std::chrono::steady_clock::now() - start;
+        const std::lock_guard<std::mutex> lock {_mutex};
+        ++_metrics.lease_count;
+        ++(hit ? _metrics.hit_count : _metrics.miss_count);
+        _metrics.total_wait_time += wait_time;
+        _metrics.max_wait_time = std::max<std::chrono::nanoseconds>(_metrics.max_wait_time, wait_time);
+    }
+
+    auto ClientSocketPool::evict_idle() noexcept -> kstd::usize {
+        // The sockets are closed after releasing the lock
+        std::vector<ClientSocket> expired_sockets {};
+        {
+            const std::lock_guard<std::mutex> lock {_mutex};
+            const auto now = std::chrono::steady_clock::now();
+            for(auto& [key, endpoint] : _endpoints) {
+                while(!endpoint.idle_sockets.empty() &&
+                      now - endpoint.idle_sockets.front().idle_since > _idle_timeout) {
+                    expired_sockets.push_back(std::move(endpoint.idle_sockets.front().socket));
+                    endpoint.idle_sockets.pop_front();
+                }
+            }
+            _metrics.eviction_count += expired_sockets.size();
+        }
+        return expired_sockets.size();
+    }
+
+    auto ClientSocketPool::idle_count() const noexcept -> kstd::usize {
+        const std::lock_guard<std::mutex> lock {_mutex};
+        kstd::usize idle_count = 0;
+        for(const auto& [key, endpoint] : _endpoints) {
+            idle_count += endpoint.idle_sockets.size();
+        }
+        return idle_count;
+    }
+
+    auto ClientSocketPool::metrics() const noexcept -> ClientSocketPoolMetrics {
+        const std::lock_guard<std::mutex> lock {_mutex};
+        return _metrics;
+    }
+}// namespace sockslib
+#endif
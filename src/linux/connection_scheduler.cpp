@@ -0,0 +1,325 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/connection_scheduler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <errno.h>
+#include <fmt/format.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+namespace sockslib {
+    namespace {
+        constexpr kstd::usize max_events_per_poll = 64;
+
+        // A busy worker moves new events into its run queue after this many handled connections, so other workers
+        // can steal them
+        constexpr kstd::usize poll_interval = 16;
+
+        constexpr kstd::u32 connection_events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    }// namespace
+
+    ConnectionScheduler::ConnectionScheduler(const kstd::usize worker_count, ScheduledHandler handler,
+                                             const bool work_stealing) :
+            _handler {std::move(handler)},
+            _work_stealing {work_stealing},
+            _worker_count {std::max<kstd::usize>(worker_count, 1)},
+            _workers {std::make_unique<Worker[]>(_worker_count)},// NOLINT
+            _running {false},
+            _stopped {false},
+            _next_worker {0} {
+        for(kstd::usize i = 0; i < _worker_count; ++i) {
+            auto& worker = _workers[i];
+            worker.epoll_handle = epoll_create1(EPOLL_CLOEXEC);
+            worker.wakeup_handle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+            // The wakeup event is registered without data pointer, which identifies it while polling
+            epoll_event event {};
+            event.events = EPOLLIN | EPOLLET;
+            event.data.ptr = nullptr;
+            if(worker.epoll_handle < 0 || worker.wakeup_handle < 0 ||
+               epoll_ctl(worker.epoll_handle, EPOLL_CTL_ADD, worker.wakeup_handle, &event) < 0) {
+                const auto error = get_last_error();
+                stop();
+                throw std::runtime_error {fmt::format("Unable to initialize connection scheduler => {}", error)};
+            }
+        }
+    }
+
+    ConnectionScheduler::~ConnectionScheduler() noexcept {
+        stop();
+    }
+
+    auto ConnectionScheduler::start() noexcept -> kstd::Result<void> {
+        using namespace std::string_literals;
+        if(_stopped.load()) {
+            return kstd::Error {"Unable to start connection scheduler => Scheduler is already stopped!"s};
+        }
+        if(_running.exchange(true)) {
+            return kstd::Error {"Unable to start connection scheduler => Scheduler is already started!"s};
+        }
+
+        const auto cpu_count = std::max(std::thread::hardware_concurrency(), 1U);
+        for(kstd::usize i = 0; i < _worker_count; ++i) {
+            try {
+                _workers[i].thread = std::thread {[this, i] {
+                    run_worker(i);
+                }};
+            }
+            catch(const std::system_error& error) {
+                stop();
+                return kstd::Error {fmt::format("Unable to start connection scheduler => {}", error.what())};
+            }
+
+            // Pinning is best effort, the kernel may restrict the CPUs of this process
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            CPU_SET(i % cpu_count, &cpu_set);
+            pthread_setaffinity_np(_workers[i].thread.native_handle(), sizeof(cpu_set), &cpu_set);
+        }
+        return {};
+    }
+
+    auto ConnectionScheduler::stop() noexcept -> void {
+        _stopped.store(true);
+        _running.store(false);
+        for(kstd::usize i = 0; i < _worker_count; ++i) {
+            if(_workers[i].wakeup_handle >= 0) {
+                eventfd_write(_workers[i].wakeup_handle, 1);
+            }
+        }
+        for(kstd::usize i = 0; i < _worker_count; ++i) {
+            if(_workers[i].thread.joinable()) {
+                _workers[i].thread.join();
+            }
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock {_connections_mutex};
+            _connections.clear();
+        }
+        for(kstd::usize i = 0; i < _worker_count; ++i) {
+            auto& worker = _workers[i];
+            worker.run_queue.clear();
+            if(worker.wakeup_handle >= 0) {
+                close(worker.wakeup_handle);
+                worker.wakeup_handle = -1;
+            }
+            if(worker.epoll_handle >= 0) {
+                close(worker.epoll_handle);
+                worker.epoll_handle = -1;
+            }
+        }
+    }
+
+    auto ConnectionScheduler::add(AcceptedSocket socket) noexcept -> kstd::Result<void> {
+        if(auto result = socket.set_blocking(false); !result) {
+            return kstd::Error {fmt::format("Unable to add connection to scheduler => {}", result.get_error())};
+        }
+        return register_connection(std::make_unique<ScheduledConnection>(
+                ScheduledConnection {std::move(socket), nullptr, 0}));
+    }
+
+    auto ConnectionScheduler::listen(const ServerSocket& server_socket) noexcept -> kstd::Result<void> {
+        if(auto result = server_socket.set_blocking(false); !result) {
+            return kstd::Error {fmt::format("Unable to add connection to scheduler => {}", result.get_error())};
+        }
+        return register_connection(std::make_unique<ScheduledConnection>(
+                ScheduledConnection {AcceptedSocket {invalid_socket_handle}, &server_socket, 0}));
+    }
+
+    auto ConnectionScheduler::connection_count() noexcept -> kstd::usize {
+        const std::lock_guard<std::mutex> lock {_connections_mutex};
+        return _connections.size();
+    }
+
+    auto ConnectionScheduler::register_connection(std::unique_ptr<ScheduledConnection> connection) noexcept
+            -> kstd::Result<void> {
+        auto* scheduled_connection = connection.get();
+        const auto owner_index = _next_worker.fetch_add(1, std::memory_order_relaxed) % _worker_count;
+        scheduled_connection->owner_index = owner_index;
+        const auto socket_handle = scheduled_connection->server_socket != nullptr
+                                           ? scheduled_connection->server_socket->socket_handle()
+                                           : scheduled_connection->socket.socket_handle();
+        {
+            const std::lock_guard<std::mutex> lock {_connections_mutex};
+            _connections.emplace(scheduled_connection, std::move(connection));
+        }
+
+        // A worker may pick the connection up right after this, so it's not touched anymore afterwards
+        epoll_event event {};
+        event.events = connection_events;
+        event.data.ptr = scheduled_connection;
+        if(epoll_ctl(_workers[owner_index].epoll_handle, EPOLL_CTL_ADD, socket_handle, &event) < 0) {
+            const auto error = get_last_error();
+            const std::lock_guard<std::mutex> lock {_connections_mutex};
+            _connections.erase(scheduled_connection);
+            return kstd::Error {fmt::format("Unable to add connection to scheduler => {}", error)};
+        }
+        return {};
+    }
+
+    auto ConnectionScheduler::release_connection(ScheduledConnection* connection) noexcept -> void {
+        const auto socket_handle = connection->server_socket != nullptr ? connection->server_socket->socket_handle()
+                                                                        : connection->socket.socket_handle();
+        epoll_ctl(_workers[connection->owner_index].epoll_handle, EPOLL_CTL_DEL, socket_handle, nullptr);
+        const std::lock_guard<std::mutex> lock {_connections_mutex};
+        _connections.erase(connection);
+    }
+
+    auto ConnectionScheduler::run_connection(const kstd::usize worker_index,
+                                             ScheduledConnection* connection) noexcept -> void {
+        SocketHandle socket_handle = invalid_socket_handle;
+        if(connection->server_socket != nullptr) {
+            socket_handle = connection->server_socket->socket_handle();
+            while(true) {
+                auto accept_result = connection->server_socket->try_accept();
+                if(!accept_result && accept_result.get_error().connection_reset()) {
+                    continue;// The peer gave up while the connection was queued
+                }
+                if(!accept_result || accept_result.get().is_empty()) {
+                    break;
+                }
+                static_cast<void>(add(std::move(accept_result.get().get())));
+            }
+        }
+        else {
+            socket_handle = connection->socket.socket_handle();
+            _workers[worker_index].handled_count.fetch_add(1, std::memory_order_relaxed);
+            if(!_handler(worker_index, connection->socket)) {
+                release_connection(connection);
+                return;
+            }
+        }
+
+        // Rearm the one-shot registration, the connection is reported again if data is left or new data arrives
+        epoll_event event {};
+        event.events = connection_events;
+        event.data.ptr = connection;
+        if(epoll_ctl(_workers[connection->owner_index].epoll_handle, EPOLL_CTL_MOD, socket_handle, &event) < 0) {
+            release_connection(connection);
+        }
+    }
+
+    auto ConnectionScheduler::poll_worker(const kstd::usize worker_index, const int timeout_ms) noexcept
+            -> kstd::usize {
+        auto& worker = _workers[worker_index];
+        std::array<epoll_event, max_events_per_poll> events {};
+        const auto event_count = epoll_wait(worker.epoll_handle, events.data(), events.size(), timeout_ms);
+        if(event_count <= 0) {
+            return 0;
+        }
+
+        kstd::usize queued_count = 0;
+        {
+            const std::lock_guard<std::mutex> lock {worker.queue_mutex};
+            for(int i = 0; i < event_count; ++i) {
+                auto* connection = static_cast<ScheduledConnection*>(events[i].data.ptr);
+                if(connection == nullptr) {
+                    eventfd_t value = 0;
+                    eventfd_read(worker.wakeup_handle, &value);
+                    continue;
+                }
+                worker.run_queue.push_back(connection);
+                ++queued_count;
+            }
+        }
+
+        // This worker only runs one connection at a time, the others are left for a sleeping worker to steal
+        if(_work_stealing && queued_count > 1) {
+            wake_sleeping_worker(worker_index);
+        }
+        return queued_count;
+    }
+
+    auto ConnectionScheduler::steal(const kstd::usize worker_index) noexcept -> bool {
+        std::vector<ScheduledConnection*> stolen_connections {};
+        for(kstd::usize offset = 1; offset < _worker_count && stolen_connections.empty(); ++offset) {
+            auto& victim = _workers[(worker_index + offset) % _worker_count];
+            const std::lock_guard<std::mutex> lock {victim.queue_mutex};
+
+            // Half of the queue (rounded up) is taken from the back, the victim continues at the front
+            const auto steal_count = (victim.run_queue.size() + 1) / 2;
+            for(kstd::usize i = 0; i < steal_count; ++i) {
+                stolen_connections.push_back(victim.run_queue.back());
+                victim.run_queue.pop_back();
+            }
+        }
+        if(stolen_connections.empty()) {
+            return false;
+        }
+
+        auto& worker = _workers[worker_index];
+        {
+            const std::lock_guard<std::mutex> lock {worker.queue_mutex};
+            worker.run_queue.insert(worker.run_queue.end(), stolen_connections.rbegin(), stolen_connections.rend());
+        }
+        worker.stolen_count.fetch_add(stolen_connections.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    auto ConnectionScheduler::has_queued_work() noexcept -> bool {
+        for(kstd::usize i = 0; i < _worker_count; ++i) {
+            const std::lock_guard<std::mutex> lock {_workers[i].queue_mutex};
+            if(!_workers[i].run_queue.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    auto ConnectionScheduler::wake_sleeping_worker(const kstd::usize worker_index) noexcept -> void {
+        for(kstd::usize offset = 1; offset < _worker_count; ++offset) {
+            auto& worker = _workers[(worker_index + offset) % _worker_count];
+            if(worker.sleeping.exchange(false)) {
+                eventfd_write(worker.wakeup_handle, 1);
+                return;
+            }
+        }
+    }
+
+    auto ConnectionScheduler::run_worker(const kstd::usize worker_index) noexcept -> void {
+        auto& worker = _workers[worker_index];
+        kstd::usize handled_since_poll = 0;
+        while(_running.load()) {
+            ScheduledConnection* connection = nullptr;
+            {
+                const std::lock_guard<std::mutex> lock {worker.queue_mutex};
+                if(!worker.run_queue.empty()) {
+                    connection = worker.run_queue.front();
+                    worker.run_queue.pop_front();
+                }
+            }
+
+            if(connection != nullptr) {
+                run_connection(worker_index, connection);
+                if(++handled_since_poll >= poll_interval) {
+                    handled_since_poll = 0;
+                    poll_worker(worker_index, 0);
+                }
+                continue;
+            }
+
+            handled_since_poll = 0;
+            if(poll_worker(worker_index, 0) > 0 || (_work_stealing && steal(worker_index))) {
+                continue;
+            }
+
+            // Queues filled after announcing the sleep are seen by the check below or wake this worker up
+            worker.sleeping.store(true);
+            if(_work_stealing && has_queued_work()) {
+                worker.sleeping.store(false);
+                continue;
+            }
+            poll_worker(worker_index, -1);
+            worker.sleeping.store(false);
+        }
+    }
+}// namespace sockslib
+#endif
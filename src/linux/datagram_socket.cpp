@@ -0,0 +1,290 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/datagram_socket.hpp"
+
+#include <array>
+#include <errno.h>
+#include <fmt/format.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace sockslib {
+    DatagramBatch::DatagramBatch(const kstd::usize capacity, const kstd::usize max_datagram_size) :
+            _max_datagram_size {max_datagram_size},
+            _size {0},
+            _buffer(capacity * max_datagram_size),
+            _addresses(capacity),
+            _iovecs(capacity),
+            _headers(capacity) {
+        // The headers point into the vectors, which keep their storage when the batch is moved
+        for(kstd::usize i = 0; i < capacity; ++i) {
+            _iovecs[i].iov_base = _buffer.data() + i * max_datagram_size;
+            _iovecs[i].iov_len = 0;
+            _headers[i].msg_hdr.msg_iov = &_iovecs[i];
+            _headers[i].msg_hdr.msg_iovlen = 1;
+        }
+    }
+
+    auto DatagramBatch::push(const void* data, const kstd::usize size, const SocketAddress& address) noexcept
+            -> bool {
+        if(_size == capacity() || size > _max_datagram_size) {
+            return false;
+        }
+
+        std::memcpy(_iovecs[_size].iov_base, data, size);
+        _iovecs[_size].iov_len = size;
+        _addresses[_size] = address;
+        ++_size;
+        return true;
+    }
+
+    auto DatagramBatch::clear() noexcept -> void {
+        _size = 0;
+    }
+
+    DatagramSocket::DatagramSocket(const AddressType address_type) :
+            _address_type {address_type} {
+        _socket_handle = socket(static_cast<int>(address_type), SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP);
+        if(!handle_valid(_socket_handle)) {
+            throw std::runtime_error {fmt::format("Unable to initialize socket => {}", get_last_error())};
+        }
+    }
+
+    DatagramSocket::DatagramSocket(const kstd::u16 port, const AddressType address_type) :
+            DatagramSocket(address_type) {
+        SocketAddress address {};
+        if(address_type == AddressType::IPV6) {
+            address = SocketAddress {IPv6Address {}, port};
+        }
+        else {
+            address = SocketAddress {IPv4Address {}, port};
+        }
+
+        // The delegated constructor already completed, so the destructor closes the socket when this throws
+        if(::bind(_socket_handle, address.data(), address.length()) < 0) {
+            throw std::runtime_error {fmt::format("Unable to bind socket => {}", get_last_error())};
+        }
+    }
+
+    DatagramSocket::DatagramSocket(DatagramSocket&& other) noexcept :
+            _address_type {other._address_type} {
+        _socket_handle = other._socket_handle;
+        _statistics = other._statistics;
+        other._socket_handle = invalid_socket_handle;
+    }
+
+    DatagramSocket::~DatagramSocket() noexcept {
+        if(handle_valid(_socket_handle)) {
+            close(_socket_handle);
+        }
+    }
+
+    auto DatagramSocket::local_address() const noexcept -> kstd::Result<SocketAddress> {
+        SocketAddress address {};
+        socklen_t length = SocketAddress::capacity();
+        if(getsockname(_socket_handle, address.data(), &length) < 0) {
+            return kstd::Error {fmt::format("Unable to get address of socket => {}", get_last_error())};
+        }
+        address.set_length(length);
+        return address;
+    }
+
+    auto DatagramSocket::send_to(const void* data, const kstd::usize size, const SocketAddress& address) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_sent = measure_io(_socket_handle, _statistics, IoOperation::WRITE, size, [&] {
+            return ::sendto(_socket_handle, data, size, 0, address.data(), address.length());
+        });
+        if(bytes_sent < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+        }
+        return static_cast<kstd::usize>(bytes_sent);
+    }
+
+    auto DatagramSocket::receive_from(kstd::u8* data, const kstd::usize size, SocketAddress& address) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        socklen_t length = SocketAddress::capacity();
+        const auto bytes_read = measure_io(_socket_handle, _statistics, IoOperation::READ, size, [&] {
+            return ::recvfrom(_socket_handle, data, size, 0, address.data(), &length);
+        });
+        if(bytes_read < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
+        }
+        address.set_length(length);
+        return static_cast<kstd::usize>(bytes_read);
+    }
+
+    auto DatagramSocket::try_send_to(const void* data, const kstd::usize size,
+                                     const SocketAddress& address) const noexcept
+            -> kstd::Result<kstd::Option<kstd::usize>, SocketError> {
+        const auto bytes_sent = measure_io(_socket_handle, _statistics, IoOperation::WRITE, size, [&] {
+            return ::sendto(_socket_handle, data, size, MSG_DONTWAIT, address.data(), address.length());
+        });
+        if(bytes_sent < 0) {
+            if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                return {kstd::Option<kstd::usize> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+        }
+        return {kstd::Option<kstd::usize> {static_cast<kstd::usize>(bytes_sent)}};
+    }
+
+    auto DatagramSocket::try_receive_from(kstd::u8* data, const kstd::usize size,
+                                          SocketAddress& address) const noexcept
+            -> kstd::Result<kstd::Option<kstd::usize>, SocketError> {
+        socklen_t length = SocketAddress::capacity();
+        const auto bytes_read = measure_io(_socket_handle, _statistics, IoOperation::READ, size, [&] {
+            return ::recvfrom(_socket_handle, data, size, MSG_DONTWAIT, address.data(), &length);
+        });
+        if(bytes_read < 0) {
+            if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                return {kstd::Option<kstd::usize> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
+        }
+        address.set_length(length);
+        return {kstd::Option<kstd::usize> {static_cast<kstd::usize>(bytes_read)}};
+    }
+
+    auto DatagramSocket::send_batch(DatagramBatch& batch) const noexcept -> kstd::Result<kstd::usize, SocketError> {
+        for(kstd::usize i = 0; i < batch._size; ++i) {
+            auto& header = batch._headers[i].msg_hdr;
+            auto& address = batch._addresses[i];
+            header.msg_name = address.is_empty() ? nullptr : address.data();
+            header.msg_namelen = address.length();
+            header.msg_control = nullptr;
+            header.msg_controllen = 0;
+            header.msg_flags = 0;
+        }
+
+        // The kernel may stop early, e.g. when the socket buffer is full, so the rest is sent with further calls
+        kstd::usize datagrams_sent = 0;
+        while(datagrams_sent < batch._size) {
+            const auto result = ::sendmmsg(_socket_handle, batch._headers.data() + datagrams_sent,
+                                           static_cast<unsigned int>(batch._size - datagrams_sent), 0);
+            if(result < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+            }
+            datagrams_sent += static_cast<kstd::usize>(result);
+        }
+        return datagrams_sent;
+    }
+
+    auto DatagramSocket::receive_batch(DatagramBatch& batch) const noexcept -> kstd::Result<kstd::usize, SocketError> {
+        for(kstd::usize i = 0; i < batch.capacity(); ++i) {
+            auto& header = batch._headers[i].msg_hdr;
+            batch._iovecs[i].iov_len = batch._max_datagram_size;
+            header.msg_name = batch._addresses[i].data();
+            header.msg_namelen = SocketAddress::capacity();
+            header.msg_control = nullptr;
+            header.msg_controllen = 0;
+            header.msg_flags = 0;
+        }
+
+        batch._size = 0;
+        const auto result = ::recvmmsg(_socket_handle, batch._headers.data(),
+                                       static_cast<unsigned int>(batch.capacity()), MSG_WAITFORONE, nullptr);
+        if(result < 0) {
+            if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                return batch._size;
+            }
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
+        }
+
+        batch._size = static_cast<kstd::usize>(result);
+        for(kstd::usize i = 0; i < batch._size; ++i) {
+            batch._iovecs[i].iov_len = batch._headers[i].msg_len;
+            batch._addresses[i].set_length(batch._headers[i].msg_hdr.msg_namelen);
+        }
+        return batch._size;
+    }
+
+    auto DatagramSocket::send_segmented(const void* data, const kstd::usize size, const kstd::u16 segment_size,
+                                        const SocketAddress& address) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        iovec buffer {const_cast<void*>(data), size};// NOLINT
+        msghdr message {};
+        message.msg_name = const_cast<sockaddr*>(address.data());// NOLINT
+        message.msg_namelen = address.length();
+        message.msg_iov = &buffer;
+        message.msg_iovlen = 1;
+
+        // A buffer which fits into one segment is sent as a regular datagram
+        alignas(cmsghdr) std::array<kstd::u8, CMSG_SPACE(sizeof(kstd::u16))> control {};
+        if(size > segment_size) {
+            message.msg_control = control.data();
+            message.msg_controllen = control.size();
+            auto* control_message = CMSG_FIRSTHDR(&message);
+            control_message->cmsg_level = SOL_UDP;
+            control_message->cmsg_type = UDP_SEGMENT;
+            control_message->cmsg_len = CMSG_LEN(sizeof(kstd::u16));
+            std::memcpy(CMSG_DATA(control_message), &segment_size, sizeof(segment_size));
+        }
+
+        const auto bytes_sent = measure_io(_socket_handle, _statistics, IoOperation::WRITE, size, [&] {
+            return ::sendmsg(_socket_handle, &message, 0);
+        });
+        if(bytes_sent < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+        }
+        return static_cast<kstd::usize>(bytes_sent);
+    }
+
+    auto DatagramSocket::set_receive_offload(const bool enabled) const noexcept -> kstd::Result<void, SocketError> {
+        const int value = enabled ? 1 : 0;
+        if(setsockopt(_socket_handle, SOL_UDP, UDP_GRO, &value, sizeof(value)) < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+        }
+        return {};
+    }
+
+    auto DatagramSocket::receive_coalesced(kstd::u8* data, const kstd::usize size,
+                                           SocketAddress& address) const noexcept
+            -> kstd::Result<DatagramSegments, SocketError> {
+        iovec buffer {data, size};
+        alignas(cmsghdr) std::array<kstd::u8, CMSG_SPACE(sizeof(int))> control {};
+        msghdr message {};
+        message.msg_name = address.data();
+        message.msg_namelen = SocketAddress::capacity();
+        message.msg_iov = &buffer;
+        message.msg_iovlen = 1;
+        message.msg_control = control.data();
+        message.msg_controllen = control.size();
+
+        const auto bytes_read = measure_io(_socket_handle, _statistics, IoOperation::READ, size, [&] {
+            return ::recvmsg(_socket_handle, &message, 0);
+        });
+        if(bytes_read < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
+        }
+        address.set_length(message.msg_namelen);
+
+        // The segment size is only attached if the kernel coalesced multiple datagrams
+        int segment_size = 0;
+        for(auto* control_message = CMSG_FIRSTHDR(&message); control_message != nullptr;
+            control_message = CMSG_NXTHDR(&message, control_message)) {
+            if(control_message->cmsg_level == SOL_UDP && control_message->cmsg_type == UDP_GRO) {
+                std::memcpy(&segment_size, CMSG_DATA(control_message), sizeof(segment_size));
+            }
+        }
+        return DatagramSegments {data, static_cast<kstd::usize>(bytes_read), static_cast<kstd::usize>(segment_size)};
+    }
+
+    auto DatagramSocket::operator=(DatagramSocket&& other) noexcept -> DatagramSocket& {
+        if(handle_valid(_socket_handle)) {
+            close(_socket_handle);
+        }
+        _socket_handle = other._socket_handle;
+        _statistics = other._statistics;
+        _address_type = other._address_type;
+        other._socket_handle = invalid_socket_handle;
+        return *this;
+    }
+}// namespace sockslib
+#endif
@@ -0,0 +1,495 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/dns_resolver.hpp"
+
+#include <kstd/option.hpp>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <errno.h>
+#include <cstring>
+#include <fmt/format.h>
+#include <netdb.h>
+#include <poll.h>
+#include <random>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace sockslib {
+    namespace {
+        constexpr kstd::u16 record_type_a = 1;
+        constexpr kstd::u16 record_type_soa = 6;
+        constexpr kstd::u16 record_type_aaaa = 28;
+        constexpr kstd::u16 record_class_in = 1;
+        constexpr kstd::u8 response_code_no_error = 0;
+        constexpr kstd::u8 response_code_name_error = 3;
+        constexpr kstd::usize header_size = 12;
+        constexpr kstd::usize max_message_size = 4096;
+        constexpr kstd::u32 default_negative_ttl = 30;
+        constexpr kstd::u32 system_ttl = 30;
+        constexpr kstd::u32 max_ttl = 24 * 60 * 60;
+        constexpr kstd::usize cache_purge_threshold = 1024;
+
+        struct Answer {
+            bool answered;
+            kstd::u8 response_code;
+            std::vector<SocketAddress> addresses;
+            kstd::u32 ttl;
+            kstd::u32 negative_ttl;
+        };
+
+        [[nodiscard]] auto normalize_host(std::string_view host) -> std::string {
+            if(!host.empty() && host.back() == '.') {
+                host.remove_suffix(1);
+            }
+
+            std::string normalized_host {host};
+            std::transform(normalized_host.begin(), normalized_host.end(), normalized_host.begin(),
+                           [](const unsigned char character) {
+                               return static_cast<char>(std::tolower(character));
+                           });
+            return normalized_host;
+        }
+
+        [[nodiscard]] inline auto read_u16(const kstd::u8* data) noexcept -> kstd::u16 {
+            return static_cast<kstd::u16>((data[0] << 8) | data[1]);
+        }
+
+        [[nodiscard]] inline auto read_u32(const kstd::u8* data) noexcept -> kstd::u32 {
+            return (static_cast<kstd::u32>(read_u16(data)) << 16) | read_u16(data + 2);
+        }
+
+        inline auto write_u16(std::vector<kstd::u8>& message, const kstd::u16 value) -> void {
+            message.push_back(static_cast<kstd::u8>(value >> 8));
+            message.push_back(static_cast<kstd::u8>(value & 0xFF));
+        }
+
+        // Encodes a recursive query for one record type, returns false if the host is no valid domain name
+        [[nodiscard]] auto encode_query(const kstd::u16 id, const std::string& host, const kstd::u16 record_type,
+                                        std::vector<kstd::u8>& message) -> bool {
+            message.clear();
+            write_u16(message, id);
+            write_u16(message, 0x0100);// Recursion desired
+            write_u16(message, 1);     // Question count
+            write_u16(message, 0);
+            write_u16(message, 0);
+            write_u16(message, 0);
+
+            std::string_view remaining {host};
+            while(!remaining.empty()) {
+                const auto label = remaining.substr(0, remaining.find('.'));
+                if(label.empty() || label.size() > 63) {
+                    return false;
+                }
+                message.push_back(static_cast<kstd::u8>(label.size()));
+                message.insert(message.end(), label.begin(), label.end());
+                remaining.remove_prefix(std::min(label.size() + 1, remaining.size()));
+            }
+            message.push_back(0);
+            write_u16(message, record_type);
+            write_u16(message, record_class_in);
+            return message.size() <= header_size + 255 + 4;
+        }
+
+        // Returns the offset behind the (possibly compressed) name at the offset
+        [[nodiscard]] auto skip_name(const kstd::u8* data, const kstd::usize size, kstd::usize offset) noexcept
+                -> kstd::Option<kstd::usize> {
+            while(offset < size) {
+                const auto length = data[offset];
+                if((length & 0xC0) == 0xC0) {
+                    return offset + 2 <= size ? kstd::Option<kstd::usize> {offset + 2} : kstd::Option<kstd::usize> {};
+                }
+                if(length == 0) {
+                    return {offset + 1};
+                }
+                offset += length + 1;
+            }
+            return {};
+        }
+
+        // Parses the response to the query with the ID, returns false if it doesn't belong to the query
+        [[nodiscard]] auto parse_response(const kstd::u8* data, const kstd::usize size, const kstd::u16 id,
+                                          const kstd::u16 record_type, Answer& answer) -> bool {
+            if(size < header_size || read_u16(data) != id || (data[2] & 0x80) == 0) {
+                return false;
+            }
+
+            const auto question_count = read_u16(data + 4);
+            const auto answer_count = read_u16(data + 6);
+            const auto authority_count = read_u16(data + 8);
+            kstd::usize offset = header_size;
+            for(kstd::u16 i = 0; i < question_count; ++i) {
+                const auto name_end = skip_name(data, size, offset);
+                if(!name_end || name_end.get() + 4 > size) {
+                    return false;
+                }
+                offset = name_end.get() + 4;
+            }
+
+            answer.answered = true;
+            answer.response_code = data[3] & 0x0F;
+            answer.ttl = max_ttl;
+            answer.negative_ttl = default_negative_ttl;
+            for(kstd::usize i = 0; i < static_cast<kstd::usize>(answer_count) + authority_count; ++i) {
+                const auto name_end = skip_name(data, size, offset);
+                if(!name_end || name_end.get() + 10 > size) {
+                    break;
+                }
+
+                const auto* record = data + name_end.get();
+                const auto type = read_u16(record);
+                const auto record_class = read_u16(record + 2);
+                const auto ttl = std::min(read_u32(record + 4), max_ttl);
+                const auto data_size = read_u16(record + 8);
+                const auto* record_data = record + 10;
+                offset = name_end.get() + 10 + data_size;
+                if(offset > size || record_class != record_class_in) {
+                    break;
+                }
+
+                // CNAME records of the chain are skipped, the resolver appends the records of the canonical name
+                if(i < answer_count && type == record_type && type == record_type_a && data_size == 4) {
+                    IPv4Address address {};
+                    std::copy(record_data, record_data + 4, address.octets.begin());
+                    answer.addresses.emplace_back(address, 0);
+                    answer.ttl = std::min(answer.ttl, ttl);
+                }
+                else if(i < answer_count && type == record_type && type == record_type_aaaa && data_size == 16) {
+                    IPv6Address address {};
+                    std::copy(record_data, record_data + 16, address.octets.begin());
+                    answer.addresses.emplace_back(address, 0);
+                    answer.ttl = std::min(answer.ttl, ttl);
+                }
+                else if(i >= answer_count && type == record_type_soa && data_size >= 20) {
+                    // The minimum field is the last of the SOA record and limits the TTL of negative answers
+                    answer.negative_ttl = std::min(ttl, read_u32(record_data + data_size - 4));
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] auto random_id() -> kstd::u16 {
+            thread_local std::mt19937 generator {std::random_device {}()};
+            return static_cast<kstd::u16>(generator());
+        }
+    }// namespace
+
+    DnsResolver::DnsResolver(const kstd::usize worker_count) :
+            _name_server {},
+            _timeout {1000},
+            _attempts {2},
+            _stopping {false} {
+        start_workers(worker_count);
+    }
+
+    DnsResolver::DnsResolver(const SocketAddress& name_server, const kstd::usize worker_count,
+                             const std::chrono::milliseconds timeout, const kstd::u32 attempts) :
+            _name_server {name_server},
+            _timeout {timeout},
+            _attempts {std::max(attempts, 1U)},
+            _stopping {false} {
+        start_workers(worker_count);
+    }
+
+    DnsResolver::~DnsResolver() noexcept {
+        {
+            const std::lock_guard<std::mutex> lock {_job_mutex};
+            _stopping = true;
+        }
+        _job_condition.notify_all();
+        for(auto& worker_thread : _worker_threads) {
+            worker_thread.join();
+        }
+    }
+
+    auto DnsResolver::shared() -> DnsResolver& {
+        static DnsResolver resolver {};
+        return resolver;
+    }
+
+    auto DnsResolver::start_workers(const kstd::usize worker_count) -> void {
+        for(kstd::usize i = 0; i < std::max(worker_count, static_cast<kstd::usize>(1)); ++i) {
+            _worker_threads.emplace_back([this] {
+                while(true) {
+                    std::unique_lock<std::mutex> lock {_job_mutex};
+                    _job_condition.wait(lock, [this] {
+                        return _stopping || !_jobs.empty();
+                    });
+                    if(_jobs.empty()) {
+                        return;// Stopping, pending lookups are finished first
+                    }
+
+                    auto job = std::move(_jobs.front());
+                    _jobs.pop_front();
+                    lock.unlock();
+                    job.callback(resolve(job.host, job.port));
+                }
+            });
+        }
+    }
+
+    auto DnsResolver::lookup(const std::string& host) const noexcept -> CacheEntry {
+        if(!_name_server) {
+            return lookup_system(host);
+        }
+
+        const auto& name_server = _name_server.get();
+        std::vector<kstd::u8> message {};
+        std::array<kstd::u16, 2> record_types {record_type_aaaa, record_type_a};
+        std::array<kstd::u16, 2> ids {};
+        std::array<Answer, 2> answers {};
+        const auto now = std::chrono::steady_clock::now();
+
+        const auto socket_handle = ::socket(name_server.data()->sa_family, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if(!handle_valid(socket_handle)) {
+            const auto error_code = get_last_error_code();
+            return {{}, fmt::format("Unable to resolve '{}' => {}", host, format_error(error_code)), error_code, now};
+        }
+        if(::connect(socket_handle, name_server.data(), name_server.length()) < 0) {
+            const auto error_code = get_last_error_code();
+            ::close(socket_handle);
+            return {{}, fmt::format("Unable to resolve '{}' => {}", host, format_error(error_code)), error_code, now};
+        }
+
+        // Both queries are sent at once, unanswered ones are repeated with new IDs in the next attempt
+        std::string error {};
+        kstd::i32 error_code = 0;
+        std::array<kstd::u8, max_message_size> response {};
+        for(kstd::u32 attempt = 0; attempt < _attempts && error.empty(); ++attempt) {
+            for(kstd::usize i = 0; i < answers.size(); ++i) {
+                if(answers[i].answered) {
+                    continue;
+                }
+                ids[i] = random_id();
+                if(!encode_query(ids[i], host, record_types[i], message)) {
+                    ::close(socket_handle);
+                    return {{}, fmt::format("Unable to resolve '{}' => Invalid domain name", host), EINVAL, now};
+                }
+                ::send(socket_handle, message.data(), message.size(), MSG_NOSIGNAL);
+            }
+
+            const auto deadline = std::chrono::steady_clock::now() + _timeout;
+            while(!(answers[0].answered && answers[1].answered)) {
+                const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        deadline - std::chrono::steady_clock::now());
+                pollfd poll_handle {socket_handle, POLLIN, 0};
+                if(remaining.count() <= 0 || ::poll(&poll_handle, 1, static_cast<int>(remaining.count())) == 0) {
+                    break;
+                }
+
+                const auto size = ::recv(socket_handle, response.data(), response.size(), 0);
+                if(size < 0) {
+                    if(errno != EINTR) {
+                        error_code = get_last_error_code();// e.g. ICMP port unreachable of the name server
+                        error = format_error(error_code);
+                        break;
+                    }
+                    continue;
+                }
+                for(kstd::usize i = 0; i < answers.size(); ++i) {
+                    if(!answers[i].answered &&
+                       parse_response(response.data(), static_cast<kstd::usize>(size), ids[i], record_types[i],
+                                      answers[i])) {
+                        break;
+                    }
+                }
+            }
+            if(answers[0].answered && answers[1].answered) {
+                break;
+            }
+        }
+        ::close(socket_handle);
+
+        // Failures of the name server itself are not cached, NXDOMAIN and empty answers are
+        CacheEntry entry {{}, {}, 0, std::chrono::steady_clock::now()};
+        kstd::u32 ttl = max_ttl;
+        bool negative = false;
+        kstd::u32 negative_ttl = max_ttl;
+        for(auto& answer : answers) {
+            if(!answer.answered) {
+                continue;
+            }
+            if(!answer.addresses.empty()) {
+                entry.addresses.insert(entry.addresses.end(), answer.addresses.begin(), answer.addresses.end());
+                ttl = std::min(ttl, answer.ttl);
+            }
+            else if(answer.response_code == response_code_no_error ||
+                    answer.response_code == response_code_name_error) {
+                negative = true;
+                negative_ttl = std::min(negative_ttl, answer.negative_ttl);
+            }
+        }
+
+        if(!entry.addresses.empty()) {
+            entry.expiry += std::chrono::seconds {ttl};
+        }
+        else if(negative && answers[0].answered && answers[1].answered) {
+            entry.error = fmt::format("Unable to resolve '{}' => No address found with the domain", host);
+            entry.error_code = ENOENT;
+            entry.expiry += std::chrono::seconds {negative_ttl};
+        }
+        else if(!error.empty()) {
+            entry.error = fmt::format("Unable to resolve '{}' => {}", host, error);
+            entry.error_code = error_code;
+        }
+        else if(const auto failed_answer = std::find_if(answers.begin(), answers.end(),
+                                                        [](const Answer& answer) {
+                                                            return answer.answered &&
+                                                                   answer.response_code != response_code_no_error &&
+                                                                   answer.response_code != response_code_name_error;
+                                                        });
+                failed_answer != answers.end()) {
+            entry.error = fmt::format("Unable to resolve '{}' => Name server failure (code {})", host,
+                                      failed_answer->response_code);
+            entry.error_code = EIO;
+        }
+        else {
+            entry.error = fmt::format("Unable to resolve '{}' => The name server did not respond", host);
+            entry.error_code = ETIMEDOUT;
+        }
+        return entry;
+    }
+
+    auto DnsResolver::lookup_system(const std::string& host) const noexcept -> CacheEntry {
+        addrinfo hints {};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;// One entry per address instead of one per socket type
+        hints.ai_flags = AI_ADDRCONFIG;
+        addrinfo* address_infos = nullptr;
+        const auto status = ::getaddrinfo(host.c_str(), nullptr, &hints, &address_infos);
+
+        CacheEntry entry {{}, {}, 0, std::chrono::steady_clock::now()};
+        if(status != 0) {
+            // Only names without addresses are cached, the other failures may be temporary
+            switch(status) {
+                case EAI_NONAME:
+#ifdef EAI_NODATA
+                case EAI_NODATA:
+#endif
+#ifdef EAI_ADDRFAMILY
+                case EAI_ADDRFAMILY:
+#endif
+                    entry.error_code = ENOENT;
+                    entry.expiry += std::chrono::seconds {system_ttl};
+                    break;
+                case EAI_AGAIN: entry.error_code = ETIMEDOUT; break;
+                case EAI_MEMORY: entry.error_code = ENOMEM; break;
+                case EAI_SYSTEM: entry.error_code = errno; break;
+                case EAI_FAIL: entry.error_code = EIO; break;
+                default: entry.error_code = EINVAL; break;
+            }
+            entry.error = fmt::format("Unable to resolve '{}' => {}", host,
+                                      status == EAI_SYSTEM ? format_error(entry.error_code) : ::gai_strerror(status));
+            return entry;
+        }
+
+        for(const auto* address_info = address_infos; address_info != nullptr; address_info = address_info->ai_next) {
+            if(address_info->ai_addrlen > SocketAddress::capacity()) {
+                continue;
+            }
+            SocketAddress address {};
+            std::memcpy(address.data(), address_info->ai_addr, address_info->ai_addrlen);
+            address.set_length(address_info->ai_addrlen);
+            entry.addresses.push_back(address);
+        }
+        ::freeaddrinfo(address_infos);
+
+        // Keep the order of getaddrinfo (RFC 6724) within the families, but return the IPv6 addresses first
+        std::stable_partition(entry.addresses.begin(), entry.addresses.end(), [](const SocketAddress& address) {
+            return address.address_type() == AddressType::IPV6;
+        });
+        entry.expiry += std::chrono::seconds {system_ttl};
+        return entry;
+    }
+
+    auto DnsResolver::resolve_uncached(const std::string& host) noexcept -> CacheEntry {
+        auto entry = lookup(host);
+        if(entry.expiry > std::chrono::steady_clock::now()) {
+            const std::lock_guard<std::mutex> lock {_cache_mutex};
+            if(_cache.size() >= cache_purge_threshold) {
+                const auto now = std::chrono::steady_clock::now();
+                for(auto iterator = _cache.begin(); iterator != _cache.end();) {
+                    iterator = iterator->second.expiry <= now ? _cache.erase(iterator) : std::next(iterator);
+                }
+            }
+            _cache[host] = entry;
+        }
+        return entry;
+    }
+
+    auto DnsResolver::resolve_entry(const std::string_view host, const kstd::u16 port) noexcept -> CacheEntry {
+        if(const auto address = SocketAddress::from_literal(host, port); address) {
+            return {{address.get()}, {}, 0, {}};
+        }
+
+        const auto normalized_host = normalize_host(host);
+        CacheEntry entry {};
+        bool cached = false;
+        {
+            const std::lock_guard<std::mutex> lock {_cache_mutex};
+            if(const auto cache_entry = _cache.find(normalized_host);
+               cache_entry != _cache.end() && cache_entry->second.expiry > std::chrono::steady_clock::now()) {
+                entry = cache_entry->second;
+                cached = true;
+            }
+        }
+        if(!cached) {
+            entry = resolve_uncached(normalized_host);
+        }
+        for(auto& address : entry.addresses) {
+            address.set_port(port);
+        }
+        return entry;
+    }
+
+    auto DnsResolver::resolve(const std::string_view host, const kstd::u16 port) noexcept
+            -> kstd::Result<std::vector<SocketAddress>> {
+        auto entry = resolve_entry(host, port);
+        if(!entry.error.empty()) {
+            return kstd::Error {std::move(entry.error)};
+        }
+        return std::move(entry.addresses);
+    }
+
+    auto DnsResolver::resolve_addresses(const std::string_view host, const kstd::u16 port) noexcept
+            -> kstd::Result<std::vector<SocketAddress>, SocketError> {
+        auto entry = resolve_entry(host, port);
+        if(!entry.error.empty()) {
+            return kstd::Error {SocketError {SocketOperation::RESOLVE, entry.error_code}};
+        }
+        return std::move(entry.addresses);
+    }
+
+    auto DnsResolver::resolve_async(const std::string_view host, const kstd::u16 port, ResolveCallback callback)
+            -> void {
+        // Answer without a thread hop if no query is necessary
+        const auto normalized_host = normalize_host(host);
+        bool cached = static_cast<bool>(SocketAddress::from_literal(host, port));
+        if(!cached) {
+            const std::lock_guard<std::mutex> lock {_cache_mutex};
+            const auto cache_entry = _cache.find(normalized_host);
+            cached = cache_entry != _cache.end() && cache_entry->second.expiry > std::chrono::steady_clock::now();
+        }
+        if(cached) {
+            callback(resolve(host, port));
+            return;
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock {_job_mutex};
+            _jobs.push_back({std::string {host}, port, std::move(callback)});
+        }
+        _job_condition.notify_one();
+    }
+
+    auto DnsResolver::cache_size() const noexcept -> kstd::usize {
+        const std::lock_guard<std::mutex> lock {_cache_mutex};
+        return _cache.size();
+    }
+
+    auto DnsResolver::clear_cache() noexcept -> void {
+        const std::lock_guard<std::mutex> lock {_cache_mutex};
+        _cache.clear();
+    }
+}// namespace sockslib
+#endif
@@ -0,0 +1,275 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/event_loop.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace sockslib {
+    namespace {
+        constexpr auto idle_timer_tick = std::chrono::milliseconds {10};
+    }// namespace
+
+    EventLoop::EventLoop(const kstd::usize max_events_per_poll) :
+            _epoll_handle {epoll_create1(EPOLL_CLOEXEC)},
+            _wakeup_handle {-1},
+            _running {false},
+            _events {max_events_per_poll > 0 ? max_events_per_poll : 1},
+            _idle_timeout {0},
+            _idle_timers {idle_timer_tick} {
+        if(_epoll_handle < 0) {
+            throw std::runtime_error {fmt::format("Unable to initialize event loop => {}", get_last_error())};
+        }
+
+        // The wakeup event is registered without data pointer, which identifies it while dispatching
+        _wakeup_handle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if(_wakeup_handle < 0) {
+            close(_epoll_handle);
+            throw std::runtime_error {fmt::format("Unable to initialize event loop => {}", get_last_error())};
+        }
+
+        epoll_event event {};
+        event.events = EPOLLIN | EPOLLET;
+        event.data.ptr = nullptr;
+        if(epoll_ctl(_epoll_handle, EPOLL_CTL_ADD, _wakeup_handle, &event) < 0) {
+            close(_wakeup_handle);
+            close(_epoll_handle);
+            throw std::runtime_error {fmt::format("Unable to initialize event loop => {}", get_last_error())};
+        }
+    }
+
+    EventLoop::EventLoop(EventLoop&& other) noexcept :
+            _epoll_handle {other._epoll_handle},
+            _wakeup_handle {other._wakeup_handle},
+            _running {other._running},
+            _events {std::move(other._events)},
+            _registrations {std::move(other._registrations)},
+            _retired_registrations {std::move(other._retired_registrations)},
+            _idle_timeout {other._idle_timeout},
+            _idle_callback {std::move(other._idle_callback)},
+            _idle_timers {std::move(other._idle_timers)} {
+        other._epoll_handle = -1;
+        other._wakeup_handle = -1;
+    }
+
+    EventLoop::~EventLoop() noexcept {
+        if(_wakeup_handle >= 0) {
+            close(_wakeup_handle);
+        }
+        if(_epoll_handle >= 0) {
+            close(_epoll_handle);
+        }
+    }
+
+    auto EventLoop::add(const SocketHandle socket_handle, const EventType interest, EventCallback callback) noexcept
+            -> kstd::Result<void> {
+        using namespace std::string_literals;
+        if(!handle_valid(socket_handle)) {
+            return kstd::Error {"Unable to add socket to event loop => Socket handle is invalid!"s};
+        }
+
+        if(_registrations.find(socket_handle) != _registrations.end()) {
+            return kstd::Error {"Unable to add socket to event loop => Socket is already registered!"s};
+        }
+
+        // Edge-triggered polling requires non-blocking sockets to drain them
+        const auto flags = fcntl(socket_handle, F_GETFL, 0);
+        if(flags < 0 || fcntl(socket_handle, F_SETFL, flags | O_NONBLOCK) < 0) {
+            return kstd::Error {fmt::format("Unable to add socket to event loop => {}", get_last_error())};
+        }
+
+        const auto idle_tracked = static_cast<bool>(_idle_callback);
+        auto registration = std::make_unique<Registration>(
+                Registration {socket_handle, std::move(callback), true, idle_tracked, TimerId {}});
+        epoll_event event {};
+        event.events = static_cast<kstd::u32>(interest) | EPOLLRDHUP | EPOLLET;
+        event.data.ptr = registration.get();
+        if(epoll_ctl(_epoll_handle, EPOLL_CTL_ADD, socket_handle, &event) < 0) {
+            // The socket stays with the caller, so it gets its original blocking mode back
+            const auto error = get_last_error();
+            fcntl(socket_handle, F_SETFL, flags);
+            return kstd::Error {fmt::format("Unable to add socket to event loop => {}", error)};
+        }
+
+        if(idle_tracked) {
+            touch(*registration, std::chrono::steady_clock::now());
+        }
+        _registrations.emplace(socket_handle, std::move(registration));
+        return {};
+    }
+
+    auto EventLoop::add(const ServerSocket& server_socket, AcceptCallback callback,
+                        AcceptErrorCallback error_callback) noexcept -> kstd::Result<void> {
+        const auto* socket = &server_socket;
+        auto accept_callback = [socket, callback = std::move(callback),
+                                error_callback = std::move(error_callback)](auto) {
+            // Accept until the backlog is drained, otherwise the edge-triggered event is never raised again
+            while(true) {
+                auto accept_result = socket->try_accept();
+                if(!accept_result && accept_result.get_error().connection_reset()) {
+                    continue;// The peer gave up while the connection was queued
+                }
+                if(!accept_result) {
+                    if(error_callback) {
+                        error_callback(accept_result.get_error());
+                    }
+                    break;
+                }
+                if(accept_result.get().is_empty()) {
+                    break;
+                }
+                callback(std::move(accept_result.get().get()));
+            }
+        };
+        if(auto result = add(server_socket.socket_handle(), EventType::READ, std::move(accept_callback)); !result) {
+            return result;
+        }
+
+        auto& registration = *_registrations.find(server_socket.socket_handle())->second;
+        _idle_timers.cancel(registration.idle_timer);
+        registration.idle_tracked = false;
+        return {};
+    }
+
+    auto EventLoop::set_idle_timeout(const std::chrono::milliseconds timeout, IdleCallback callback) -> void {
+        _idle_timeout = timeout;
+        _idle_callback = std::move(callback);
+    }
+
+    auto EventLoop::touch(Registration& registration, const std::chrono::steady_clock::time_point now) -> void {
+        const auto deadline = now + _idle_timeout;
+        if(!_idle_timers.reschedule(registration.idle_timer, deadline)) {
+            registration.idle_timer = _idle_timers.schedule(deadline, registration.socket_handle);
+        }
+    }
+
+    auto EventLoop::modify(const SocketHandle socket_handle, const EventType interest) noexcept -> kstd::Result<void> {
+        using namespace std::string_literals;
+        const auto registration = _registrations.find(socket_handle);
+        if(registration == _registrations.end()) {
+            return kstd::Error {"Unable to modify socket in event loop => Socket is not registered!"s};
+        }
+
+        epoll_event event {};
+        event.events = static_cast<kstd::u32>(interest) | EPOLLRDHUP | EPOLLET;
+        event.data.ptr = registration->second.get();
+        if(epoll_ctl(_epoll_handle, EPOLL_CTL_MOD, socket_handle, &event) < 0) {
+            return kstd::Error {fmt::format("Unable to modify socket in event loop => {}", get_last_error())};
+        }
+        return {};
+    }
+
+    auto EventLoop::remove(const SocketHandle socket_handle) noexcept -> kstd::Result<void> {
+        using namespace std::string_literals;
+        const auto registration = _registrations.find(socket_handle);
+        if(registration == _registrations.end()) {
+            return kstd::Error {"Unable to remove socket from event loop => Socket is not registered!"s};
+        }
+
+        // Events of the current batch may still point to the registration, so it's only released after dispatching
+        _idle_timers.cancel(registration->second->idle_timer);
+        registration->second->active = false;
+        _retired_registrations.push_back(std::move(registration->second));
+        _registrations.erase(registration);
+
+        if(epoll_ctl(_epoll_handle, EPOLL_CTL_DEL, socket_handle, nullptr) < 0 && errno != EBADF) {
+            return kstd::Error {fmt::format("Unable to remove socket from event loop => {}", get_last_error())};
+        }
+        return {};
+    }
+
+    auto EventLoop::poll(const int timeout_ms) noexcept -> kstd::Result<kstd::usize> {
+        // Idle timers cut the wait short, so they expire even without events
+        auto effective_timeout_ms = timeout_ms;
+        const auto track_idle = static_cast<bool>(_idle_callback);
+        if(track_idle && !_idle_timers.is_empty()) {
+            const auto idle_timeout_ms = poll_timeout(_idle_timers.next_expiry());
+            if(effective_timeout_ms < 0 || idle_timeout_ms < effective_timeout_ms) {
+                effective_timeout_ms = idle_timeout_ms;
+            }
+        }
+
+        const auto event_count =
+                epoll_wait(_epoll_handle, _events.data(), static_cast<int>(_events.size()), effective_timeout_ms);
+        if(event_count < 0) {
+            if(errno == EINTR) {
+                return 0;
+            }
+            return kstd::Error {fmt::format("Unable to poll event loop => {}", get_last_error())};
+        }
+
+        const auto now = track_idle ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point {};
+        kstd::usize dispatched_events = 0;
+        for(int i = 0; i < event_count; ++i) {
+            const auto& event = _events[i];
+            auto* registration = static_cast<Registration*>(event.data.ptr);
+            if(registration == nullptr) {
+                eventfd_t value = 0;
+                eventfd_read(_wakeup_handle, &value);
+                _running = false;
+                continue;
+            }
+
+            if(registration->active) {
+                if(track_idle && registration->idle_tracked) {
+                    touch(*registration, now);
+                }
+                registration->callback(static_cast<EventType>(event.events));
+                ++dispatched_events;
+            }
+        }
+
+        if(track_idle) {
+            _idle_timers.advance(std::chrono::steady_clock::now(), [this](const SocketHandle socket_handle) {
+                _idle_callback(socket_handle);
+            });
+        }
+        _retired_registrations.clear();
+        return dispatched_events;
+    }
+
+    auto EventLoop::run() noexcept -> kstd::Result<void> {
+        _running = true;
+        while(_running) {
+            if(auto result = poll(); !result) {
+                _running = false;
+                return kstd::Error {result.get_error()};
+            }
+        }
+        return {};
+    }
+
+    auto EventLoop::stop() const noexcept -> void {
+        eventfd_write(_wakeup_handle, 1);
+    }
+
+    auto EventLoop::operator=(EventLoop&& other) noexcept -> EventLoop& {
+        if(this == &other) {
+            return *this;
+        }
+
+        if(_wakeup_handle >= 0) {
+            close(_wakeup_handle);
+        }
+        if(_epoll_handle >= 0) {
+            close(_epoll_handle);
+        }
+
+        _epoll_handle = other._epoll_handle;
+        _wakeup_handle = other._wakeup_handle;
+        _running = other._running;
+        _events = std::move(other._events);
+        _registrations = std::move(other._registrations);
+        _retired_registrations = std::move(other._retired_registrations);
+        _idle_timeout = other._idle_timeout;
+        _idle_callback = std::move(other._idle_callback);
+        _idle_timers = std::move(other._idle_timers);
+        other._epoll_handle = -1;
+        other._wakeup_handle = -1;
+        return *this;
+    }
+}// namespace sockslib
+#endif
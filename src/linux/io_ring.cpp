@@ -0,0 +1,429 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/io_ring.hpp"
+
+#include <algorithm>
+#include <errno.h>
+#include <fmt/format.h>
+#include <limits>
+#include <stdexcept>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifdef SOCKSLIB_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace sockslib {
+    IoRing::IoRing(const kstd::u32 queue_depth, const kstd::u32 buffer_count, const kstd::usize buffer_size,
+                   const bool prefer_io_uring) :
+            _ring_handle {-1},
+            _buffers_registered {false},
+            _queue_depth {queue_depth > 0 ? queue_depth : 1},
+            _buffer_count {buffer_count},
+            _buffer_size {buffer_size},
+            _buffers {nullptr},
+            _submission_ring {nullptr},
+            _submission_ring_size {0},
+            _completion_ring {nullptr},
+            _completion_ring_size {0},
+            _submission_entries {nullptr},
+            _submission_entries_size {0},
+            _submission_head {nullptr},
+            _submission_tail {nullptr},
+            _submission_mask {nullptr},
+            _submission_array {nullptr},
+            _completion_head {nullptr},
+            _completion_tail {nullptr},
+            _completion_mask {nullptr},
+            _completion_entries {nullptr},
+            _local_submission_tail {0} {
+        // Page aligned buffers in one mapping, which allows the kernel to pin them in one go
+        if(_buffer_count > 0 && _buffer_size > 0) {
+            auto* buffers = mmap(nullptr, _buffer_count * _buffer_size, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if(buffers == MAP_FAILED) {// NOLINT
+                throw std::runtime_error {fmt::format("Unable to initialize I/O ring => {}", get_last_error())};
+            }
+            _buffers = static_cast<kstd::u8*>(buffers);
+        }
+
+        if(!prefer_io_uring || !setup_io_uring()) {
+            _pending_operations.reserve(_queue_depth);
+            _fallback_completions.reserve(_queue_depth);
+        }
+    }
+
+    IoRing::IoRing(IoRing&& other) noexcept :
+            _ring_handle {other._ring_handle},
+            _buffers_registered {other._buffers_registered},
+            _queue_depth {other._queue_depth},
+            _buffer_count {other._buffer_count},
+            _buffer_size {other._buffer_size},
+            _buffers {other._buffers},
+            _submission_ring {other._submission_ring},
+            _submission_ring_size {other._submission_ring_size},
+            _completion_ring {other._completion_ring},
+            _completion_ring_size {other._completion_ring_size},
+            _submission_entries {other._submission_entries},
+            _submission_entries_size {other._submission_entries_size},
+            _submission_head {other._submission_head},
+            _submission_tail {other._submission_tail},
+            _submission_mask {other._submission_mask},
+            _submission_array {other._submission_array},
+            _completion_head {other._completion_head},
+            _completion_tail {other._completion_tail},
+            _completion_mask {other._completion_mask},
+            _completion_entries {other._completion_entries},
+            _local_submission_tail {other._local_submission_tail},
+            _pending_operations {std::move(other._pending_operations)},
+            _fallback_completions {std::move(other._fallback_completions)} {
+        other._ring_handle = -1;
+        other._buffers = nullptr;
+        other._submission_ring = nullptr;
+        other._completion_ring = nullptr;
+        other._submission_entries = nullptr;
+    }
+
+    IoRing::~IoRing() noexcept {
+        release();
+    }
+
+    auto IoRing::release() noexcept -> void {
+        release_ring();
+        if(_buffers != nullptr) {
+            munmap(_buffers, _buffer_count * _buffer_size);
+            _buffers = nullptr;
+        }
+    }
+
+    auto IoRing::release_ring() noexcept -> void {
+        if(_submission_entries != nullptr) {
+            munmap(_submission_entries, _submission_entries_size);
+            _submission_entries = nullptr;
+        }
+        if(_completion_ring != nullptr && _completion_ring != _submission_ring) {
+            munmap(_completion_ring, _completion_ring_size);
+        }
+        _completion_ring = nullptr;
+        if(_submission_ring != nullptr) {
+            munmap(_submission_ring, _submission_ring_size);
+            _submission_ring = nullptr;
+        }
+
+        // Closing the ring also unregisters the buffers
+        if(_ring_handle >= 0) {
+            close(_ring_handle);
+            _ring_handle = -1;
+        }
+        _buffers_registered = false;
+    }
+
+#ifdef SOCKSLIB_IO_URING
+    auto IoRing::setup_io_uring() noexcept -> bool {
+        io_uring_params params {};
+        const auto ring_handle = static_cast<int>(syscall(__NR_io_uring_setup, _queue_depth, &params));
+        if(ring_handle < 0) {
+            return false;
+        }
+
+        // Probe the operations, accept, send and receive are available since Linux 5.6
+        constexpr kstd::usize probe_size = sizeof(io_uring_probe) + IORING_OP_LAST * sizeof(io_uring_probe_op);
+        alignas(io_uring_probe) kstd::u8 probe_buffer[probe_size] {};// NOLINT
+        auto* probe = reinterpret_cast<io_uring_probe*>(probe_buffer);// NOLINT
+        if(syscall(__NR_io_uring_register, ring_handle, IORING_REGISTER_PROBE, probe, IORING_OP_LAST) < 0) {
+            close(ring_handle);
+            return false;
+        }
+        for(const auto operation : {IORING_OP_ACCEPT, IORING_OP_RECV, IORING_OP_SEND}) {
+            if(operation > probe->last_op || (probe->ops[operation].flags & IO_URING_OP_SUPPORTED) == 0) {// NOLINT
+                close(ring_handle);
+                return false;
+            }
+        }
+
+        // Map the submission and completion rings, which share one mapping on newer kernels
+        _submission_ring_size = params.sq_off.array + params.sq_entries * sizeof(kstd::u32);
+        _completion_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const auto single_mapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if(single_mapping) {
+            _submission_ring_size = std::max(_submission_ring_size, _completion_ring_size);
+            _completion_ring_size = _submission_ring_size;
+        }
+
+        _ring_handle = ring_handle;
+        auto* submission_ring = mmap(nullptr, _submission_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                     ring_handle, IORING_OFF_SQ_RING);
+        if(submission_ring == MAP_FAILED) {// NOLINT
+            release_ring();
+            return false;
+        }
+        _submission_ring = submission_ring;
+
+        if(single_mapping) {
+            _completion_ring = _submission_ring;
+        }
+        else {
+            auto* completion_ring = mmap(nullptr, _completion_ring_size, PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_POPULATE, ring_handle, IORING_OFF_CQ_RING);
+            if(completion_ring == MAP_FAILED) {// NOLINT
+                release_ring();
+                return false;
+            }
+            _completion_ring = completion_ring;
+        }
+
+        _submission_entries_size = params.sq_entries * sizeof(io_uring_sqe);
+        auto* submission_entries = mmap(nullptr, _submission_entries_size, PROT_READ | PROT_WRITE,
+                                        MAP_SHARED | MAP_POPULATE, ring_handle, IORING_OFF_SQES);
+        if(submission_entries == MAP_FAILED) {// NOLINT
+            release_ring();
+            return false;
+        }
+        _submission_entries = submission_entries;
+
+        auto* submission_base = static_cast<kstd::u8*>(_submission_ring);
+        _submission_head = reinterpret_cast<kstd::u32*>(submission_base + params.sq_off.head); // NOLINT
+        _submission_tail = reinterpret_cast<kstd::u32*>(submission_base + params.sq_off.tail); // NOLINT
+        _submission_mask = reinterpret_cast<kstd::u32*>(submission_base + params.sq_off.ring_mask);// NOLINT
+        _submission_array = reinterpret_cast<kstd::u32*>(submission_base + params.sq_off.array);// NOLINT
+        auto* completion_base = static_cast<kstd::u8*>(_completion_ring);
+        _completion_head = reinterpret_cast<kstd::u32*>(completion_base + params.cq_off.head); // NOLINT
+        _completion_tail = reinterpret_cast<kstd::u32*>(completion_base + params.cq_off.tail); // NOLINT
+        _completion_mask = reinterpret_cast<kstd::u32*>(completion_base + params.cq_off.ring_mask);// NOLINT
+        _completion_entries = completion_base + params.cq_off.cqes;                                // NOLINT
+        _local_submission_tail = *_submission_tail;
+        _queue_depth = params.sq_entries;
+
+        // Pin the buffers, without this the fixed operations fall back to regular receive and send
+        if(_buffers != nullptr) {
+            std::vector<iovec> buffers(_buffer_count);
+            for(kstd::u32 i = 0; i < _buffer_count; ++i) {
+                buffers[i].iov_base = buffer(i);
+                buffers[i].iov_len = _buffer_size;
+            }
+            _buffers_registered = syscall(__NR_io_uring_register, ring_handle, IORING_REGISTER_BUFFERS,
+                                          buffers.data(), _buffer_count) == 0;
+        }
+        return true;
+    }
+#else
+    auto IoRing::setup_io_uring() noexcept -> bool {
+        return false;
+    }
+#endif
+
+    auto IoRing::prepare(const Operation operation, const SocketHandle socket_handle, void* data,
+                         const kstd::usize size, const kstd::i32 buffer_index, const kstd::u64 user_data) noexcept
+            -> kstd::Result<void> {
+        using namespace std::string_literals;
+        if(!handle_valid(socket_handle)) {
+            return kstd::Error {"Unable to prepare I/O operation => Socket handle is invalid!"s};
+        }
+
+        if(!uses_io_uring()) {
+            _pending_operations.push_back({operation, socket_handle, data, size, user_data});
+            return {};
+        }
+
+#ifdef SOCKSLIB_IO_URING
+        // Flush the prepared operations to the kernel if the submission queue is full
+        if(_local_submission_tail - __atomic_load_n(_submission_head, __ATOMIC_ACQUIRE) >= _queue_depth) {
+            if(auto result = submit(); !result) {
+                return kstd::Error {result.get_error()};
+            }
+        }
+
+        const auto index = _local_submission_tail & *_submission_mask;
+        auto& entry = static_cast<io_uring_sqe*>(_submission_entries)[index];// NOLINT
+        memset(&entry, 0, sizeof(entry));
+        entry.fd = socket_handle;
+        entry.user_data = user_data;
+        switch(operation) {
+            case Operation::ACCEPT:
+                entry.opcode = IORING_OP_ACCEPT;
+                entry.accept_flags = SOCK_CLOEXEC;
+                break;
+            case Operation::RECEIVE:
+                if(buffer_index >= 0 && _buffers_registered) {
+                    entry.opcode = IORING_OP_READ_FIXED;
+                    entry.buf_index = static_cast<kstd::u16>(buffer_index);
+                    entry.off = static_cast<kstd::u64>(-1);// Use the stream position, sockets have none
+                }
+                else {
+                    entry.opcode = IORING_OP_RECV;
+                }
+                entry.addr = reinterpret_cast<kstd::u64>(data);// NOLINT
+                entry.len = static_cast<kstd::u32>(std::min<kstd::usize>(size, std::numeric_limits<kstd::u32>::max()));
+                break;
+            case Operation::SEND:
+                if(buffer_index >= 0 && _buffers_registered) {
+                    entry.opcode = IORING_OP_WRITE_FIXED;
+                    entry.buf_index = static_cast<kstd::u16>(buffer_index);
+                    entry.off = static_cast<kstd::u64>(-1);
+                }
+                else {
+                    entry.opcode = IORING_OP_SEND;
+                    entry.msg_flags = MSG_NOSIGNAL;
+                }
+                entry.addr = reinterpret_cast<kstd::u64>(data);// NOLINT
+                entry.len = static_cast<kstd::u32>(std::min<kstd::usize>(size, std::numeric_limits<kstd::u32>::max()));
+                break;
+        }
+        _submission_array[index] = index;// NOLINT
+        ++_local_submission_tail;
+#else
+        static_cast<void>(buffer_index);
+#endif
+        return {};
+    }
+
+    auto IoRing::prepare_accept(const ServerSocket& server_socket, const kstd::u64 user_data) noexcept
+            -> kstd::Result<void> {
+        return prepare(Operation::ACCEPT, server_socket.socket_handle(), nullptr, 0, -1, user_data);
+    }
+
+    auto IoRing::prepare_receive(const SocketHandle socket_handle, kstd::u8* data, const kstd::usize size,
+                                 const kstd::u64 user_data) noexcept -> kstd::Result<void> {
+        return prepare(Operation::RECEIVE, socket_handle, data, size, -1, user_data);
+    }
+
+    auto IoRing::prepare_send(const SocketHandle socket_handle, const void* data, const kstd::usize size,
+                              const kstd::u64 user_data) noexcept -> kstd::Result<void> {
+        return prepare(Operation::SEND, socket_handle, const_cast<void*>(data), size, -1, user_data);// NOLINT
+    }
+
+    auto IoRing::prepare_receive_fixed(const SocketHandle socket_handle, const kstd::u32 buffer_index,
+                                       const kstd::u64 user_data) noexcept -> kstd::Result<void> {
+        using namespace std::string_literals;
+        if(buffer_index >= _buffer_count) {
+            return kstd::Error {"Unable to prepare I/O operation => Buffer index is out of bounds!"s};
+        }
+        return prepare(Operation::RECEIVE, socket_handle, buffer(buffer_index), _buffer_size,
+                       static_cast<kstd::i32>(buffer_index), user_data);
+    }
+
+    auto IoRing::prepare_send_fixed(const SocketHandle socket_handle, const kstd::u32 buffer_index,
+                                    const kstd::usize size, const kstd::u64 user_data) noexcept
+            -> kstd::Result<void> {
+        using namespace std::string_literals;
+        if(buffer_index >= _buffer_count || size > _buffer_size) {
+            return kstd::Error {"Unable to prepare I/O operation => Buffer index or size is out of bounds!"s};
+        }
+        return prepare(Operation::SEND, socket_handle, buffer(buffer_index), size,
+                       static_cast<kstd::i32>(buffer_index), user_data);
+    }
+
+    auto IoRing::submit(const kstd::u32 wait_count) noexcept -> kstd::Result<kstd::u32> {
+        if(!uses_io_uring()) {
+            for(const auto& pending_operation : _pending_operations) {
+                kstd::isize result = 0;
+                switch(pending_operation.operation) {
+                    case Operation::ACCEPT:
+                        result = ::accept4(pending_operation.socket_handle, nullptr, nullptr, SOCK_CLOEXEC);
+                        break;
+                    case Operation::RECEIVE:
+                        result = ::recv(pending_operation.socket_handle, pending_operation.data,
+                                        pending_operation.size, 0);
+                        break;
+                    case Operation::SEND:
+                        result = ::send(pending_operation.socket_handle, pending_operation.data,
+                                        pending_operation.size, MSG_NOSIGNAL);
+                        break;
+                }
+                _fallback_completions.push_back(
+                        {pending_operation.user_data, static_cast<kstd::i32>(result < 0 ? -errno : result)});
+            }
+
+            const auto submitted = static_cast<kstd::u32>(_pending_operations.size());
+            _pending_operations.clear();
+            return submitted;
+        }
+
+#ifdef SOCKSLIB_IO_URING
+        const auto submitted = _local_submission_tail - *_submission_tail;
+        __atomic_store_n(_submission_tail, _local_submission_tail, __ATOMIC_RELEASE);
+        if(submitted == 0 && wait_count == 0) {
+            return 0;
+        }
+
+        const auto flags = wait_count > 0 ? IORING_ENTER_GETEVENTS : 0U;
+        while(syscall(__NR_io_uring_enter, _ring_handle, submitted, wait_count, flags, nullptr, 0) < 0) {
+            if(errno != EINTR) {
+                return kstd::Error {fmt::format("Unable to submit I/O operations => {}", get_last_error())};
+            }
+        }
+        return submitted;
+#else
+        static_cast<void>(wait_count);
+        return 0;
+#endif
+    }
+
+    auto IoRing::reap(IoCompletion* completions, const kstd::usize max_completions) noexcept -> kstd::usize {
+        if(!uses_io_uring()) {
+            const auto count = std::min(max_completions, _fallback_completions.size());
+            std::copy_n(_fallback_completions.begin(), count, completions);
+            _fallback_completions.erase(_fallback_completions.begin(),
+                                        _fallback_completions.begin() + static_cast<kstd::isize>(count));
+            return count;
+        }
+
+#ifdef SOCKSLIB_IO_URING
+        auto head = *_completion_head;
+        const auto tail = __atomic_load_n(_completion_tail, __ATOMIC_ACQUIRE);
+        kstd::usize count = 0;
+        while(head != tail && count < max_completions) {
+            const auto& entry = static_cast<io_uring_cqe*>(_completion_entries)[head & *_completion_mask];// NOLINT
+            completions[count++] = {entry.user_data, entry.res};                                   // NOLINT
+            ++head;
+        }
+        __atomic_store_n(_completion_head, head, __ATOMIC_RELEASE);
+        return count;
+#else
+        return 0;
+#endif
+    }
+
+    auto IoRing::operator=(IoRing&& other) noexcept -> IoRing& {
+        if(this == &other) {
+            return *this;
+        }
+
+        release();
+        _ring_handle = other._ring_handle;
+        _buffers_registered = other._buffers_registered;
+        _queue_depth = other._queue_depth;
+        _buffer_count = other._buffer_count;
+        _buffer_size = other._buffer_size;
+        _buffers = other._buffers;
+        _submission_ring = other._submission_ring;
+        _submission_ring_size = other._submission_ring_size;
+        _completion_ring = other._completion_ring;
+        _completion_ring_size = other._completion_ring_size;
+        _submission_entries = other._submission_entries;
+        _submission_entries_size = other._submission_entries_size;
+        _submission_head = other._submission_head;
+        _submission_tail = other._submission_tail;
+        _submission_mask = other._submission_mask;
+        _submission_array = other._submission_array;
+        _completion_head = other._completion_head;
+        _completion_tail = other._completion_tail;
+        _completion_mask = other._completion_mask;
+        _completion_entries = other._completion_entries;
+        _local_submission_tail = other._local_submission_tail;
+        _pending_operations = std::move(other._pending_operations);
+        _fallback_completions = std::move(other._fallback_completions);
+
+        other._ring_handle = -1;
+        other._buffers = nullptr;
+        other._submission_ring = nullptr;
+        other._completion_ring = nullptr;
+        other._submission_entries = nullptr;
+        return *this;
+    }
+}// namespace sockslib
+#endif
@@ -0,0 +1,197 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/reactor.hpp"
+
+#ifdef KSTD_CPP_20
+#include <errno.h>
+#include <exception>
+
+namespace sockslib {
+    namespace {
+        // Owns a spawned task, the frame of the wrapper destroys itself once the task completed
+        struct DetachedTask final {
+            struct promise_type final : detail::PooledFrame {
+                [[nodiscard]] constexpr auto get_return_object() const noexcept -> DetachedTask {
+                    return {};
+                }
+
+                [[nodiscard]] constexpr auto initial_suspend() const noexcept -> std::suspend_never {
+                    return {};
+                }
+
+                [[nodiscard]] constexpr auto final_suspend() const noexcept -> std::suspend_never {
+                    return {};
+                }
+
+                constexpr auto return_void() const noexcept -> void {
+                }
+
+                auto unhandled_exception() const noexcept -> void {
+                    std::terminate();
+                }
+            };
+        };
+
+        // Passes the handle of the awaiting coroutine to it without suspending
+        struct CurrentHandleAwaiter final {
+            std::coroutine_handle<> handle;
+
+            [[nodiscard]] constexpr auto await_ready() const noexcept -> bool {
+                return false;
+            }
+
+            [[nodiscard]] auto await_suspend(const std::coroutine_handle<> awaiting_handle) noexcept -> bool {
+                handle = awaiting_handle;
+                return false;
+            }
+
+            [[nodiscard]] auto await_resume() const noexcept -> std::coroutine_handle<> {
+                return handle;
+            }
+        };
+
+        [[nodiscard]] constexpr auto is_read_operation(const SocketOperation operation) noexcept -> bool {
+            return operation == SocketOperation::READ || operation == SocketOperation::ACCEPT;
+        }
+    }// namespace
+
+    Reactor::WaitAwaiter::WaitAwaiter(Reactor& reactor, const SocketHandle socket_handle,
+                                      const SocketOperation operation) noexcept :
+            _reactor {&reactor},
+            _socket_handle {socket_handle},
+            _operation {operation},
+            _error {operation, 0} {
+    }
+
+    auto Reactor::WaitAwaiter::await_suspend(const std::coroutine_handle<> handle) noexcept -> bool {
+        auto& waiters = _reactor->_waiters[_socket_handle];
+        auto& waiter = is_read_operation(_operation) ? waiters.reader : waiters.writer;
+        if(waiter) {
+            _error = SocketError {_operation, EBUSY};
+            return false;
+        }
+
+        waiter = handle;
+        if(!_reactor->update_registration(_socket_handle)) {
+            _error = SocketError::last(_operation);
+            waiter = nullptr;
+            static_cast<void>(_reactor->update_registration(_socket_handle));
+            return false;
+        }
+        return true;
+    }
+
+    auto Reactor::WaitAwaiter::await_resume() const noexcept -> kstd::Result<void, SocketError> {
+        if(_error.code() != 0) {
+            return kstd::Error {_error};
+        }
+        return {};
+    }
+
+    Reactor::Reactor(const kstd::usize max_events_per_poll) :
+            _event_loop {max_events_per_poll},
+            _stop_requested {false} {
+    }
+
+    Reactor::~Reactor() noexcept {
+        // The sockets are still open while the tasks own them, so their registrations are removed first
+        for(const auto& [socket_handle, waiters] : _waiters) {
+            static_cast<void>(_event_loop.remove(socket_handle));
+        }
+        _waiters.clear();
+
+        // Every task frame destroys the frame of the task it awaits, so destroying the spawned frames frees the
+        // whole chain down to the waiting coroutine
+        const auto tasks = std::move(_tasks);
+        for(auto* task : tasks) {
+            std::coroutine_handle<>::from_address(task).destroy();
+        }
+    }
+
+    auto Reactor::update_registration(const SocketHandle socket_handle) noexcept -> kstd::Result<void> {
+        const auto waiters = _waiters.find(socket_handle);
+        auto interest = EventType::NONE;
+        if(waiters != _waiters.end()) {
+            if(waiters->second.reader) {
+                interest = interest | EventType::READ;
+            }
+            if(waiters->second.writer) {
+                interest = interest | EventType::WRITE;
+            }
+        }
+
+        // The socket is registered on the first waiter and removed with the last one, the interest changes between
+        if(interest == EventType::NONE) {
+            if(waiters != _waiters.end()) {
+                _waiters.erase(waiters);
+                return _event_loop.remove(socket_handle);
+            }
+            return {};
+        }
+        if(auto result = _event_loop.modify(socket_handle, interest); result) {
+            return result;
+        }
+        return _event_loop.add(socket_handle, interest, [this, socket_handle](const EventType events) {
+            dispatch(socket_handle, events);
+        });
+    }
+
+    auto Reactor::dispatch(const SocketHandle socket_handle, const EventType events) noexcept -> void {
+        const auto waiters = _waiters.find(socket_handle);
+        if(waiters == _waiters.end()) {
+            return;
+        }
+
+        // Errors wake both sides up, their next try reports the error. A shutdown of the peer only ends the stream
+        // of the reader, the writer is woken up by a full hangup (EPOLLHUP) only.
+        std::coroutine_handle<> reader = nullptr;
+        std::coroutine_handle<> writer = nullptr;
+        if(has_event(events, EventType::READ | EventType::HANGUP | EventType::ERROR)) {
+            reader = std::exchange(waiters->second.reader, nullptr);
+        }
+        if(has_event(events, EventType::WRITE | EventType::ERROR | static_cast<EventType>(EPOLLHUP))) {
+            writer = std::exchange(waiters->second.writer, nullptr);
+        }
+
+        // The resumed coroutines may wait on the socket again or close it, so they run after the update
+        static_cast<void>(update_registration(socket_handle));
+        if(reader) {
+            reader.resume();
+        }
+        if(writer) {
+            writer.resume();
+        }
+    }
+
+    auto Reactor::spawn(Task<void> task) -> void {
+        [](Reactor& reactor, Task<void> spawned_task) -> DetachedTask {
+            const auto handle = co_await CurrentHandleAwaiter {};
+            reactor._tasks.insert(handle.address());
+            co_await std::move(spawned_task);
+            reactor._tasks.erase(handle.address());
+        }(*this, std::move(task));
+    }
+
+    auto Reactor::wait(const SocketHandle socket_handle, const SocketOperation operation) noexcept -> WaitAwaiter {
+        return {*this, socket_handle, operation};
+    }
+
+    auto Reactor::poll(const int timeout_ms) noexcept -> kstd::Result<kstd::usize> {
+        return _event_loop.poll(timeout_ms);
+    }
+
+    auto Reactor::run() noexcept -> kstd::Result<void> {
+        while(!_tasks.empty() && !_stop_requested.exchange(false, std::memory_order_acq_rel)) {
+            if(auto result = _event_loop.poll(); !result) {
+                return kstd::Error {result.get_error()};
+            }
+        }
+        return {};
+    }
+
+    auto Reactor::stop() noexcept -> void {
+        _stop_requested.store(true, std::memory_order_release);
+        _event_loop.stop();
+    }
+}// namespace sockslib
+#endif
+#endif
@@ -1,24 +1,26 @@
 #ifdef PLATFORM_LINUX
 #include "sockslib/resolve.hpp"
-#include <netdb.h>
-#include <arpa/inet.h>
-#include <netinet/in.h>
+#include "sockslib/dns_resolver.hpp"
+#include <algorithm>
 #include <unistd.h>
 
 namespace sockslib {
     auto resolve_address(std::string domain) noexcept -> kstd::Result<std::string> {
         using namespace std::string_literals;
-        const struct hostent *hostent = gethostbyname(domain.data());
-        if (hostent == nullptr) {
-            switch(h_errno) {
-                case HOST_NOT_FOUND: return kstd::Error { "The hsot was not found"s };
-                case NO_ADDRESS: return kstd::Error { "No address found with the domain"s };
-                case NO_RECOVERY: return kstd::Error { "A non-recoverable name server error occurred"s };
-                case TRY_AGAIN: return kstd::Error { "The name server is temporarily unavailable"s };
-            }
-        } else {
-            return std::string(inet_ntoa(*(struct in_addr*)hostent->h_addr));
+        auto addresses_result = DnsResolver::shared().resolve(domain);
+        if(!addresses_result) {
+            return kstd::Error {addresses_result.get_error()};
         }
+
+        // Prefer IPv4 addresses, which are reachable from more networks
+        const auto& addresses = addresses_result.get();
+        if(addresses.empty()) {
+            return kstd::Error {"No address found with the domain"s};
+        }
+        const auto address = std::find_if(addresses.begin(), addresses.end(), [](const SocketAddress& address) {
+            return address.address_type() == AddressType::IPV4;
+        });
+        return (address != addresses.end() ? *address : addresses.front()).address_to_string();
     }
 
     auto address_type_supported(AddressType type) noexcept -> kstd::Result<bool> {
@@ -28,4 +30,4 @@ namespace sockslib {
         return is_valid;
     }
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,130 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/server_socket_group.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <errno.h>
+#include <fmt/format.h>
+#include <linux/filter.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <system_error>
+#include <thread>
+
+namespace sockslib {
+    namespace {
+        constexpr auto accept_retry_delay = std::chrono::milliseconds {10};
+    }// namespace
+
+    ServerSocketGroup::ServerSocketGroup(const kstd::u16 port, const kstd::usize listener_count,
+                                         const bool steer_by_cpu) {
+        using namespace std::string_literals;
+        if(listener_count == 0) {
+            throw std::runtime_error {"Unable to initialize server socket group => No listeners requested!"s};
+        }
+
+        _server_sockets.reserve(listener_count);
+        for(kstd::usize i = 0; i < listener_count; ++i) {
+            _server_sockets.emplace_back(port, ProtocolType::TCP, true);
+        }
+
+        if(steer_by_cpu) {
+            attach_cpu_steering();
+        }
+    }
+
+    ServerSocketGroup::~ServerSocketGroup() noexcept {
+        stop();
+    }
+
+    auto ServerSocketGroup::operator=(ServerSocketGroup&& other) noexcept -> ServerSocketGroup& {
+        if(this == &other) {
+            return *this;
+        }
+
+        stop();
+        _server_sockets = std::move(other._server_sockets);
+        _worker_threads = std::move(other._worker_threads);
+        return *this;
+    }
+
+    auto ServerSocketGroup::attach_cpu_steering() const -> void {
+        // Return the index of the listener as receiving CPU modulo listener count, the index of a listener in the
+        // reuseport group is its bind order. Attaching the program to one listener applies it to the whole group.
+        std::array<sock_filter, 3> instructions {{
+                {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<kstd::u32>(SKF_AD_OFF + SKF_AD_CPU)},
+                {BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<kstd::u32>(_server_sockets.size())},
+                {BPF_RET | BPF_A, 0, 0, 0},
+        }};
+        sock_fprog program {static_cast<unsigned short>(instructions.size()), instructions.data()};
+        if(setsockopt(_server_sockets.front().socket_handle(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program,
+                      sizeof(program)) < 0) {
+            throw std::runtime_error {
+                    fmt::format("Unable to initialize server socket group => {}", get_last_error())};
+        }
+    }
+
+    auto ServerSocketGroup::start(ConnectionHandler handler, AcceptErrorHandler error_handler) noexcept
+            -> kstd::Result<void> {
+        using namespace std::string_literals;
+        if(!_worker_threads.empty()) {
+            return kstd::Error {"Unable to start server socket group => Group is already started!"s};
+        }
+
+        const auto cpu_count = std::max(std::thread::hardware_concurrency(), 1U);
+        for(kstd::usize i = 0; i < _server_sockets.size(); ++i) {
+            // The listeners keep their addresses when the group is moved, the group itself doesn't
+            const auto* server_socket = &_server_sockets[i];
+            try {
+                _worker_threads.emplace_back([server_socket, i, handler, error_handler] {
+                    while(true) {
+                        auto accept_result = server_socket->accept();
+                        if(!accept_result && accept_result.get_error().connection_reset()) {
+                            continue;// The peer gave up while the connection was queued
+                        }
+                        if(!accept_result && accept_result.get_error().code() == EINVAL) {
+                            return;// The listener was shut down
+                        }
+                        if(!accept_result) {
+                            // Errors like EMFILE persist for a while, so the worker backs off instead of spinning
+                            if(error_handler) {
+                                error_handler(i, accept_result.get_error());
+                            }
+                            std::this_thread::sleep_for(accept_retry_delay);
+                            continue;
+                        }
+                        handler(i, std::move(accept_result.get()));
+                    }
+                });
+            }
+            catch(const std::system_error& error) {
+                stop();
+                return kstd::Error {fmt::format("Unable to start server socket group => {}", error.what())};
+            }
+
+            // Pinning is best effort, the kernel may restrict the CPUs of this process
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            CPU_SET(i % cpu_count, &cpu_set);
+            pthread_setaffinity_np(_worker_threads.back().native_handle(), sizeof(cpu_set), &cpu_set);
+        }
+        return {};
+    }
+
+    auto ServerSocketGroup::stop() noexcept -> void {
+        // Shutting a listener down lets accept fail with EINVAL, which ends the worker
+        for(const auto& server_socket : _server_sockets) {
+            shutdown(server_socket.socket_handle(), SHUT_RD);
+        }
+
+        for(auto& thread : _worker_threads) {
+            if(thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+}// namespace sockslib
+#endif
@@ -1,23 +1,339 @@
 #ifdef PLATFORM_LINUX
 #include "sockslib/socket.hpp"
+#include "sockslib/buffer_pool.hpp"
+#include "sockslib/dns_resolver.hpp"
+#include "sockslib/reactor.hpp"
 
 #include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <fmt/format.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
 #include <stdexcept>
 #include <string.h>
 #include <sys/socket.h>
+#include <sys/sendfile.h>
+#include <sys/time.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#include <array>
 #include <cstdio>
+#include <exception>
+#include <new>
+#include <system_error>
+#include <type_traits>
 
 namespace sockslib {
+#ifdef KSTD_CPP_20
+    namespace {
+        // Upper bound of buffers per sendmsg/recvmsg call, which keeps the iovec array on the stack
+        constexpr kstd::usize max_vectored_buffers = 64;
+
+        template<typename T>
+        auto vectored_io(const SocketHandle socket_handle, SocketStatistics* statistics,
+                         const std::span<const std::span<T>> buffers, kstd::usize offset, const bool send) noexcept
+                -> kstd::isize {
+            std::array<iovec, max_vectored_buffers> iovecs {};
+            kstd::usize iovec_count = 0;
+            kstd::usize requested = 0;
+            for(const auto& buffer : buffers) {
+                if(iovec_count == iovecs.size()) {
+                    break;
+                }
+                iovecs[iovec_count].iov_base = const_cast<kstd::u8*>(buffer.data()) + offset;// NOLINT
+                iovecs[iovec_count].iov_len = buffer.size() - offset;
+                requested += iovecs[iovec_count].iov_len;
+                offset = 0;
+                ++iovec_count;
+            }
+
+            msghdr message {};
+            message.msg_iov = iovecs.data();
+            message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(iovec_count);
+            const auto operation = send ? IoOperation::WRITE : IoOperation::READ;
+            return measure_io(socket_handle, statistics, operation, requested, [&] {
+                return send ? ::sendmsg(socket_handle, &message, MSG_NOSIGNAL) : ::recvmsg(socket_handle, &message, 0);
+            });
+        }
+
+        auto write_all_vectored(const SocketHandle socket_handle, SocketStatistics* statistics,
+                                std::span<const std::span<const kstd::u8>> buffers) noexcept -> kstd::isize {
+            kstd::usize bytes_sent = 0;
+            kstd::usize offset = 0;
+            while(!buffers.empty()) {
+                if(offset == buffers.front().size()) {
+                    buffers = buffers.subspan(1);
+                    offset = 0;
+                    continue;
+                }
+
+                const auto result = vectored_io(socket_handle, statistics, buffers, offset, true);
+                if(result < 0) {
+                    if(errno == EINTR) {
+                        continue;
+                    }
+                    return result;
+                }
+
+                // Advance through the buffers by the count of sent bytes, the last one may be sent partially
+                bytes_sent += static_cast<kstd::usize>(result);
+                auto remaining = static_cast<kstd::usize>(result);
+                while(remaining > 0) {
+                    const auto available = buffers.front().size() - offset;
+                    if(remaining < available) {
+                        offset += remaining;
+                        break;
+                    }
+                    remaining -= available;
+                    buffers = buffers.subspan(1);
+                    offset = 0;
+                }
+            }
+            return static_cast<kstd::isize>(bytes_sent);
+        }
+    }// namespace
+#endif
+
+    namespace {
+        // Blocking calls only fail with EAGAIN once the timeout of the socket expired
+        auto blocking_error(const SocketOperation operation) noexcept -> SocketError {
+            if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                return {operation, ETIMEDOUT};
+            }
+            return SocketError::last(operation);
+        }
+
+        auto wait_until_ready(const SocketHandle socket_handle, const short events, const Deadline deadline,
+                              const SocketOperation operation) noexcept -> kstd::Result<void, SocketError> {
+            pollfd poll_handle {socket_handle, events, 0};
+            while(true) {
+                const auto result = ::poll(&poll_handle, 1, poll_timeout(deadline));
+                if(result > 0) {
+                    return {};
+                }
+                if(result == 0) {
+                    return kstd::Error {SocketError {operation, ETIMEDOUT}};
+                }
+                if(errno != EINTR) {
+                    return kstd::Error {SocketError::last(operation)};
+                }
+            }
+        }
+
+        // The operation is tried first, so poll is only called if it would block
+        auto transfer_until(const SocketHandle socket_handle, SocketStatistics* statistics, void* data,
+                            const kstd::usize size, const Deadline deadline, const bool send) noexcept
+                -> kstd::Result<kstd::usize, SocketError> {
+            const auto operation = send ? SocketOperation::WRITE : SocketOperation::READ;
+            const auto io_operation = send ? IoOperation::WRITE : IoOperation::READ;
+            while(true) {
+                const auto result = measure_io(socket_handle, statistics, io_operation, size, [&] {
+                    return send ? ::send(socket_handle, data, size, MSG_DONTWAIT | MSG_NOSIGNAL)
+                                : ::recv(socket_handle, data, size, MSG_DONTWAIT);
+                });
+                if(result >= 0) {
+                    return static_cast<kstd::usize>(result);
+                }
+                if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    return kstd::Error {SocketError::last(operation)};
+                }
+                if(auto wait_result = wait_until_ready(socket_handle, send ? POLLOUT : POLLIN, deadline, operation);
+                   !wait_result) {
+                    return kstd::Error {wait_result.get_error()};
+                }
+            }
+        }
+
+        // The buffer is only borrowed from the pool once the socket is read, an empty read returns it right away
+        auto read_pooled(const SocketHandle socket_handle, SocketStatistics* statistics, BufferPool& pool,
+                         const int flags) noexcept
+                -> kstd::Result<kstd::Option<PooledBuffer>, SocketError> {
+            auto buffer = pool.allocate();
+            if(!buffer) {
+                return kstd::Error {SocketError {SocketOperation::READ, ENOBUFS}};
+            }
+
+            auto& pooled_buffer = buffer.get();
+            const auto capacity = pooled_buffer.capacity();
+            const auto bytes_read = measure_io(socket_handle, statistics, IoOperation::READ, capacity, [&] {
+                return ::recv(socket_handle, pooled_buffer.data(), capacity, flags);
+            });
+            if(bytes_read < 0) {
+                if((flags & MSG_DONTWAIT) != 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    return {kstd::Option<PooledBuffer> {}};
+                }
+                return kstd::Error {SocketError::last(SocketOperation::READ)};
+            }
+            pooled_buffer.resize(static_cast<kstd::usize>(bytes_read));
+            return {kstd::Option<PooledBuffer> {std::move(pooled_buffer)}};
+        }
+
+        auto accept_failed(const SocketHandle socket_handle) noexcept -> bool {
+            return !handle_valid(socket_handle);
+        }
+
+        // All options are passed as int, the durations in the unit of the option
+        template<typename T>
+        auto set_option(const SocketHandle socket_handle, const int level, const int name,
+                        const kstd::Option<T>& option) noexcept -> bool {
+            if(!option) {
+                return true;
+            }
+            int value = 0;
+            if constexpr(std::is_integral_v<T>) {
+                value = static_cast<int>(option.get());
+            }
+            else {
+                value = static_cast<int>(option.get().count());
+            }
+            return setsockopt(socket_handle, level, name, &value, sizeof(value)) == 0;
+        }
+
+        // Options, which the protocol of the socket doesn't know, are left empty
+        template<typename T>
+        auto get_option(const SocketHandle socket_handle, const int level, const int name,
+                        kstd::Option<T>& option) noexcept -> bool {
+            int value = 0;
+            socklen_t value_size = sizeof(value);
+            if(getsockopt(socket_handle, level, name, &value, &value_size) < 0) {
+                return errno == ENOPROTOOPT || errno == EOPNOTSUPP;
+            }
+            option = T(value);
+            return true;
+        }
+
+        auto apply_options(const SocketHandle socket_handle, const SocketOptions& options) noexcept
+                -> kstd::Result<void, SocketError> {
+            if(!set_option(socket_handle, IPPROTO_TCP, TCP_NODELAY, options.no_delay) ||
+               !set_option(socket_handle, IPPROTO_TCP, TCP_QUICKACK, options.quick_ack) ||
+               !set_option(socket_handle, IPPROTO_TCP, TCP_CORK, options.cork) ||
+               !set_option(socket_handle, SOL_SOCKET, SO_SNDBUF, options.send_buffer_size) ||
+               !set_option(socket_handle, SOL_SOCKET, SO_RCVBUF, options.receive_buffer_size) ||
+               !set_option(socket_handle, SOL_SOCKET, SO_BUSY_POLL, options.busy_poll) ||
+               !set_option(socket_handle, IPPROTO_TCP, TCP_NOTSENT_LOWAT, options.not_sent_low_watermark) ||
+               !set_option(socket_handle, IPPROTO_TCP, TCP_FASTOPEN, options.fast_open) ||
+               !set_option(socket_handle, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, options.fast_open_connect) ||
+               !set_option(socket_handle, IPPROTO_TCP, TCP_DEFER_ACCEPT, options.defer_accept) ||
+               !set_option(socket_handle, SOL_SOCKET, SO_INCOMING_CPU, options.incoming_cpu)) {
+                return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+            }
+            return {};
+        }
+
+#ifdef KSTD_CPP_20
+        // The operation is tried first, so the socket is only registered in the reactor if it would block
+        template<typename S>
+        auto async_read_some(Reactor& reactor, const S& socket, kstd::u8* data, const kstd::usize size)
+                -> Task<kstd::Result<kstd::usize, SocketError>> {
+            while(true) {
+                auto result = socket.try_read(data, size);
+                if(result.is_error()) {
+                    co_return kstd::Error {result.get_error()};
+                }
+                if(!result.get().is_empty()) {
+                    co_return result.get().get();
+                }
+                if(auto wait_result = co_await reactor.wait(socket.socket_handle(), SocketOperation::READ);
+                   wait_result.is_error()) {
+                    co_return kstd::Error {wait_result.get_error()};
+                }
+            }
+        }
+
+        template<typename S>
+        auto async_write_all(Reactor& reactor, const S& socket, const void* data, const kstd::usize size)
+                -> Task<kstd::Result<kstd::usize, SocketError>> {
+            kstd::usize bytes_sent = 0;
+            while(bytes_sent < size) {
+                auto result = socket.try_write(static_cast<const kstd::u8*>(data) + bytes_sent, size - bytes_sent);
+                if(result.is_error()) {
+                    co_return kstd::Error {result.get_error()};
+                }
+                if(!result.get().is_empty()) {
+                    bytes_sent += result.get().get();
+                    continue;
+                }
+                if(auto wait_result = co_await reactor.wait(socket.socket_handle(), SocketOperation::WRITE);
+                   wait_result.is_error()) {
+                    co_return kstd::Error {wait_result.get_error()};
+                }
+            }
+            co_return bytes_sent;
+        }
+#endif
+    }// namespace
+
     Socket::Socket() :
             _socket_handle {invalid_socket_handle} {
     }
 
-    ServerSocket::ServerSocket(const kstd::u16 port, const ProtocolType protocol_type) :
+    auto Socket::set_blocking(const bool blocking) const noexcept -> kstd::Result<void> {
+        const auto flags = fcntl(_socket_handle, F_GETFL, 0);
+        if(flags < 0) {
+            return kstd::Error {fmt::format("Unable to change blocking mode of socket => {}", get_last_error())};
+        }
+
+        const auto new_flags = blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK);
+        if(new_flags != flags && fcntl(_socket_handle, F_SETFL, new_flags) < 0) {
+            return kstd::Error {fmt::format("Unable to change blocking mode of socket => {}", get_last_error())};
+        }
+        return {};
+    }
+
+    auto Socket::set_timeouts(const std::chrono::milliseconds read_timeout,
+                              const std::chrono::milliseconds write_timeout) const noexcept -> kstd::Result<void> {
+        const auto to_timeval = [](const std::chrono::milliseconds timeout) {
+            const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+            const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(timeout - seconds);
+            return timeval {static_cast<time_t>(seconds.count()), static_cast<suseconds_t>(microseconds.count())};
+        };
+
+        const auto read_value = to_timeval(read_timeout);
+        const auto write_value = to_timeval(write_timeout);
+        if(setsockopt(_socket_handle, SOL_SOCKET, SO_RCVTIMEO, &read_value, sizeof(read_value)) < 0 ||
+           setsockopt(_socket_handle, SOL_SOCKET, SO_SNDTIMEO, &write_value, sizeof(write_value)) < 0) {
+            return kstd::Error {fmt::format("Unable to change timeouts of socket => {}", get_last_error())};
+        }
+        return {};
+    }
+
+    auto Socket::set_options(const SocketOptions& options) const noexcept -> kstd::Result<void, SocketError> {
+        return apply_options(_socket_handle, options);
+    }
+
+    auto Socket::get_options() const noexcept -> kstd::Result<SocketOptions, SocketError> {
+        SocketOptions options {};
+        if(!get_option(_socket_handle, IPPROTO_TCP, TCP_NODELAY, options.no_delay) ||
+           !get_option(_socket_handle, IPPROTO_TCP, TCP_QUICKACK, options.quick_ack) ||
+           !get_option(_socket_handle, IPPROTO_TCP, TCP_CORK, options.cork) ||
+           !get_option(_socket_handle, SOL_SOCKET, SO_SNDBUF, options.send_buffer_size) ||
+           !get_option(_socket_handle, SOL_SOCKET, SO_RCVBUF, options.receive_buffer_size) ||
+           !get_option(_socket_handle, SOL_SOCKET, SO_BUSY_POLL, options.busy_poll) ||
+           !get_option(_socket_handle, IPPROTO_TCP, TCP_NOTSENT_LOWAT, options.not_sent_low_watermark) ||
+           !get_option(_socket_handle, IPPROTO_TCP, TCP_FASTOPEN, options.fast_open) ||
+           !get_option(_socket_handle, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, options.fast_open_connect) ||
+           !get_option(_socket_handle, IPPROTO_TCP, TCP_DEFER_ACCEPT, options.defer_accept) ||
+           !get_option(_socket_handle, SOL_SOCKET, SO_INCOMING_CPU, options.incoming_cpu)) {
+            return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+        }
+        return {std::move(options)};
+    }
+
+    ServerSocket::ServerSocket(const ProtocolType protocol_type, const SocketHandle socket_handle) noexcept :
             _protocol_type {protocol_type} {
+        _socket_handle = socket_handle;
+    }
+
+    ServerSocket::ServerSocket(const kstd::u16 port, const ProtocolType protocol_type, const bool reuse_port,
+                               const SocketOptions& options) :
+            ServerSocket(get_or_throw(create(port, protocol_type, reuse_port, options))) {
+    }
+
+    auto ServerSocket::create(const kstd::u16 port, const ProtocolType protocol_type, const bool reuse_port,
+                              const SocketOptions& options) noexcept -> kstd::Result<ServerSocket, SocketError> {
         // Create socket and validate socket
         kstd::u32 protocol = 0;
         switch(protocol_type) {
@@ -25,14 +341,26 @@ namespace sockslib {
             case ProtocolType::UDP: protocol = IPPROTO_UDP; break;
         }
 
-        _socket_handle = socket(AF_INET, static_cast<int>(protocol_type), protocol);
-        if(!handle_valid(_socket_handle)) {
-            throw std::runtime_error {fmt::format("Unable to initialize socket => {}", get_last_error())};
+        const auto socket_handle = socket(AF_INET, static_cast<int>(protocol_type), protocol);
+        if(!handle_valid(socket_handle)) {
+            return kstd::Error {SocketError::last(SocketOperation::CREATE)};
         }
 
-        // Force the socket to listen on the specific port
-        if(setsockopt(_socket_handle, SOL_SOCKET, SO_REUSEADDR | SO_REUSEPORT, &port, sizeof(&port))) {
-            throw std::runtime_error {fmt::format("Unable to initialize socket => {}", get_last_error())};
+        // The socket closes the handle if one of the following steps fails
+        ServerSocket server_socket {protocol_type, socket_handle};
+
+        // Allow rebinding the port while connections of a previous socket are in TIME_WAIT
+        const int enable = 1;
+        if(setsockopt(socket_handle, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+        }
+
+        // Share the port with other sockets, which have to enable this option before binding as well
+        if(reuse_port && setsockopt(socket_handle, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+        }
+        if(auto result = apply_options(socket_handle, options); !result) {
+            return kstd::Error {result.get_error()};
         }
 
         // Bind the socket
@@ -40,21 +368,23 @@ namespace sockslib {
         address.sin_family = AF_INET;
         address.sin_addr.s_addr = INADDR_ANY;
         address.sin_port = htons(port);
-        if(::bind(_socket_handle, (struct sockaddr*) &address, sizeof(address)) < 0) {
-            throw std::runtime_error {fmt::format("Unable to bind socket => {}", get_last_error())};
+        if(::bind(socket_handle, (struct sockaddr*) &address, sizeof(address)) < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::BIND)};
         }
 
         if(protocol_type != ProtocolType::UDP) {
             // Listen with the socket
-            if(::listen(_socket_handle, SOMAXCONN) < 0) {
-                throw std::runtime_error {fmt::format("Unable to listen with socket => {}", get_last_error())};
+            if(::listen(socket_handle, SOMAXCONN) < 0) {
+                return kstd::Error {SocketError::last(SocketOperation::LISTEN)};
             }
         }
+        return {std::move(server_socket)};
     }
 
     ServerSocket::ServerSocket(ServerSocket&& other) noexcept :
             _protocol_type {other._protocol_type} {
         Socket::_socket_handle = other._socket_handle;
+        _statistics = other._statistics;
         other._socket_handle = invalid_socket_handle;
     }
 
@@ -64,68 +394,235 @@ namespace sockslib {
         }
     }
 
-    auto ServerSocket::accept() const noexcept -> kstd::Result<AcceptedSocket> {
-        auto accepted_socket_handle = ::accept(_socket_handle, nullptr, nullptr);
+    auto ServerSocket::accept() const noexcept -> kstd::Result<AcceptedSocket, SocketError> {
+        auto accepted_socket_handle = measure_io(_socket_handle, _statistics, IoOperation::ACCEPT, 0, [&] {
+            return ::accept(_socket_handle, nullptr, nullptr);
+        }, accept_failed);
         if(!handle_valid(accepted_socket_handle)) {
-            return kstd::Error {fmt::format("Unable to accept socket => {}", get_last_error())};
+            return kstd::Error {blocking_error(SocketOperation::ACCEPT)};
         }
 
         return AcceptedSocket {accepted_socket_handle};
     }
 
+    auto ServerSocket::accept(const Deadline deadline) const noexcept -> kstd::Result<AcceptedSocket, SocketError> {
+        while(true) {
+            if(auto wait_result = wait_until_ready(_socket_handle, POLLIN, deadline, SocketOperation::ACCEPT);
+               !wait_result) {
+                return kstd::Error {wait_result.get_error()};
+            }
+
+            // A non-blocking listener fails with EAGAIN, if another thread took the connection in the meantime
+            const auto accepted_socket_handle = measure_io(_socket_handle, _statistics, IoOperation::ACCEPT, 0, [&] {
+                return ::accept(_socket_handle, nullptr, nullptr);
+            }, accept_failed);
+            if(handle_valid(accepted_socket_handle)) {
+                return AcceptedSocket {accepted_socket_handle};
+            }
+            if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                return kstd::Error {SocketError::last(SocketOperation::ACCEPT)};
+            }
+        }
+    }
+
+    auto ServerSocket::try_accept() const noexcept -> kstd::Result<kstd::Option<AcceptedSocket>, SocketError> {
+        auto accepted_socket_handle = measure_io(_socket_handle, _statistics, IoOperation::ACCEPT, 0, [&] {
+            return ::accept4(_socket_handle, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        }, accept_failed);
+        if(!handle_valid(accepted_socket_handle)) {
+            if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                return {kstd::Option<AcceptedSocket> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::ACCEPT)};
+        }
+
+        return {kstd::Option<AcceptedSocket> {AcceptedSocket {accepted_socket_handle}}};
+    }
+
+#ifdef KSTD_CPP_20
+    auto ServerSocket::async_accept(Reactor& reactor) const -> Task<kstd::Result<AcceptedSocket, SocketError>> {
+        const auto flags = fcntl(_socket_handle, F_GETFL, 0);
+        if(flags < 0 || ((flags & O_NONBLOCK) == 0 && fcntl(_socket_handle, F_SETFL, flags | O_NONBLOCK) < 0)) {
+            co_return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+        }
+
+        while(true) {
+            auto result = try_accept();
+            if(result.is_error()) {
+                co_return kstd::Error {result.get_error()};
+            }
+            if(!result.get().is_empty()) {
+                co_return std::move(result.get().get());
+            }
+            if(auto wait_result = co_await reactor.wait(_socket_handle, SocketOperation::ACCEPT);
+               wait_result.is_error()) {
+                co_return kstd::Error {wait_result.get_error()};
+            }
+        }
+    }
+#endif
+
     auto ServerSocket::operator=(ServerSocket&& other) noexcept -> ServerSocket& {
         _socket_handle = other._socket_handle;
+        _statistics = other._statistics;
         _protocol_type = other._protocol_type;
         other._socket_handle = invalid_socket_handle;
         return *this;
     }
 
-    ClientSocket::ClientSocket(std::string address, const kstd::u16 port, const ProtocolType protocol_type) {
-        using namespace std::string_literals;
+    ClientSocket::ClientSocket(const ProtocolType protocol_type, const SocketHandle socket_handle) noexcept :
+            _protocol_type {protocol_type} {
+        _socket_handle = socket_handle;
+    }
+
+    ClientSocket::ClientSocket(std::string address, const kstd::u16 port, const ProtocolType protocol_type,
+                               const SocketOptions& options) :
+            ClientSocket(get_or_throw(create(address, port, protocol_type, options))) {
+    }
+
+    ClientSocket::ClientSocket(const std::vector<SocketAddress>& addresses, const ProtocolType protocol_type,
+                               const std::chrono::milliseconds attempt_delay, const SocketOptions& options) :
+            ClientSocket(get_or_throw(create(addresses, protocol_type, attempt_delay, Deadline::max(), options))) {
+    }
 
+    auto ClientSocket::create(const std::string& address, const kstd::u16 port, const ProtocolType protocol_type,
+                              const SocketOptions& options, const Deadline deadline) noexcept
+            -> kstd::Result<ClientSocket, SocketError> {
+        constexpr std::chrono::milliseconds attempt_delay {250};
+
+        // Address literals are used as is, domains are resolved to all of their addresses
+        if(const auto literal_address = SocketAddress::from_literal(address, port); literal_address) {
+            return create(std::vector<SocketAddress> {literal_address.get()}, protocol_type, attempt_delay,
+                          deadline, options);
+        }
 #ifndef SOCKSLIB_NO_DNS_RESOLVE
-        // Resolve address if domain
         if(is_domain(address)) {
-            address = resolve_address(address).get_or_throw();
+            // The shared resolver starts its worker threads on first use, which may throw
+            try {
+                const auto addresses = DnsResolver::shared().resolve_addresses(address, port);
+                if(!addresses) {
+                    return kstd::Error {addresses.get_error()};
+                }
+                return create(addresses.get(), protocol_type, attempt_delay, deadline, options);
+            }
+            catch(const std::system_error& error) {
+                return kstd::Error {SocketError {SocketOperation::RESOLVE, error.code().value()}};
+            }
+            catch(const std::bad_alloc&) {
+                return kstd::Error {SocketError {SocketOperation::RESOLVE, ENOMEM}};
+            }
+            catch(const std::exception&) {
+                return kstd::Error {SocketError {SocketOperation::RESOLVE, EINVAL}};
+            }
         }
 #endif
-        const auto address_type_result = recognize_address_type(address);
-        if(!address_type_result) {
-            throw std::runtime_error {
-                    fmt::format("Unable to initialize socket => Unable to recognize address protocol")};
-        }
-        const auto address_type = static_cast<int>(address_type_result.get());
-
-        // Create socket and validate socket
-        _socket_handle = socket(address_type, static_cast<int>(protocol_type), 0);
-        if(!handle_valid(_socket_handle)) {
-            throw std::runtime_error {fmt::format("Unable to initialize socket => {}", get_last_error())};
-        }
+        return kstd::Error {SocketError {SocketOperation::RESOLVE, EINVAL}};
+    }
 
-        // Convert address to binary representation
-        struct sockaddr_in sockaddr {};
-        sockaddr.sin_family = address_type;
-        sockaddr.sin_port = htons(port);
+    auto ClientSocket::create(const std::vector<SocketAddress>& addresses, const ProtocolType protocol_type,
+                              const std::chrono::milliseconds attempt_delay, const Deadline deadline,
+                              const SocketOptions& options) noexcept -> kstd::Result<ClientSocket, SocketError> {
+        using clock = std::chrono::steady_clock;
+        const auto ordered_addresses = interleave_address_families(addresses);
+        std::vector<pollfd> attempts {};
+        SocketError last_error {SocketOperation::CONNECT, EADDRNOTAVAIL};
+        SocketHandle socket_handle = invalid_socket_handle;
+        kstd::usize next_address = 0;
+        auto next_attempt_time = clock::now();
+
+        while(!handle_valid(socket_handle)) {
+            const auto now = clock::now();
+            if(now >= deadline) {
+                last_error = SocketError {SocketOperation::CONNECT, ETIMEDOUT};
+                break;
+            }
+            if(next_address < ordered_addresses.size() && (now >= next_attempt_time || attempts.empty())) {
+                const auto& address = ordered_addresses[next_address++];
+                const auto attempt_handle = ::socket(address.data()->sa_family,
+                                                     static_cast<int>(protocol_type) | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+                if(!handle_valid(attempt_handle)) {
+                    last_error = SocketError::last(SocketOperation::CREATE);
+                    continue;
+                }
+                if(auto result = apply_options(attempt_handle, options); !result) {
+                    last_error = result.get_error();
+                    close(attempt_handle);
+                    continue;
+                }
+
+                // UDP sockets and TCP connections over loopback may connect immediately
+                const auto connect_result = trace_call(TraceEvent::CONNECT, attempt_handle, [&] {
+                    return ::connect(attempt_handle, address.data(), address.length());
+                });
+                if(connect_result == 0) {
+                    socket_handle = attempt_handle;
+                    break;
+                }
+                if(errno != EINPROGRESS) {
+                    last_error = SocketError::last(SocketOperation::CONNECT);
+                    close(attempt_handle);
+                    continue;
+                }
+                attempts.push_back({attempt_handle, POLLOUT, 0});
+                next_attempt_time = now + attempt_delay;
+                continue;
+            }
+            if(attempts.empty()) {
+                break;
+            }
 
-        if(inet_pton(AF_INET, address.c_str(), &sockaddr.sin_addr) <= 0) {
-            // Free address info and close socket
-            close(_socket_handle);
+            // Wait for the outcome of a running attempt, but not longer than until the next attempt or the deadline
+            auto timeout_ms = poll_timeout(deadline);
+            if(next_address < ordered_addresses.size()) {
+                const auto attempt_timeout_ms = static_cast<int>(
+                        std::chrono::ceil<std::chrono::milliseconds>(next_attempt_time - now).count());
+                if(timeout_ms < 0 || attempt_timeout_ms < timeout_ms) {
+                    timeout_ms = attempt_timeout_ms;
+                }
+            }
+            if(::poll(attempts.data(), attempts.size(), timeout_ms) < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                last_error = SocketError::last(SocketOperation::CONNECT);
+                break;
+            }
 
-            throw std::runtime_error {
-                    "Unable to connect with socket => Failed conversion of literal address to binary address!"s};
+            for(auto attempt = attempts.begin(); attempt != attempts.end();) {
+                if(attempt->revents == 0) {
+                    ++attempt;
+                    continue;
+                }
+
+                int error = 0;
+                socklen_t error_size = sizeof(error);
+                getsockopt(attempt->fd, SOL_SOCKET, SO_ERROR, &error, &error_size);
+                if(error == 0) {
+                    socket_handle = attempt->fd;
+                    attempts.erase(attempt);
+                    break;
+                }
+
+                // A failed attempt starts the next one right away
+                last_error = SocketError {SocketOperation::CONNECT, error};
+                close(attempt->fd);
+                attempt = attempts.erase(attempt);
+                next_attempt_time = clock::now();
+            }
         }
 
-        if(::connect(_socket_handle, reinterpret_cast<struct sockaddr*>(&sockaddr), sizeof(sockaddr)) < 0) {
-            // Free address info and close socket
-            close(_socket_handle);
+        for(const auto& attempt : attempts) {
+            close(attempt.fd);
+        }
+        if(!handle_valid(socket_handle)) {
+            return kstd::Error {last_error};
+        }
 
-            auto last_error = get_last_error();
-            if(last_error.empty()) {
-                throw std::runtime_error {
-                        "Unable to connect with socket => Establishment of connection with server failed! Maybe the server isn't reachable?"s};
-            }
-            throw std::runtime_error {fmt::format("Unable to connect with socket => {}", last_error)};
+        ClientSocket client_socket {protocol_type, socket_handle};
+        if(fcntl(socket_handle, F_SETFL, fcntl(socket_handle, F_GETFL, 0) & ~O_NONBLOCK) < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
         }
+        return {std::move(client_socket)};
     }
 
     ClientSocket::~ClientSocket() noexcept {
@@ -135,49 +632,190 @@ namespace sockslib {
         }
     }
 
-    auto ClientSocket::write(void* data, kstd::usize data_size) const noexcept -> kstd::Result<kstd::usize> {
-        using namespace std::string_literals;
+    auto ClientSocket::write(void* data, kstd::usize data_size) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
         if(data_size > std::numeric_limits<int>::max()) {
             data_size = std::numeric_limits<int>::max();
         }
 
-        auto bytes_sent = ::send(_socket_handle, static_cast<const char*>(data), static_cast<int>(data_size), 0);
+        auto bytes_sent = measure_io(_socket_handle, _statistics, IoOperation::WRITE, data_size, [&] {
+            return ::send(_socket_handle, static_cast<const char*>(data), static_cast<int>(data_size), 0);
+        });
         if(bytes_sent <= 0) {
-            return kstd::Error {fmt::format("Unable to write to socket => {}", get_last_error())};
+            return kstd::Error {blocking_error(SocketOperation::WRITE)};
         }
         return bytes_sent;
     }
 
-    ClientSocket::ClientSocket(ClientSocket&& other) noexcept {
+    ClientSocket::ClientSocket(ClientSocket&& other) noexcept :
+            _protocol_type {other._protocol_type} {
         _socket_handle = other._socket_handle;
+        _statistics = other._statistics;
         other._socket_handle = invalid_socket_handle;
     }
 
-    auto ClientSocket::read(kstd::u8* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize> {
-        using namespace std::string_literals;
+    auto ClientSocket::read(kstd::u8* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize, SocketError> {
         if(!handle_valid(_socket_handle)) {
-            return kstd::Error {"Unable to read from socket => Socket handle is invalid!"s};
+            return kstd::Error {SocketError {SocketOperation::READ, EBADF}};
         }
 
         if(size > std::numeric_limits<int>::max()) {
             size = std::numeric_limits<int>::max();
         }
 
-        auto bytes_read = ::recv(_socket_handle, reinterpret_cast<char*>(data), static_cast<int>(size), 0);// NOLINT
+        auto bytes_read = measure_io(_socket_handle, _statistics, IoOperation::READ, size, [&] {
+            return ::recv(_socket_handle, reinterpret_cast<char*>(data), static_cast<int>(size), 0);// NOLINT
+        });
         if(bytes_read < 0) {
-            return kstd::Error {fmt::format("Unable to read from socket => {}", get_last_error())};
+            return kstd::Error {blocking_error(SocketOperation::READ)};
         }
         return bytes_read;
     }
 
+    auto ClientSocket::write(const void* data, const kstd::usize size, const Deadline deadline) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        return transfer_until(_socket_handle, _statistics, const_cast<void*>(data), size, deadline, true);// NOLINT
+    }
+
+    auto ClientSocket::read(kstd::u8* data, const kstd::usize size, const Deadline deadline) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        return transfer_until(_socket_handle, _statistics, data, size, deadline, false);
+    }
+
 #ifdef KSTD_CPP_20
-    auto ClientSocket::read(std::span<kstd::u8> data) const noexcept -> kstd::Result<kstd::usize> {
+    auto ClientSocket::read(std::span<kstd::u8> data) const noexcept -> kstd::Result<kstd::usize, SocketError> {
         return read(data.data(), data.size());
     }
+
+    auto ClientSocket::write(std::span<const std::span<const kstd::u8>> buffers) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_sent = vectored_io(_socket_handle, _statistics, buffers, 0, true);
+        if(bytes_sent < 0) {
+            return kstd::Error {blocking_error(SocketOperation::WRITE)};
+        }
+        return static_cast<kstd::usize>(bytes_sent);
+    }
+
+    auto ClientSocket::read(std::span<const std::span<kstd::u8>> buffers) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_read = vectored_io(_socket_handle, _statistics, buffers, 0, false);
+        if(bytes_read < 0) {
+            return kstd::Error {blocking_error(SocketOperation::READ)};
+        }
+        return static_cast<kstd::usize>(bytes_read);
+    }
+
+    auto ClientSocket::write_all(std::span<const std::span<const kstd::u8>> buffers) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_sent = write_all_vectored(_socket_handle, _statistics, buffers);
+        if(bytes_sent < 0) {
+            return kstd::Error {blocking_error(SocketOperation::WRITE)};
+        }
+        return static_cast<kstd::usize>(bytes_sent);
+    }
 #endif
 
+    auto ClientSocket::try_write(const void* data, kstd::usize size) const noexcept
+            -> kstd::Result<kstd::Option<kstd::usize>, SocketError> {
+        auto bytes_sent = measure_io(_socket_handle, _statistics, IoOperation::WRITE, size, [&] {
+            return ::send(_socket_handle, data, size, MSG_DONTWAIT | MSG_NOSIGNAL);
+        });
+        if(bytes_sent < 0) {
+            if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                return {kstd::Option<kstd::usize> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+        }
+        return {kstd::Option<kstd::usize> {static_cast<kstd::usize>(bytes_sent)}};
+    }
+
+    auto ClientSocket::try_read(kstd::u8* data, kstd::usize size) const noexcept
+            -> kstd::Result<kstd::Option<kstd::usize>, SocketError> {
+        auto bytes_read = measure_io(_socket_handle, _statistics, IoOperation::READ, size, [&] {
+            return ::recv(_socket_handle, data, size, MSG_DONTWAIT);
+        });
+        if(bytes_read < 0) {
+            if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                return {kstd::Option<kstd::usize> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
+        }
+        return {kstd::Option<kstd::usize> {static_cast<kstd::usize>(bytes_read)}};
+    }
+
+    auto ClientSocket::read(BufferPool& pool) const noexcept -> kstd::Result<PooledBuffer, SocketError> {
+        auto result = read_pooled(_socket_handle, _statistics, pool, 0);
+        if(!result) {
+            return kstd::Error {result.get_error()};
+        }
+        return {std::move(result.get().get())};
+    }
+
+    auto ClientSocket::try_read(BufferPool& pool) const noexcept
+            -> kstd::Result<kstd::Option<PooledBuffer>, SocketError> {
+        return read_pooled(_socket_handle, _statistics, pool, MSG_DONTWAIT);
+    }
+
+#ifdef KSTD_CPP_20
+    auto ClientSocket::async_connect(Reactor& reactor, const SocketAddress address, const ProtocolType protocol_type)
+            -> Task<kstd::Result<ClientSocket, SocketError>> {
+        const auto socket_handle = ::socket(address.data()->sa_family,
+                                            static_cast<int>(protocol_type) | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if(!handle_valid(socket_handle)) {
+            co_return kstd::Error {SocketError::last(SocketOperation::CREATE)};
+        }
+
+        // The socket closes the handle if the connection fails
+        ClientSocket client_socket {protocol_type, socket_handle};
+        const auto connect_result = trace_call(TraceEvent::CONNECT, socket_handle, [&] {
+            return ::connect(socket_handle, address.data(), address.length());
+        });
+        if(connect_result < 0) {
+            if(errno != EINPROGRESS) {
+                co_return kstd::Error {SocketError::last(SocketOperation::CONNECT)};
+            }
+            if(auto wait_result = co_await reactor.wait(socket_handle, SocketOperation::CONNECT);
+               wait_result.is_error()) {
+                co_return kstd::Error {wait_result.get_error()};
+            }
+
+            int error = 0;
+            socklen_t error_size = sizeof(error);
+            getsockopt(socket_handle, SOL_SOCKET, SO_ERROR, &error, &error_size);
+            if(error != 0) {
+                co_return kstd::Error {SocketError {SocketOperation::CONNECT, error}};
+            }
+        }
+        co_return std::move(client_socket);
+    }
+
+    auto ClientSocket::async_read(Reactor& reactor, kstd::u8* data, const kstd::usize size) const
+            -> Task<kstd::Result<kstd::usize, SocketError>> {
+        return async_read_some(reactor, *this, data, size);
+    }
+
+    auto ClientSocket::async_write(Reactor& reactor, const void* data, const kstd::usize size) const
+            -> Task<kstd::Result<kstd::usize, SocketError>> {
+        return async_write_all(reactor, *this, data, size);
+    }
+#endif
+
+    auto ClientSocket::try_peek(kstd::u8* data, kstd::usize size) const noexcept
+            -> kstd::Result<kstd::Option<kstd::usize>, SocketError> {
+        auto bytes_read = ::recv(_socket_handle, data, size, MSG_PEEK | MSG_DONTWAIT);
+        if(bytes_read < 0) {
+            if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                return {kstd::Option<kstd::usize> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
+        }
+        return {kstd::Option<kstd::usize> {static_cast<kstd::usize>(bytes_read)}};
+    }
+
     auto ClientSocket::operator=(ClientSocket&& other) noexcept -> ClientSocket& {
         _socket_handle = other._socket_handle;
+        _statistics = other._statistics;
+        _protocol_type = other._protocol_type;
         other._socket_handle = invalid_socket_handle;
         return *this;
     }
@@ -188,6 +826,7 @@ namespace sockslib {
 
     AcceptedSocket::AcceptedSocket(AcceptedSocket&& other) noexcept {// NOLINT
         _socket_handle = other._socket_handle;
+        _statistics = other._statistics;
         other._socket_handle = invalid_socket_handle;
     }
 
@@ -198,48 +837,172 @@ namespace sockslib {
         }
     }
 
-    auto AcceptedSocket::write(void* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize> {
-        using namespace std::string_literals;
+    auto AcceptedSocket::write(void* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize, SocketError> {
         if(!handle_valid(_socket_handle)) {
-            return kstd::Error {"Unable to write with socket => Socket handle is invalid!"s};
+            return kstd::Error {SocketError {SocketOperation::WRITE, EBADF}};
         }
 
         if(size > std::numeric_limits<int>::max()) {
             size = std::numeric_limits<int>::max();
         }
 
-        auto bytes_sent = ::send(_socket_handle, static_cast<const char*>(data), static_cast<int>(size), 0);
+        auto bytes_sent = measure_io(_socket_handle, _statistics, IoOperation::WRITE, size, [&] {
+            return ::send(_socket_handle, static_cast<const char*>(data), static_cast<int>(size), 0);
+        });
         if(bytes_sent < 0) {
-            return kstd::Error {fmt::format("Unable to write with socket => {}", get_last_error())};
+            return kstd::Error {blocking_error(SocketOperation::WRITE)};
         }
         return bytes_sent;
     }
 
-    auto AcceptedSocket::read(kstd::u8* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize> {
-        using namespace std::string_literals;
+    auto AcceptedSocket::read(kstd::u8* data, kstd::usize size) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
         if(!handle_valid(_socket_handle)) {
-            return kstd::Error {"Unable to read from socket => Socket handle is invalid!"s};
+            return kstd::Error {SocketError {SocketOperation::READ, EBADF}};
         }
 
         if(size > std::numeric_limits<int>::max()) {
             size = std::numeric_limits<int>::max();
         }
 
-        auto bytes_read = ::recv(_socket_handle, reinterpret_cast<char*>(data), static_cast<int>(size), 0);// NOLINT
+        auto bytes_read = measure_io(_socket_handle, _statistics, IoOperation::READ, size, [&] {
+            return ::recv(_socket_handle, reinterpret_cast<char*>(data), static_cast<int>(size), 0);// NOLINT
+        });
         if(bytes_read < 0) {
-            return kstd::Error {fmt::format("Unable to read from socket => {}", get_last_error())};
+            return kstd::Error {blocking_error(SocketOperation::READ)};
         }
         return bytes_read;
     }
 
+    auto AcceptedSocket::write(const void* data, const kstd::usize size, const Deadline deadline) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        return transfer_until(_socket_handle, _statistics, const_cast<void*>(data), size, deadline, true);// NOLINT
+    }
+
+    auto AcceptedSocket::read(kstd::u8* data, const kstd::usize size, const Deadline deadline) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        return transfer_until(_socket_handle, _statistics, data, size, deadline, false);
+    }
+
 #ifdef KSTD_CPP_20
-    auto AcceptedSocket::read(std::span<kstd::u8> data) const noexcept -> kstd::Result<kstd::usize> {
+    auto AcceptedSocket::read(std::span<kstd::u8> data) const noexcept -> kstd::Result<kstd::usize, SocketError> {
         return read(data.data(), data.size());
     }
+
+    auto AcceptedSocket::write(std::span<const std::span<const kstd::u8>> buffers) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_sent = vectored_io(_socket_handle, _statistics, buffers, 0, true);
+        if(bytes_sent < 0) {
+            return kstd::Error {blocking_error(SocketOperation::WRITE)};
+        }
+        return static_cast<kstd::usize>(bytes_sent);
+    }
+
+    auto AcceptedSocket::read(std::span<const std::span<kstd::u8>> buffers) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_read = vectored_io(_socket_handle, _statistics, buffers, 0, false);
+        if(bytes_read < 0) {
+            return kstd::Error {blocking_error(SocketOperation::READ)};
+        }
+        return static_cast<kstd::usize>(bytes_read);
+    }
+
+    auto AcceptedSocket::write_all(std::span<const std::span<const kstd::u8>> buffers) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_sent = write_all_vectored(_socket_handle, _statistics, buffers);
+        if(bytes_sent < 0) {
+            return kstd::Error {blocking_error(SocketOperation::WRITE)};
+        }
+        return static_cast<kstd::usize>(bytes_sent);
+    }
+#endif
+
+    auto AcceptedSocket::try_write(const void* data, kstd::usize size) const noexcept
+            -> kstd::Result<kstd::Option<kstd::usize>, SocketError> {
+        auto bytes_sent = measure_io(_socket_handle, _statistics, IoOperation::WRITE, size, [&] {
+            return ::send(_socket_handle, data, size, MSG_DONTWAIT | MSG_NOSIGNAL);
+        });
+        if(bytes_sent < 0) {
+            if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                return {kstd::Option<kstd::usize> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+        }
+        return {kstd::Option<kstd::usize> {static_cast<kstd::usize>(bytes_sent)}};
+    }
+
+    auto AcceptedSocket::try_read(kstd::u8* data, kstd::usize size) const noexcept
+            -> kstd::Result<kstd::Option<kstd::usize>, SocketError> {
+        auto bytes_read = measure_io(_socket_handle, _statistics, IoOperation::READ, size, [&] {
+            return ::recv(_socket_handle, data, size, MSG_DONTWAIT);
+        });
+        if(bytes_read < 0) {
+            if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                return {kstd::Option<kstd::usize> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
+        }
+        return {kstd::Option<kstd::usize> {static_cast<kstd::usize>(bytes_read)}};
+    }
+
+    auto AcceptedSocket::read(BufferPool& pool) const noexcept -> kstd::Result<PooledBuffer, SocketError> {
+        auto result = read_pooled(_socket_handle, _statistics, pool, 0);
+        if(!result) {
+            return kstd::Error {result.get_error()};
+        }
+        return {std::move(result.get().get())};
+    }
+
+    auto AcceptedSocket::try_read(BufferPool& pool) const noexcept
+            -> kstd::Result<kstd::Option<PooledBuffer>, SocketError> {
+        return read_pooled(_socket_handle, _statistics, pool, MSG_DONTWAIT);
+    }
+
+#ifdef KSTD_CPP_20
+    auto AcceptedSocket::async_read(Reactor& reactor, kstd::u8* data, const kstd::usize size) const
+            -> Task<kstd::Result<kstd::usize, SocketError>> {
+        return async_read_some(reactor, *this, data, size);
+    }
+
+    auto AcceptedSocket::async_write(Reactor& reactor, const void* data, const kstd::usize size) const
+            -> Task<kstd::Result<kstd::usize, SocketError>> {
+        return async_write_all(reactor, *this, data, size);
+    }
 #endif
 
+    auto AcceptedSocket::send_file(const int file_handle, const kstd::u64 offset,
+                                   const kstd::usize length) const noexcept -> kstd::Result<kstd::usize, SocketError> {
+        if(!handle_valid(_socket_handle)) {
+            return kstd::Error {SocketError {SocketOperation::WRITE, EBADF}};
+        }
+
+        // sendfile transfers at most ~2GB per call, so larger ranges take multiple calls
+        auto file_offset = static_cast<off_t>(offset);
+        kstd::usize bytes_sent = 0;
+        while(bytes_sent < length) {
+            const auto result = measure_io(_socket_handle, _statistics, IoOperation::WRITE, length - bytes_sent, [&] {
+                return ::sendfile(_socket_handle, file_handle, &file_offset, length - bytes_sent);
+            });
+            if(result < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                if((errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    break;
+                }
+                return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+            }
+            if(result == 0) {
+                break;
+            }
+            bytes_sent += static_cast<kstd::usize>(result);
+        }
+        return bytes_sent;
+    }
+
     auto AcceptedSocket::operator=(AcceptedSocket&& other) noexcept -> AcceptedSocket& {
         _socket_handle = other._socket_handle;
+        _statistics = other._statistics;
         other._socket_handle = invalid_socket_handle;
         return *this;
     }
@@ -0,0 +1,143 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/splice_relay.hpp"
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace sockslib {
+    SpliceRelay::SpliceRelay(const kstd::usize pipe_size) :
+            _pipe_read_handle {-1},
+            _pipe_write_handle {-1},
+            _pipe_size {0},
+            _pending_size {0} {
+        int pipe_handles[2];// NOLINT
+        if(::pipe2(pipe_handles, O_CLOEXEC) < 0) {
+            throw std::runtime_error {fmt::format("Unable to create pipe => {}", get_last_error())};
+        }
+        _pipe_read_handle = pipe_handles[0];
+        _pipe_write_handle = pipe_handles[1];
+
+        // A failed resize keeps the default size, so only the size is queried afterwards
+        ::fcntl(_pipe_write_handle, F_SETPIPE_SZ, static_cast<int>(pipe_size));
+        const auto actual_size = ::fcntl(_pipe_write_handle, F_GETPIPE_SZ);
+        if(actual_size < 0) {
+            release();
+            throw std::runtime_error {fmt::format("Unable to get size of pipe => {}", get_last_error())};
+        }
+        _pipe_size = static_cast<kstd::usize>(actual_size);
+    }
+
+    SpliceRelay::SpliceRelay(SpliceRelay&& other) noexcept :
+            _pipe_read_handle {other._pipe_read_handle},
+            _pipe_write_handle {other._pipe_write_handle},
+            _pipe_size {other._pipe_size},
+            _pending_size {other._pending_size} {
+        other._pipe_read_handle = -1;
+        other._pipe_write_handle = -1;
+        other._pending_size = 0;
+    }
+
+    SpliceRelay::~SpliceRelay() noexcept {
+        release();
+    }
+
+    auto SpliceRelay::release() noexcept -> void {
+        if(_pipe_read_handle >= 0) {
+            ::close(_pipe_read_handle);
+            _pipe_read_handle = -1;
+        }
+        if(_pipe_write_handle >= 0) {
+            ::close(_pipe_write_handle);
+            _pipe_write_handle = -1;
+        }
+    }
+
+    auto SpliceRelay::forward(const SocketHandle source, const SocketHandle destination,
+                              const kstd::usize max_size) noexcept -> kstd::Result<kstd::Option<kstd::usize>> {
+        // Drain the bytes of a previous call first, otherwise the order of the stream breaks
+        const auto drain = [&]() -> kstd::Result<bool> {
+            // SPLICE_F_MORE would hold the tail of the message back in the socket (MSG_MORE), so it isn't passed here
+            while(_pending_size > 0) {
+                const auto result =
+                        ::splice(_pipe_read_handle, nullptr, destination, nullptr, _pending_size, SPLICE_F_MOVE);
+                if(result < 0) {
+                    if(errno == EINTR) {
+                        continue;
+                    }
+                    if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                        return false;
+                    }
+                    return kstd::Error {fmt::format("Unable to forward to socket => {}", get_last_error())};
+                }
+                _pending_size -= static_cast<kstd::usize>(result);
+            }
+            return true;
+        };
+
+        const auto drained = drain();
+        if(!drained) {
+            return kstd::Error {drained.get_error()};
+        }
+        if(!drained.get()) {
+            return {kstd::Option<kstd::usize> {}};
+        }
+
+        kstd::isize bytes_read = 0;
+        do {
+            bytes_read = ::splice(source, nullptr, _pipe_write_handle, nullptr, std::min(max_size, _pipe_size),
+                                  SPLICE_F_MOVE | SPLICE_F_MORE);
+        } while(bytes_read < 0 && errno == EINTR);
+        if(bytes_read < 0) {
+            if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                return {kstd::Option<kstd::usize> {}};
+            }
+            return kstd::Error {fmt::format("Unable to forward from socket => {}", get_last_error())};
+        }
+        _pending_size = static_cast<kstd::usize>(bytes_read);
+
+        // Bytes, which the destination doesn't take yet, stay pending for the next call
+        const auto forwarded = drain();
+        if(!forwarded) {
+            return kstd::Error {forwarded.get_error()};
+        }
+        return {kstd::Option<kstd::usize> {static_cast<kstd::usize>(bytes_read)}};
+    }
+
+    auto SpliceRelay::forward_all(const SocketHandle source, const SocketHandle destination) noexcept
+            -> kstd::Result<kstd::usize> {
+        using namespace std::string_literals;
+        kstd::usize bytes_forwarded = 0;
+        while(true) {
+            const auto result = forward(source, destination, _pipe_size);
+            if(!result) {
+                return kstd::Error {result.get_error()};
+            }
+            if(!result.get()) {
+                return kstd::Error {"Unable to forward between sockets => Socket would block!"s};
+            }
+            if(result.get().get() == 0) {
+                break;
+            }
+            bytes_forwarded += result.get().get();
+        }
+        return bytes_forwarded;
+    }
+
+    auto SpliceRelay::operator=(SpliceRelay&& other) noexcept -> SpliceRelay& {
+        release();
+        _pipe_read_handle = other._pipe_read_handle;
+        _pipe_write_handle = other._pipe_write_handle;
+        _pipe_size = other._pipe_size;
+        _pending_size = other._pending_size;
+        other._pipe_read_handle = -1;
+        other._pipe_write_handle = -1;
+        other._pending_size = 0;
+        return *this;
+    }
+}// namespace sockslib
+#endif
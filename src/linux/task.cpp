@@ -0,0 +1,86 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/task.hpp"
+
+#ifdef KSTD_CPP_20
+#include <array>
+#include <new>
+
+namespace sockslib {
+    namespace detail {
+        namespace {
+            constexpr std::size_t frame_alignment = 64;
+            constexpr std::size_t size_class_count = 32;// Frames up to 2KB are pooled
+            constexpr std::size_t max_cached_frames = 1024;// Per size class and thread
+
+            struct FreeFrame final {
+                FreeFrame* next;
+            };
+
+            // Frames may be released by another thread than the allocating one, they just change the freelist then
+            struct FrameCache final {
+                std::array<FreeFrame*, size_class_count> free_lists {};
+                std::array<std::size_t, size_class_count> cached_counts {};
+                kstd::usize reused_count = 0;
+
+                FrameCache() noexcept = default;
+                FrameCache(const FrameCache& other) = delete;
+                FrameCache(FrameCache&& other) = delete;
+
+                ~FrameCache() noexcept {
+                    for(auto* frame : free_lists) {
+                        while(frame != nullptr) {
+                            auto* next = frame->next;
+                            ::operator delete(frame, std::align_val_t {frame_alignment});
+                            frame = next;
+                        }
+                    }
+                }
+
+                auto operator=(const FrameCache& other) -> FrameCache& = delete;
+                auto operator=(FrameCache&& other) -> FrameCache& = delete;
+            };
+
+            thread_local FrameCache frame_cache {};
+
+            [[nodiscard]] constexpr auto size_class(const std::size_t size) noexcept -> std::size_t {
+                return (size + frame_alignment - 1) / frame_alignment - 1;
+            }
+        }// namespace
+
+        auto allocate_frame(const std::size_t size) -> void* {
+            const auto index = size_class(size);
+            if(index >= size_class_count) {
+                return ::operator new(size, std::align_val_t {frame_alignment});
+            }
+
+            auto& cache = frame_cache;
+            if(auto* frame = cache.free_lists[index]; frame != nullptr) {
+                cache.free_lists[index] = frame->next;
+                --cache.cached_counts[index];
+                ++cache.reused_count;
+                return frame;
+            }
+            return ::operator new((index + 1) * frame_alignment, std::align_val_t {frame_alignment});
+        }
+
+        auto release_frame(void* frame, const std::size_t size) noexcept -> void {
+            const auto index = size_class(size);
+            auto& cache = frame_cache;
+            if(index >= size_class_count || cache.cached_counts[index] >= max_cached_frames) {
+                ::operator delete(frame, std::align_val_t {frame_alignment});
+                return;
+            }
+
+            auto* free_frame = static_cast<FreeFrame*>(frame);
+            free_frame->next = cache.free_lists[index];
+            cache.free_lists[index] = free_frame;
+            ++cache.cached_counts[index];
+        }
+
+        auto reused_frame_count() noexcept -> kstd::usize {
+            return frame_cache.reused_count;
+        }
+    }// namespace detail
+}// namespace sockslib
+#endif
+#endif
@@ -0,0 +1,35 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/tcp_info.hpp"
+
+// The tcp_info of glibc stops at tcpi_total_retrans, so the one of the kernel headers is used
+#include <errno.h>
+#include <linux/tcp.h>
+#include <netinet/in.h>
+#include <stddef.h>
+#include <sys/socket.h>
+
+namespace sockslib {
+    auto get_tcp_info(const SocketHandle socket_handle) noexcept -> kstd::Result<TcpInfo, SocketError> {
+        tcp_info info {};
+        socklen_t info_size = sizeof(info);
+        if(getsockopt(socket_handle, IPPROTO_TCP, TCP_INFO, &info, &info_size) < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+        }
+
+        // Segments, which are neither SACKed nor lost, plus the retransmitted ones (tcp_packets_in_flight)
+        const auto segments_in_flight = info.tcpi_unacked - info.tcpi_sacked - info.tcpi_lost + info.tcpi_retrans;
+        TcpInfo result {};
+        result.rtt = std::chrono::microseconds {info.tcpi_rtt};
+        result.rtt_variance = std::chrono::microseconds {info.tcpi_rttvar};
+        result.congestion_window = static_cast<kstd::u64>(info.tcpi_snd_cwnd) * info.tcpi_snd_mss;
+        result.bytes_in_flight = static_cast<kstd::u64>(segments_in_flight) * info.tcpi_snd_mss;
+        result.retransmits = info.tcpi_total_retrans;
+
+        // Older kernels return a shorter structure without the delivery rate
+        if(info_size >= offsetof(tcp_info, tcpi_delivery_rate) + sizeof(info.tcpi_delivery_rate)) {
+            result.delivery_rate = info.tcpi_delivery_rate;
+        }
+        return result;
+    }
+}// namespace sockslib
+#endif
@@ -0,0 +1,134 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/datagram_socket.hpp"
+#include "sockslib/socket.hpp"
+#include "sockslib/timestamping.hpp"
+
+#include <errno.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <array>
+#include <cstring>
+
+namespace sockslib {
+    namespace {
+        // Room for the timestamps and the extended error with the address of the error queue
+        constexpr kstd::usize control_size =
+                CMSG_SPACE(sizeof(scm_timestamping)) + CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6));
+
+        // The first of the three timestamps is the software one, the others are hardware timestamps
+        auto find_timestamp(msghdr& message) noexcept -> kstd::Option<KernelTimestamp> {
+            for(auto* control_message = CMSG_FIRSTHDR(&message); control_message != nullptr;
+                control_message = CMSG_NXTHDR(&message, control_message)) {
+                if(control_message->cmsg_level != SOL_SOCKET || control_message->cmsg_type != SCM_TIMESTAMPING) {
+                    continue;
+                }
+                scm_timestamping timestamping {};
+                std::memcpy(&timestamping, CMSG_DATA(control_message), sizeof(timestamping));
+                const auto& time = timestamping.ts[0];
+                return {KernelTimestamp {std::chrono::seconds {time.tv_sec} + std::chrono::nanoseconds {time.tv_nsec}}};
+            }
+            return {};
+        }
+
+        auto receive_timestamped(const SocketHandle socket_handle, SocketStatistics* statistics, kstd::u8* data,
+                                 const kstd::usize size, SocketAddress* address) noexcept
+                -> kstd::Result<TimestampedRead, SocketError> {
+            iovec buffer {data, size};
+            alignas(cmsghdr) std::array<kstd::u8, control_size> control {};
+            msghdr message {};
+            if(address != nullptr) {
+                message.msg_name = address->data();
+                message.msg_namelen = SocketAddress::capacity();
+            }
+            message.msg_iov = &buffer;
+            message.msg_iovlen = 1;
+            message.msg_control = control.data();
+            message.msg_controllen = control.size();
+
+            const auto bytes_read = measure_io(socket_handle, statistics, IoOperation::READ, size, [&] {
+                return ::recvmsg(socket_handle, &message, 0);
+            });
+            if(bytes_read < 0) {
+                // Blocking reads only fail with EAGAIN once the timeout of the socket expired
+                if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                    return kstd::Error {SocketError {SocketOperation::READ, ETIMEDOUT}};
+                }
+                return kstd::Error {SocketError::last(SocketOperation::READ)};
+            }
+            if(address != nullptr) {
+                address->set_length(message.msg_namelen);
+            }
+            return TimestampedRead {static_cast<kstd::usize>(bytes_read), find_timestamp(message)};
+        }
+    }// namespace
+
+    auto Socket::set_timestamping(const TimestampingOptions& options) const noexcept
+            -> kstd::Result<void, SocketError> {
+        // The payload isn't looped back with the transmit timestamps (OPT_TSONLY), only the timestamps are
+        unsigned int flags = 0;
+        if(options.receive) {
+            flags |= SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+        }
+        if(options.transmit) {
+            flags |= SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_OPT_TSONLY;
+        }
+        if(options.id && flags != 0) {
+            flags |= SOF_TIMESTAMPING_OPT_ID;
+        }
+        if(setsockopt(_socket_handle, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+        }
+        return {};
+    }
+
+    auto Socket::try_read_transmit_timestamp() const noexcept
+            -> kstd::Result<kstd::Option<TransmitTimestamp>, SocketError> {
+        alignas(cmsghdr) std::array<kstd::u8, control_size> control {};
+        msghdr message {};
+        while(true) {
+            message.msg_control = control.data();
+            message.msg_controllen = control.size();
+            if(::recvmsg(_socket_handle, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+                if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                    return {kstd::Option<TransmitTimestamp> {}};
+                }
+                return kstd::Error {SocketError::last(SocketOperation::READ)};
+            }
+
+            const auto timestamp = find_timestamp(message);
+            sock_extended_err error {};
+            for(auto* control_message = CMSG_FIRSTHDR(&message); control_message != nullptr;
+                control_message = CMSG_NXTHDR(&message, control_message)) {
+                if((control_message->cmsg_level == SOL_IP && control_message->cmsg_type == IP_RECVERR) ||
+                   (control_message->cmsg_level == SOL_IPV6 && control_message->cmsg_type == IPV6_RECVERR)) {
+                    std::memcpy(&error, CMSG_DATA(control_message), sizeof(error));
+                }
+            }
+
+            // Other errors of the queue, like ICMP errors of UDP sockets, are skipped
+            if(timestamp && error.ee_errno == ENOMSG && error.ee_origin == SO_EE_ORIGIN_TIMESTAMPING) {
+                return {kstd::Option<TransmitTimestamp> {TransmitTimestamp {error.ee_data, timestamp.get()}}};
+            }
+        }
+    }
+
+    auto AcceptedSocket::read_timestamped(kstd::u8* data, const kstd::usize size) const noexcept
+            -> kstd::Result<TimestampedRead, SocketError> {
+        return receive_timestamped(_socket_handle, _statistics, data, size, nullptr);
+    }
+
+    auto ClientSocket::read_timestamped(kstd::u8* data, const kstd::usize size) const noexcept
+            -> kstd::Result<TimestampedRead, SocketError> {
+        return receive_timestamped(_socket_handle, _statistics, data, size, nullptr);
+    }
+
+    auto DatagramSocket::receive_from_timestamped(kstd::u8* data, const kstd::usize size,
+                                                  SocketAddress& address) const noexcept
+            -> kstd::Result<TimestampedRead, SocketError> {
+        return receive_timestamped(_socket_handle, _statistics, data, size, &address);
+    }
+}// namespace sockslib
+#endif
@@ -0,0 +1,112 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/zero_copy_sender.hpp"
+
+#include <array>
+#include <errno.h>
+#include <fmt/format.h>
+#include <linux/errqueue.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+
+namespace sockslib {
+    ZeroCopySender::ZeroCopySender(const SocketHandle socket_handle) :
+            _socket_handle {socket_handle},
+            _first_sequence {0} {
+        const int enable = 1;
+        if(setsockopt(_socket_handle, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) < 0) {
+            throw std::runtime_error {fmt::format("Unable to enable zero-copy on socket => {}", get_last_error())};
+        }
+    }
+
+    auto ZeroCopySender::send(const void* data, const kstd::usize size, const kstd::u64 user_data) noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_sent = ::send(_socket_handle, data, size, MSG_ZEROCOPY | MSG_NOSIGNAL);
+        if(bytes_sent < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+        }
+
+        // The kernel numbers every send, which transferred data, consecutively starting at zero
+        if(bytes_sent > 0) {
+            _pending_sends.push_back({user_data, false});
+        }
+        return static_cast<kstd::usize>(bytes_sent);
+    }
+
+    auto ZeroCopySender::reap(const ZeroCopyCallback& callback) noexcept -> kstd::Result<kstd::usize, SocketError> {
+        kstd::usize completion_count = 0;
+        while(!_pending_sends.empty()) {
+            alignas(cmsghdr) std::array<kstd::u8, CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_storage))>
+                    control {};
+            msghdr message {};
+            message.msg_control = control.data();
+            message.msg_controllen = control.size();
+            if(::recvmsg(_socket_handle, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+                if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                if(errno == EINTR) {
+                    continue;
+                }
+                return kstd::Error {SocketError::last(SocketOperation::READ)};
+            }
+
+            for(auto* control_message = CMSG_FIRSTHDR(&message); control_message != nullptr;
+                control_message = CMSG_NXTHDR(&message, control_message)) {
+                const auto* error = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(control_message));// NOLINT
+                if(error->ee_errno != 0 || error->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+                    continue;
+                }
+
+                // One notification covers the inclusive range of sequence numbers [ee_info, ee_data]
+                const auto copied = (error->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+                const auto sequence_count = error->ee_data - error->ee_info + 1;
+                for(kstd::u32 i = 0; i < sequence_count; ++i) {
+                    const auto index = static_cast<kstd::usize>(error->ee_info + i - _first_sequence);
+                    if(index >= _pending_sends.size() || _pending_sends[index].completed) {
+                        continue;
+                    }
+                    _pending_sends[index].completed = true;
+                    callback(_pending_sends[index].user_data, copied);
+                    ++completion_count;
+                }
+            }
+
+            while(!_pending_sends.empty() && _pending_sends.front().completed) {
+                _pending_sends.pop_front();
+                ++_first_sequence;
+            }
+        }
+        return completion_count;
+    }
+
+    auto ZeroCopySender::flush(const ZeroCopyCallback& callback, const Deadline deadline) noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        kstd::usize completion_count = 0;
+        while(true) {
+            const auto result = reap(callback);
+            if(!result) {
+                return kstd::Error {result.get_error()};
+            }
+            completion_count += result.get();
+            if(_pending_sends.empty()) {
+                break;
+            }
+
+            // The error queue is always reported as POLLERR, no matter which events are requested
+            pollfd poll_handle {_socket_handle, 0, 0};
+            const auto poll_result = ::poll(&poll_handle, 1, poll_timeout(deadline));
+            if(poll_result < 0 && errno != EINTR) {
+                return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+            }
+            if(poll_result == 0) {
+                return kstd::Error {SocketError {SocketOperation::WRITE, ETIMEDOUT}};
+            }
+            if((poll_handle.revents & POLLNVAL) != 0) {
+                return kstd::Error {SocketError {SocketOperation::WRITE, EBADF}};
+            }
+        }
+        return completion_count;
+    }
+}// namespace sockslib
+#endif
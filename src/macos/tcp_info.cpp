@@ -0,0 +1,27 @@
+#ifdef PLATFORM_APPLE
+#include "sockslib/tcp_info.hpp"
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+namespace sockslib {
+    auto get_tcp_info(const SocketHandle socket_handle) noexcept -> kstd::Result<TcpInfo, SocketError> {
+        tcp_connection_info info {};
+        socklen_t info_size = sizeof(info);
+        if(getsockopt(socket_handle, IPPROTO_TCP, TCP_CONNECTION_INFO, &info, &info_size) < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+        }
+
+        // The RTTs are reported in milliseconds and the in-flight bytes only as the bytes of the send buffer
+        TcpInfo result {};
+        result.rtt = std::chrono::milliseconds {info.tcpi_srtt};
+        result.rtt_variance = std::chrono::milliseconds {info.tcpi_rttvar};
+        result.congestion_window = info.tcpi_snd_cwnd;
+        result.bytes_in_flight = info.tcpi_snd_sbbytes;
+        result.retransmits = info.tcpi_txretransmitpackets;
+        return result;
+    }
+}// namespace sockslib
+#endif
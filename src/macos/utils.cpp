@@ -4,7 +4,15 @@
 
 namespace sockslib {
     auto get_last_error() noexcept -> std::string {
-        return fmt::format("ERROR 0x{:X}: {}", errno, strerror(errno));
+        return format_error(errno);
+    }
+
+    auto get_last_error_code() noexcept -> kstd::i32 {
+        return errno;
+    }
+
+    auto format_error(const kstd::i32 error_code) noexcept -> std::string {
+        return fmt::format("ERROR 0x{:X}: {}", error_code, strerror(error_code));
     }
 }
 #endif
\ No newline at end of file
@@ -16,20 +16,278 @@
 #include "sockslib/socket.hpp"
 
 #include "fmt/format.h"
+#include <algorithm>
+#include <array>
 #include <numeric>
+#include <type_traits>
 #include <stdexcept>
 
 #include <WS2tcpip.h>
+#include <io.h>
 
 namespace sockslib {
+#ifdef KSTD_CPP_20
+    namespace {
+        // Upper bound of buffers per WSASend/WSARecv call, which keeps the WSABUF array on the stack
+        constexpr kstd::usize max_vectored_buffers = 64;
+
+        template<typename T>
+        auto vectored_io(const SocketHandle socket_handle, SocketStatistics* statistics,
+                         const std::span<const std::span<T>> buffers, kstd::usize offset, const bool send) noexcept
+                -> kstd::isize {
+            std::array<WSABUF, max_vectored_buffers> wsa_buffers {};
+            DWORD buffer_count = 0;
+            kstd::usize requested = 0;
+            for(const auto& buffer : buffers) {
+                if(buffer_count == wsa_buffers.size()) {
+                    break;
+                }
+                wsa_buffers[buffer_count].buf = reinterpret_cast<CHAR*>(const_cast<kstd::u8*>(buffer.data()) + offset);// NOLINT
+                wsa_buffers[buffer_count].len = static_cast<ULONG>(
+                        std::min<kstd::usize>(buffer.size() - offset, std::numeric_limits<ULONG>::max()));
+                requested += wsa_buffers[buffer_count].len;
+                offset = 0;
+                ++buffer_count;
+            }
+
+            return measure_io(socket_handle, statistics, send ? IoOperation::WRITE : IoOperation::READ, requested,
+                              [&]() -> kstd::isize {
+                                  DWORD bytes_transferred = 0;
+                                  DWORD flags = 0;
+                                  const auto result =
+                                          send ? WSASend(socket_handle, wsa_buffers.data(), buffer_count,
+                                                         &bytes_transferred, 0, nullptr, nullptr)
+                                               : WSARecv(socket_handle, wsa_buffers.data(), buffer_count,
+                                                         &bytes_transferred, &flags, nullptr, nullptr);
+                                  if(result == SOCKET_ERROR) {
+                                      return -1;
+                                  }
+                                  return static_cast<kstd::isize>(bytes_transferred);
+                              });
+        }
+
+        auto write_all_vectored(const SocketHandle socket_handle, SocketStatistics* statistics,
+                                std::span<const std::span<const kstd::u8>> buffers) noexcept -> kstd::isize {
+            kstd::usize bytes_sent = 0;
+            kstd::usize offset = 0;
+            while(!buffers.empty()) {
+                if(offset == buffers.front().size()) {
+                    buffers = buffers.subspan(1);
+                    offset = 0;
+                    continue;
+                }
+
+                const auto result = vectored_io(socket_handle, statistics, buffers, offset, true);
+                if(result < 0) {
+                    return result;
+                }
+
+                // Advance through the buffers by the count of sent bytes, the last one may be sent partially
+                bytes_sent += static_cast<kstd::usize>(result);
+                auto remaining = static_cast<kstd::usize>(result);
+                while(remaining > 0) {
+                    const auto available = buffers.front().size() - offset;
+                    if(remaining < available) {
+                        offset += remaining;
+                        break;
+                    }
+                    remaining -= available;
+                    buffers = buffers.subspan(1);
+                    offset = 0;
+                }
+            }
+            return static_cast<kstd::isize>(bytes_sent);
+        }
+    }// namespace
+#endif
+
+    namespace {
+        auto wait_until_ready(const SocketHandle socket_handle, const SHORT events, const Deadline deadline,
+                              const SocketOperation operation) noexcept -> kstd::Result<void, SocketError> {
+            WSAPOLLFD poll_handle {socket_handle, events, 0};
+            const auto result = WSAPoll(&poll_handle, 1, poll_timeout(deadline));
+            if(result == 0) {
+                return kstd::Error {SocketError {operation, WSAETIMEDOUT}};
+            }
+            if(result == SOCKET_ERROR) {
+                return kstd::Error {SocketError::last(operation)};
+            }
+            return {};
+        }
+
+        // There is no per-call non-blocking flag on Windows, so the socket is polled before the operation
+        auto transfer_until(const SocketHandle socket_handle, SocketStatistics* statistics, char* data,
+                            const kstd::usize size, const Deadline deadline, const bool send) noexcept
+                -> kstd::Result<kstd::usize, SocketError> {
+            const auto operation = send ? SocketOperation::WRITE : SocketOperation::READ;
+            const auto io_operation = send ? IoOperation::WRITE : IoOperation::READ;
+            const auto length = static_cast<int>(std::min<kstd::usize>(size, std::numeric_limits<int>::max()));
+            while(true) {
+                if(auto wait_result = wait_until_ready(socket_handle, send ? POLLWRNORM : POLLRDNORM, deadline,
+                                                       operation);
+                   !wait_result) {
+                    return kstd::Error {wait_result.get_error()};
+                }
+
+                const auto result = measure_io(socket_handle, statistics, io_operation, size, [&] {
+                    return send ? ::send(socket_handle, data, length, 0) : ::recv(socket_handle, data, length, 0);
+                });
+                if(result != SOCKET_ERROR) {
+                    return static_cast<kstd::usize>(result);
+                }
+                if(WSAGetLastError() != WSAEWOULDBLOCK) {
+                    return kstd::Error {SocketError::last(operation)};
+                }
+            }
+        }
+
+        // The connect runs non-blocking, so the attempt can be abandoned at the deadline
+        auto connect_until(const SocketHandle socket_handle, const SocketAddress& address,
+                           const Deadline deadline) noexcept -> kstd::Result<void, SocketError> {
+            u_long non_blocking = 1;
+            if(ioctlsocket(socket_handle, FIONBIO, &non_blocking) == SOCKET_ERROR) {
+                return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+            }
+
+            const auto connect_result = trace_call(TraceEvent::CONNECT, socket_handle, [&] {
+                return ::connect(socket_handle, address.data(), address.length());
+            });
+            if(connect_result == SOCKET_ERROR) {
+                if(WSAGetLastError() != WSAEWOULDBLOCK) {
+                    return kstd::Error {SocketError::last(SocketOperation::CONNECT)};
+                }
+                if(auto wait_result = wait_until_ready(socket_handle, POLLWRNORM, deadline, SocketOperation::CONNECT);
+                   !wait_result) {
+                    return kstd::Error {wait_result.get_error()};
+                }
+
+                int error = 0;
+                int error_size = sizeof(error);
+                getsockopt(socket_handle, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &error_size);// NOLINT
+                if(error != 0) {
+                    return kstd::Error {SocketError {SocketOperation::CONNECT, error}};
+                }
+            }
+
+            non_blocking = 0;
+            if(ioctlsocket(socket_handle, FIONBIO, &non_blocking) == SOCKET_ERROR) {
+                return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+            }
+            return {};
+        }
+
+        auto accept_failed(const SocketHandle socket_handle) noexcept -> bool {
+            return !handle_valid(socket_handle);
+        }
+
+        // All options are passed as int, the durations in the unit of the option
+        template<typename T>
+        auto set_option(const SocketHandle socket_handle, const int level, const int name,
+                        const kstd::Option<T>& option) noexcept -> bool {
+            if(!option) {
+                return true;
+            }
+            int value = 0;
+            if constexpr(std::is_integral_v<T>) {
+                value = static_cast<int>(option.get());
+            }
+            else {
+                value = static_cast<int>(option.get().count());
+            }
+            return setsockopt(socket_handle, level, name, reinterpret_cast<const char*>(&value),// NOLINT
+                              sizeof(value)) != SOCKET_ERROR;
+        }
+
+        // Options, which the protocol of the socket doesn't know, are left empty
+        template<typename T>
+        auto get_option(const SocketHandle socket_handle, const int level, const int name,
+                        kstd::Option<T>& option) noexcept -> bool {
+            int value = 0;
+            int value_size = sizeof(value);
+            if(getsockopt(socket_handle, level, name, reinterpret_cast<char*>(&value), &value_size) == SOCKET_ERROR) {
+                return WSAGetLastError() == WSAENOPROTOOPT || WSAGetLastError() == WSAEINVAL;
+            }
+            option = T(value);
+            return true;
+        }
+
+        auto apply_options(const SocketHandle socket_handle, const SocketOptions& options) noexcept
+                -> kstd::Result<void, SocketError> {
+            if(options.quick_ack || options.cork || options.busy_poll || options.not_sent_low_watermark ||
+               options.fast_open_connect || options.defer_accept || options.incoming_cpu) {
+                return kstd::Error {SocketError {SocketOperation::CONFIGURE, WSAENOPROTOOPT}};
+            }
+            if(!set_option(socket_handle, IPPROTO_TCP, TCP_NODELAY, options.no_delay) ||
+               !set_option(socket_handle, SOL_SOCKET, SO_SNDBUF, options.send_buffer_size) ||
+               !set_option(socket_handle, SOL_SOCKET, SO_RCVBUF, options.receive_buffer_size) ||
+               !set_option(socket_handle, IPPROTO_TCP, TCP_FASTOPEN, options.fast_open)) {
+                return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+            }
+            return {};
+        }
+    }// namespace
+
     Socket::Socket() :
             _socket_handle {invalid_socket_handle} {
         init_wsa().throw_if_error();
     }
 
-    ServerSocket::ServerSocket(const kstd::u16 port, const ProtocolType protocol_type) :
+    auto Socket::set_blocking(const bool blocking) const noexcept -> kstd::Result<void> {
+        u_long non_blocking = blocking ? 0 : 1;
+        if(FAILED(ioctlsocket(_socket_handle, FIONBIO, &non_blocking))) {
+            return kstd::Error {fmt::format("Unable to change blocking mode of socket => {}", get_last_error())};
+        }
+        return {};
+    }
+
+    auto Socket::set_timeouts(const std::chrono::milliseconds read_timeout,
+                              const std::chrono::milliseconds write_timeout) const noexcept -> kstd::Result<void> {
+        const auto read_value = static_cast<DWORD>(read_timeout.count());
+        const auto write_value = static_cast<DWORD>(write_timeout.count());
+        if(setsockopt(_socket_handle, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&read_value),// NOLINT
+                      sizeof(read_value)) == SOCKET_ERROR ||
+           setsockopt(_socket_handle, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&write_value),// NOLINT
+                      sizeof(write_value)) == SOCKET_ERROR) {
+            return kstd::Error {fmt::format("Unable to change timeouts of socket => {}", get_last_error())};
+        }
+        return {};
+    }
+
+    auto Socket::set_options(const SocketOptions& options) const noexcept -> kstd::Result<void, SocketError> {
+        return apply_options(_socket_handle, options);
+    }
+
+    auto Socket::get_options() const noexcept -> kstd::Result<SocketOptions, SocketError> {
+        SocketOptions options {};
+        if(!get_option(_socket_handle, IPPROTO_TCP, TCP_NODELAY, options.no_delay) ||
+           !get_option(_socket_handle, SOL_SOCKET, SO_SNDBUF, options.send_buffer_size) ||
+           !get_option(_socket_handle, SOL_SOCKET, SO_RCVBUF, options.receive_buffer_size) ||
+           !get_option(_socket_handle, IPPROTO_TCP, TCP_FASTOPEN, options.fast_open)) {
+            return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+        }
+        return {std::move(options)};
+    }
+
+    ServerSocket::ServerSocket(const ProtocolType protocol_type, const SocketHandle socket_handle) noexcept :
             _protocol_type {protocol_type} {
-        using namespace std::string_literals;
+        _socket_handle = socket_handle;
+    }
+
+    ServerSocket::ServerSocket(const kstd::u16 port, const ProtocolType protocol_type, const bool reuse_port,
+                               const SocketOptions& options) :
+            ServerSocket(get_or_throw(create(port, protocol_type, reuse_port, options))) {
+    }
+
+    auto ServerSocket::create(const kstd::u16 port, const ProtocolType protocol_type, const bool reuse_port,
+                              const SocketOptions& options) noexcept -> kstd::Result<ServerSocket, SocketError> {
+        // Windows has no equivalent of SO_REUSEPORT, SO_REUSEADDR would allow hijacking the port instead
+        if(reuse_port) {
+            return kstd::Error {SocketError {SocketOperation::CONFIGURE, WSAEOPNOTSUPP}};
+        }
+
+        if(!init_wsa()) {
+            return kstd::Error {SocketError::last(SocketOperation::CREATE)};
+        }
 
         // Configure address information hints
         ADDRINFOW hints {};
@@ -42,71 +300,55 @@ namespace sockslib {
         hints.ai_flags = AI_PASSIVE;
 
         // Request address information
-        if(FAILED(GetAddrInfoW(nullptr, std::to_wstring(port).c_str(), &hints, &_addr_info))) {
+        PADDRINFOW addr_info = nullptr;
+        if(FAILED(GetAddrInfoW(nullptr, std::to_wstring(port).c_str(), &hints, &addr_info))) {
+            const auto error = SocketError::last(SocketOperation::RESOLVE);
             cleanup_wsa();
-            throw std::runtime_error(
-                    fmt::format("Unable to initialize server (Address info resolve failed) => ", get_last_error()));
+            return kstd::Error {error};
         }
 
         // Create the socket and do validation check
-        _socket_handle = socket(_addr_info->ai_family, _addr_info->ai_socktype, _addr_info->ai_protocol);
-        if(!handle_valid(_socket_handle)) {
+        const auto socket_handle = socket(addr_info->ai_family, addr_info->ai_socktype, addr_info->ai_protocol);
+        if(!handle_valid(socket_handle)) {
+            const auto error = SocketError::last(SocketOperation::CREATE);
+            FreeAddrInfoW(addr_info);
             cleanup_wsa();
-
-            FreeAddrInfoW(_addr_info);
-            _addr_info = nullptr;
-
-            throw std::runtime_error(
-                    fmt::format("Unable to initialize server (Socket creation failed) => {}", get_last_error()));
+            return kstd::Error {error};
         }
 
-        // Bind the socket
-        if(FAILED(::bind(_socket_handle, _addr_info->ai_addr, static_cast<int>(_addr_info->ai_addrlen)))) {
-            cleanup_wsa();
-
-            FreeAddrInfoW(_addr_info);
-            closesocket(_socket_handle);
-            _addr_info = nullptr;
+        // The socket holds its own WSA reference and closes the handle if one of the following steps fails
+        ServerSocket server_socket {protocol_type, socket_handle};
+        cleanup_wsa();
+        if(auto result = apply_options(socket_handle, options); !result) {
+            FreeAddrInfoW(addr_info);
+            return kstd::Error {result.get_error()};
+        }
 
-            throw std::runtime_error(
-                    fmt::format("Unable to initialize server (Socket binding failed) => {}", get_last_error()));
+        // Bind the socket, the address information isn't needed afterwards
+        const auto bind_failed =
+                FAILED(::bind(socket_handle, addr_info->ai_addr, static_cast<int>(addr_info->ai_addrlen)));
+        const auto bind_error = SocketError::last(SocketOperation::BIND);
+        FreeAddrInfoW(addr_info);
+        if(bind_failed) {
+            return kstd::Error {bind_error};
         }
 
         // Call the listen function if the socket is using TCP
-        if(protocol_type == ProtocolType::TCP) {
-            if(FAILED(listen(_socket_handle, SOMAXCONN))) {
-                cleanup_wsa();
-
-                FreeAddrInfoW(_addr_info);
-                closesocket(_socket_handle);
-                _addr_info = nullptr;
-
-                auto last_error = get_last_error();
-                if(last_error.empty()) {
-                    throw std::runtime_error(
-                            "Unable to initialize server (Socket binding failed) => Listen call with socket failed!"s);
-                }
-                throw std::runtime_error(
-                        fmt::format("Unable to initialize server (Socket binding failed) => {}", get_last_error()));
-            }
+        if(protocol_type == ProtocolType::TCP && FAILED(listen(socket_handle, SOMAXCONN))) {
+            return kstd::Error {SocketError::last(SocketOperation::LISTEN)};
         }
+        return {std::move(server_socket)};
     }
 
     ServerSocket::ServerSocket(ServerSocket&& other) noexcept :// NOLINT
-            _addr_info {other._addr_info},
             _protocol_type {other._protocol_type} {
         _socket_handle = other._socket_handle;
+        _statistics = other._statistics;
         other._socket_handle = invalid_socket_handle;
-        other._addr_info = nullptr;
         ++_wsa_user_count;
     }
 
     ServerSocket::~ServerSocket() noexcept {
-        // Free the address information if valid
-        if(_addr_info != nullptr) {
-            FreeAddrInfoW(_addr_info);
-        }
-
         // Close the socket if valid
         if(handle_valid(_socket_handle)) {
             shutdown(_socket_handle, SD_SEND);
@@ -117,88 +359,156 @@ namespace sockslib {
         cleanup_wsa();
     }
 
-    auto ServerSocket::accept() const noexcept -> kstd::Result<AcceptedSocket> {
-        auto accepted_socket_handle = ::accept(_socket_handle, nullptr, nullptr);
+    auto ServerSocket::accept() const noexcept -> kstd::Result<AcceptedSocket, SocketError> {
+        auto accepted_socket_handle = measure_io(_socket_handle, _statistics, IoOperation::ACCEPT, 0, [&] {
+            return ::accept(_socket_handle, nullptr, nullptr);
+        }, accept_failed);
         if(!handle_valid(accepted_socket_handle)) {
-            return kstd::Error {fmt::format("Unable to accept socket => {}", get_last_error())};
+            return kstd::Error {SocketError::last(SocketOperation::ACCEPT)};
         }
 
         return AcceptedSocket {accepted_socket_handle};
     }
 
+    auto ServerSocket::accept(const Deadline deadline) const noexcept -> kstd::Result<AcceptedSocket, SocketError> {
+        while(true) {
+            if(auto wait_result = wait_until_ready(_socket_handle, POLLRDNORM, deadline, SocketOperation::ACCEPT);
+               !wait_result) {
+                return kstd::Error {wait_result.get_error()};
+            }
+
+            // A non-blocking listener fails with WSAEWOULDBLOCK, if another thread took the connection in the meantime
+            const auto accepted_socket_handle = measure_io(_socket_handle, _statistics, IoOperation::ACCEPT, 0, [&] {
+                return ::accept(_socket_handle, nullptr, nullptr);
+            }, accept_failed);
+            if(handle_valid(accepted_socket_handle)) {
+                // Accepted sockets inherit the non-blocking mode of the listener on Windows
+                AcceptedSocket accepted_socket {accepted_socket_handle};
+                u_long non_blocking = 0;
+                if(ioctlsocket(accepted_socket_handle, FIONBIO, &non_blocking) == SOCKET_ERROR) {
+                    return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+                }
+                return {std::move(accepted_socket)};
+            }
+            if(WSAGetLastError() != WSAEWOULDBLOCK) {
+                return kstd::Error {SocketError::last(SocketOperation::ACCEPT)};
+            }
+        }
+    }
+
+    auto ServerSocket::try_accept() const noexcept -> kstd::Result<kstd::Option<AcceptedSocket>, SocketError> {
+        auto accepted_socket_handle = measure_io(_socket_handle, _statistics, IoOperation::ACCEPT, 0, [&] {
+            return ::accept(_socket_handle, nullptr, nullptr);
+        }, accept_failed);
+        if(!handle_valid(accepted_socket_handle)) {
+            if(WSAGetLastError() == WSAEWOULDBLOCK) {
+                return {kstd::Option<AcceptedSocket> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::ACCEPT)};
+        }
+
+        // Sockets accepted from a non-blocking listener inherit its non-blocking mode on Windows
+        return {kstd::Option<AcceptedSocket> {AcceptedSocket {accepted_socket_handle}}};
+    }
+
     auto ServerSocket::operator=(ServerSocket&& other) noexcept -> ServerSocket& {
         _socket_handle = other._socket_handle;
+        _statistics = other._statistics;
         _protocol_type = other._protocol_type;
-        _addr_info = other._addr_info;
 
         other._socket_handle = invalid_socket_handle;
-        other._addr_info = nullptr;
         ++_wsa_user_count;
         return *this;
     }
 
-    ClientSocket::ClientSocket(std::string address, const kstd::u16 port, const ProtocolType protocol_type) :
+    ClientSocket::ClientSocket(const ProtocolType protocol_type, const SocketHandle socket_handle) noexcept :
             _protocol_type {protocol_type} {
-        using namespace std::string_literals;
+        _socket_handle = socket_handle;
+    }
 
-        // Specify protocol
-        int protocol = 0;
-        switch(protocol_type) {
-            case ProtocolType::TCP: protocol = IPPROTO_TCP; break;
-            case ProtocolType::UDP: protocol = IPPROTO_UDP; break;
-        }
+    ClientSocket::ClientSocket(std::string address, const kstd::u16 port, const ProtocolType protocol_type,
+                               const SocketOptions& options) :
+            ClientSocket(get_or_throw(create(address, port, protocol_type, options))) {
+    }
 
+    ClientSocket::ClientSocket(const std::vector<SocketAddress>& addresses, const ProtocolType protocol_type,
+                               const std::chrono::milliseconds attempt_delay, const SocketOptions& options) :
+            ClientSocket(get_or_throw(create(addresses, protocol_type, attempt_delay, Deadline::max(), options))) {
+    }
+
+    auto ClientSocket::create(const std::string& address, const kstd::u16 port, const ProtocolType protocol_type,
+                              const SocketOptions& options, const Deadline deadline) noexcept
+            -> kstd::Result<ClientSocket, SocketError> {
+        // Address literals are used as is, domains are resolved to the address of resolve_address
+        auto resolved_address = address;
 #ifndef SOCKSLIB_NO_DNS_RESOLVE
-        // Resolve address if domain
         if(is_domain(address)) {
-            address = resolve_address(address).get_or_throw();
+            auto resolve_result = resolve_address(address);
+            if(!resolve_result) {
+                return kstd::Error {SocketError {SocketOperation::RESOLVE, WSAHOST_NOT_FOUND}};
+            }
+            resolved_address = std::move(resolve_result.get());
         }
 #endif
-        const auto address_type_result = recognize_address_type(address);
-        if(!address_type_result) {
-            throw std::runtime_error {
-                    fmt::format("Unable to initialize socket => Unable to recognize address protocol")};
+        if(const auto literal_address = SocketAddress::from_literal(resolved_address, port); literal_address) {
+            return create(std::vector<SocketAddress> {literal_address.get()}, protocol_type,
+                          std::chrono::milliseconds {250}, deadline, options);
         }
-        const auto address_type = static_cast<int>(address_type_result.get());
+        return kstd::Error {SocketError {SocketOperation::RESOLVE, WSAEINVAL}};
+    }
 
-        // Create socket handle and validate it
-        _socket_handle = socket(address_type, static_cast<int>(protocol_type), protocol);
-        if(!handle_valid(_socket_handle)) {
-            cleanup_wsa();
-            throw std::runtime_error {fmt::format("Unable to initialize socket => {}", get_last_error())};
+    auto ClientSocket::create(const std::vector<SocketAddress>& addresses, const ProtocolType protocol_type,
+                              const std::chrono::milliseconds attempt_delay, const Deadline deadline,
+                              const SocketOptions& options) noexcept -> kstd::Result<ClientSocket, SocketError> {
+        static_cast<void>(attempt_delay);
+        if(!init_wsa()) {
+            return kstd::Error {SocketError::last(SocketOperation::CREATE)};
         }
 
-        // Generate SOCKADDR
-        SOCKADDR_IN addr {};
-        if(FAILED(InetPton(address_type, address.c_str(),// NOLINT
-                           &addr.sin_addr.s_addr))) {
-            throw std::runtime_error {
-                    "Unable to connect with socket => Failed conversion of literal address to binary address!"s};
+        // Specify protocol
+        int protocol = 0;
+        switch(protocol_type) {
+            case ProtocolType::TCP: protocol = IPPROTO_TCP; break;
+            case ProtocolType::UDP: protocol = IPPROTO_UDP; break;
         }
-        addr.sin_family = address_type;
-        addr.sin_port = htons(port);
-
-        // Establish connection
 
-        if(FAILED(connect(_socket_handle, reinterpret_cast<SOCKADDR*>(&addr), sizeof(addr)))) {// NOLINT
-            // Free address info and close socket
-            closesocket(_socket_handle);
+        // The addresses are tried one after another in the order of Happy Eyeballs, but without racing them
+        SocketError last_error {SocketOperation::CONNECT, WSAEADDRNOTAVAIL};
+        for(const auto& address : interleave_address_families(addresses)) {
+            if(std::chrono::steady_clock::now() >= deadline) {
+                last_error = SocketError {SocketOperation::CONNECT, WSAETIMEDOUT};
+                break;
+            }
 
-            // Cleanup WSA and decrement socket count
-            cleanup_wsa();
+            const auto socket_handle = socket(address.data()->sa_family, static_cast<int>(protocol_type), protocol);
+            if(!handle_valid(socket_handle)) {
+                last_error = SocketError::last(SocketOperation::CREATE);
+                continue;
+            }
 
-            auto last_error = get_last_error();
-            if(last_error.empty()) {
-                throw std::runtime_error {
-                        "Unable to connect with socket => Establishment of connection with server failed! Maybe the server isn't reachable?"s};
+            auto connect_result = apply_options(socket_handle, options);
+            if(connect_result) {
+                connect_result = connect_until(socket_handle, address, deadline);
+            }
+            if(connect_result) {
+                // The socket holds its own WSA reference
+                ClientSocket client_socket {protocol_type, socket_handle};
+                cleanup_wsa();
+                return {std::move(client_socket)};
             }
-            throw std::runtime_error {fmt::format("Unable to connect with socket => {}", last_error)};
+            last_error = connect_result.get_error();
+            closesocket(socket_handle);
         }
+
+        // Cleanup WSA and decrement socket count
+        cleanup_wsa();
+        return kstd::Error {last_error};
     }
 
     ClientSocket::ClientSocket(sockslib::ClientSocket&& other) noexcept :// NOLINT
             _protocol_type {other._protocol_type} {
         _socket_handle = other._socket_handle;
+        _statistics = other._statistics;
         other.Socket::_socket_handle = invalid_socket_handle;
         ++_wsa_user_count;
     }
@@ -214,49 +524,156 @@ namespace sockslib {
         cleanup_wsa();
     }
 
-    auto ClientSocket::write(void* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize> {
-        using namespace std::string_literals;
+    auto ClientSocket::write(void* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize, SocketError> {
         if(!handle_valid(_socket_handle)) {
-            return kstd::Error {"Unable to write with socket => Socket handle is invalid!"s};
+            return kstd::Error {SocketError {SocketOperation::WRITE, WSAENOTSOCK}};
         }
 
-        using namespace std::string_literals;
         if(size > std::numeric_limits<int>::max()) {
             size = std::numeric_limits<int>::max();
         }
 
-        auto bytes_sent = ::send(_socket_handle, static_cast<const char*>(data), static_cast<int>(size), 0);
+        auto bytes_sent = measure_io(_socket_handle, _statistics, IoOperation::WRITE, size, [&] {
+            return ::send(_socket_handle, static_cast<const char*>(data), static_cast<int>(size), 0);
+        });
         if(bytes_sent <= 0) {
-            return kstd::Error {fmt::format("Unable to write to socket => {}", get_last_error())};
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
         }
         return bytes_sent;
     }
 
-    auto ClientSocket::read(kstd::u8* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize> {
-        using namespace std::string_literals;
+    auto ClientSocket::read(kstd::u8* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize, SocketError> {
         if(!handle_valid(_socket_handle)) {
-            return kstd::Error {"Unable to read from socket => Socket handle is invalid!"s};
+            return kstd::Error {SocketError {SocketOperation::READ, WSAENOTSOCK}};
         }
 
         if(size > std::numeric_limits<int>::max()) {
             size = std::numeric_limits<int>::max();
         }
 
-        auto bytes_read = ::recv(_socket_handle, reinterpret_cast<char*>(data), static_cast<int>(size), 0);// NOLINT
+        auto bytes_read = measure_io(_socket_handle, _statistics, IoOperation::READ, size, [&] {
+            return ::recv(_socket_handle, reinterpret_cast<char*>(data), static_cast<int>(size), 0);// NOLINT
+        });
         if(bytes_read < 0) {
-            return kstd::Error {fmt::format("Unable to read from socket => {}", get_last_error())};
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
         }
         return bytes_read;
     }
 
+    auto ClientSocket::write(const void* data, const kstd::usize size, const Deadline deadline) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        auto* bytes = const_cast<char*>(static_cast<const char*>(data));// NOLINT
+        return transfer_until(_socket_handle, _statistics, bytes, size, deadline, true);
+    }
+
+    auto ClientSocket::read(kstd::u8* data, const kstd::usize size, const Deadline deadline) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        auto* bytes = reinterpret_cast<char*>(data);// NOLINT
+        return transfer_until(_socket_handle, _statistics, bytes, size, deadline, false);
+    }
+
 #ifdef KSTD_CPP_20
-    auto ClientSocket::read(std::span<kstd::u8> data) const noexcept -> kstd::Result<kstd::usize> {
+    auto ClientSocket::read(std::span<kstd::u8> data) const noexcept -> kstd::Result<kstd::usize, SocketError> {
         return read(data.data(), data.size());
     }
+
+    auto ClientSocket::write(std::span<const std::span<const kstd::u8>> buffers) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_sent = vectored_io(_socket_handle, _statistics, buffers, 0, true);
+        if(bytes_sent < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+        }
+        return static_cast<kstd::usize>(bytes_sent);
+    }
+
+    auto ClientSocket::read(std::span<const std::span<kstd::u8>> buffers) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_read = vectored_io(_socket_handle, _statistics, buffers, 0, false);
+        if(bytes_read < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
+        }
+        return static_cast<kstd::usize>(bytes_read);
+    }
+
+    auto ClientSocket::write_all(std::span<const std::span<const kstd::u8>> buffers) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_sent = write_all_vectored(_socket_handle, _statistics, buffers);
+        if(bytes_sent < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+        }
+        return static_cast<kstd::usize>(bytes_sent);
+    }
 #endif
 
+    // Windows has no MSG_DONTWAIT, so these only return early on sockets which were switched to non-blocking mode
+    auto ClientSocket::try_write(const void* data, kstd::usize size) const noexcept
+            -> kstd::Result<kstd::Option<kstd::usize>, SocketError> {
+        if(size > std::numeric_limits<int>::max()) {
+            size = std::numeric_limits<int>::max();
+        }
+
+        auto bytes_sent = measure_io(_socket_handle, _statistics, IoOperation::WRITE, size, [&] {
+            return ::send(_socket_handle, static_cast<const char*>(data), static_cast<int>(size), 0);
+        });
+        if(bytes_sent == SOCKET_ERROR) {
+            if(WSAGetLastError() == WSAEWOULDBLOCK) {
+                return {kstd::Option<kstd::usize> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+        }
+        return {kstd::Option<kstd::usize> {static_cast<kstd::usize>(bytes_sent)}};
+    }
+
+    auto ClientSocket::try_read(kstd::u8* data, kstd::usize size) const noexcept
+            -> kstd::Result<kstd::Option<kstd::usize>, SocketError> {
+        if(size > std::numeric_limits<int>::max()) {
+            size = std::numeric_limits<int>::max();
+        }
+
+        auto bytes_read = measure_io(_socket_handle, _statistics, IoOperation::READ, size, [&] {
+            return ::recv(_socket_handle, reinterpret_cast<char*>(data), static_cast<int>(size), 0);// NOLINT
+        });
+        if(bytes_read == SOCKET_ERROR) {
+            if(WSAGetLastError() == WSAEWOULDBLOCK) {
+                return {kstd::Option<kstd::usize> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
+        }
+        return {kstd::Option<kstd::usize> {static_cast<kstd::usize>(bytes_read)}};
+    }
+
+    auto ClientSocket::try_peek(kstd::u8* data, kstd::usize size) const noexcept
+            -> kstd::Result<kstd::Option<kstd::usize>, SocketError> {
+        if(size > std::numeric_limits<int>::max()) {
+            size = std::numeric_limits<int>::max();
+        }
+
+        // There is no MSG_DONTWAIT, so the readability is checked without waiting first
+        fd_set read_set {};
+        FD_ZERO(&read_set);
+        FD_SET(_socket_handle, &read_set);
+        timeval timeout {};
+        const auto ready_count = select(0, &read_set, nullptr, nullptr, &timeout);
+        if(ready_count == SOCKET_ERROR) {
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
+        }
+        if(ready_count == 0) {
+            return {kstd::Option<kstd::usize> {}};
+        }
+
+        auto bytes_read = ::recv(_socket_handle, reinterpret_cast<char*>(data), static_cast<int>(size), MSG_PEEK);// NOLINT
+        if(bytes_read == SOCKET_ERROR) {
+            if(WSAGetLastError() == WSAEWOULDBLOCK) {
+                return {kstd::Option<kstd::usize> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
+        }
+        return {kstd::Option<kstd::usize> {static_cast<kstd::usize>(bytes_read)}};
+    }
+
     auto ClientSocket::operator=(ClientSocket&& other) noexcept -> ClientSocket& {
         _socket_handle = other._socket_handle;
+        _statistics = other._statistics;
         _protocol_type = other._protocol_type;
         other._socket_handle = invalid_socket_handle;
         ++_wsa_user_count;
@@ -269,6 +686,7 @@ namespace sockslib {
 
     AcceptedSocket::AcceptedSocket(AcceptedSocket&& other) noexcept {// NOLINT
         _socket_handle = other._socket_handle;
+        _statistics = other._statistics;
         other._socket_handle = invalid_socket_handle;
     }
 
@@ -279,48 +697,171 @@ namespace sockslib {
         }
     }
 
-    auto AcceptedSocket::write(void* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize> {
-        using namespace std::string_literals;
+    auto AcceptedSocket::write(void* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize, SocketError> {
         if(!handle_valid(_socket_handle)) {
-            return kstd::Error {"Unable to write with socket => Socket handle is invalid!"s};
+            return kstd::Error {SocketError {SocketOperation::WRITE, WSAENOTSOCK}};
         }
 
         if(size > std::numeric_limits<int>::max()) {
             size = std::numeric_limits<int>::max();
         }
 
-        auto bytes_sent = ::send(_socket_handle, static_cast<const char*>(data), static_cast<int>(size), 0);
+        auto bytes_sent = measure_io(_socket_handle, _statistics, IoOperation::WRITE, size, [&] {
+            return ::send(_socket_handle, static_cast<const char*>(data), static_cast<int>(size), 0);
+        });
         if(bytes_sent < 0) {
-            return kstd::Error {fmt::format("Unable to write with socket => {}", get_last_error())};
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
         }
         return bytes_sent;
     }
 
-    auto AcceptedSocket::read(kstd::u8* data, kstd::usize size) const noexcept -> kstd::Result<kstd::usize> {
-        using namespace std::string_literals;
+    auto AcceptedSocket::read(kstd::u8* data, kstd::usize size) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
         if(!handle_valid(_socket_handle)) {
-            return kstd::Error {"Unable to read from socket => Socket handle is invalid!"s};
+            return kstd::Error {SocketError {SocketOperation::READ, WSAENOTSOCK}};
         }
 
         if(size > std::numeric_limits<int>::max()) {
             size = std::numeric_limits<int>::max();
         }
 
-        auto bytes_read = ::recv(_socket_handle, reinterpret_cast<char*>(data), static_cast<int>(size), 0);// NOLINT
+        auto bytes_read = measure_io(_socket_handle, _statistics, IoOperation::READ, size, [&] {
+            return ::recv(_socket_handle, reinterpret_cast<char*>(data), static_cast<int>(size), 0);// NOLINT
+        });
         if(bytes_read < 0) {
-            return kstd::Error {fmt::format("Unable to read from socket => {}", get_last_error())};
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
         }
         return bytes_read;
     }
 
+    auto AcceptedSocket::write(const void* data, const kstd::usize size, const Deadline deadline) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        auto* bytes = const_cast<char*>(static_cast<const char*>(data));// NOLINT
+        return transfer_until(_socket_handle, _statistics, bytes, size, deadline, true);
+    }
+
+    auto AcceptedSocket::read(kstd::u8* data, const kstd::usize size, const Deadline deadline) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        auto* bytes = reinterpret_cast<char*>(data);// NOLINT
+        return transfer_until(_socket_handle, _statistics, bytes, size, deadline, false);
+    }
+
 #ifdef KSTD_CPP_20
-    auto AcceptedSocket::read(std::span<kstd::u8> data) const noexcept -> kstd::Result<kstd::usize> {
+    auto AcceptedSocket::read(std::span<kstd::u8> data) const noexcept -> kstd::Result<kstd::usize, SocketError> {
         return read(data.data(), data.size());
     }
+
+    auto AcceptedSocket::write(std::span<const std::span<const kstd::u8>> buffers) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_sent = vectored_io(_socket_handle, _statistics, buffers, 0, true);
+        if(bytes_sent < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+        }
+        return static_cast<kstd::usize>(bytes_sent);
+    }
+
+    auto AcceptedSocket::read(std::span<const std::span<kstd::u8>> buffers) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_read = vectored_io(_socket_handle, _statistics, buffers, 0, false);
+        if(bytes_read < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
+        }
+        return static_cast<kstd::usize>(bytes_read);
+    }
+
+    auto AcceptedSocket::write_all(std::span<const std::span<const kstd::u8>> buffers) const noexcept
+            -> kstd::Result<kstd::usize, SocketError> {
+        const auto bytes_sent = write_all_vectored(_socket_handle, _statistics, buffers);
+        if(bytes_sent < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+        }
+        return static_cast<kstd::usize>(bytes_sent);
+    }
 #endif
 
+    // Windows has no MSG_DONTWAIT, so these only return early on sockets which were switched to non-blocking mode
+    auto AcceptedSocket::try_write(const void* data, kstd::usize size) const noexcept
+            -> kstd::Result<kstd::Option<kstd::usize>, SocketError> {
+        if(size > std::numeric_limits<int>::max()) {
+            size = std::numeric_limits<int>::max();
+        }
+
+        auto bytes_sent = measure_io(_socket_handle, _statistics, IoOperation::WRITE, size, [&] {
+            return ::send(_socket_handle, static_cast<const char*>(data), static_cast<int>(size), 0);
+        });
+        if(bytes_sent == SOCKET_ERROR) {
+            if(WSAGetLastError() == WSAEWOULDBLOCK) {
+                return {kstd::Option<kstd::usize> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+        }
+        return {kstd::Option<kstd::usize> {static_cast<kstd::usize>(bytes_sent)}};
+    }
+
+    auto AcceptedSocket::try_read(kstd::u8* data, kstd::usize size) const noexcept
+            -> kstd::Result<kstd::Option<kstd::usize>, SocketError> {
+        if(size > std::numeric_limits<int>::max()) {
+            size = std::numeric_limits<int>::max();
+        }
+
+        auto bytes_read = measure_io(_socket_handle, _statistics, IoOperation::READ, size, [&] {
+            return ::recv(_socket_handle, reinterpret_cast<char*>(data), static_cast<int>(size), 0);// NOLINT
+        });
+        if(bytes_read == SOCKET_ERROR) {
+            if(WSAGetLastError() == WSAEWOULDBLOCK) {
+                return {kstd::Option<kstd::usize> {}};
+            }
+            return kstd::Error {SocketError::last(SocketOperation::READ)};
+        }
+        return {kstd::Option<kstd::usize> {static_cast<kstd::usize>(bytes_read)}};
+    }
+
+    auto AcceptedSocket::send_file(const int file_handle, const kstd::u64 offset,
+                                   const kstd::usize length) const noexcept -> kstd::Result<kstd::usize, SocketError> {
+        if(!handle_valid(_socket_handle)) {
+            return kstd::Error {SocketError {SocketOperation::WRITE, WSAENOTSOCK}};
+        }
+
+        // TransmitFile would need the Mswsock extension, so the file is streamed through a buffer instead
+        if(_lseeki64(file_handle, static_cast<__int64>(offset), SEEK_SET) < 0) {
+            return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+        }
+
+        std::array<char, 64 * 1024> buffer {};
+        kstd::usize bytes_sent = 0;
+        while(bytes_sent < length) {
+            const auto chunk_size = static_cast<unsigned int>(std::min(buffer.size(), length - bytes_sent));
+            const auto bytes_read = _read(file_handle, buffer.data(), chunk_size);
+            if(bytes_read < 0) {
+                return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+            }
+            if(bytes_read == 0) {
+                break;
+            }
+
+            int chunk_sent = 0;
+            while(chunk_sent < bytes_read) {
+                const auto chunk_size = static_cast<kstd::usize>(bytes_read - chunk_sent);
+                const auto result = measure_io(_socket_handle, _statistics, IoOperation::WRITE, chunk_size, [&] {
+                    return ::send(_socket_handle, buffer.data() + chunk_sent, bytes_read - chunk_sent, 0);
+                });
+                if(result == SOCKET_ERROR) {
+                    // The offset is passed by the caller, so the unsent rest of the chunk is simply read again
+                    if(WSAGetLastError() == WSAEWOULDBLOCK) {
+                        return bytes_sent + static_cast<kstd::usize>(chunk_sent);
+                    }
+                    return kstd::Error {SocketError::last(SocketOperation::WRITE)};
+                }
+                chunk_sent += result;
+            }
+            bytes_sent += static_cast<kstd::usize>(bytes_read);
+        }
+        return bytes_sent;
+    }
+
     auto AcceptedSocket::operator=(AcceptedSocket&& other) noexcept -> AcceptedSocket& {
         _socket_handle = other._socket_handle;
+        _statistics = other._statistics;
         other._socket_handle = invalid_socket_handle;
         return *this;
     }
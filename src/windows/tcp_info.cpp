@@ -0,0 +1,26 @@
+#ifdef PLATFORM_WINDOWS
+#include "sockslib/tcp_info.hpp"
+
+#include <WS2tcpip.h>
+#include <mstcpip.h>
+
+namespace sockslib {
+    auto get_tcp_info(const SocketHandle socket_handle) noexcept -> kstd::Result<TcpInfo, SocketError> {
+        DWORD version = 0;
+        TCP_INFO_v0 info {};
+        DWORD info_size = 0;
+        if(WSAIoctl(socket_handle, SIO_TCP_INFO, &version, sizeof(version), &info, sizeof(info), &info_size, nullptr,
+                    nullptr) == SOCKET_ERROR) {
+            return kstd::Error {SocketError::last(SocketOperation::CONFIGURE)};
+        }
+
+        // There is no RTT variance and no count of retransmitted segments, so fast retransmits and RTOs are summed up
+        TcpInfo result {};
+        result.rtt = std::chrono::microseconds {info.RttUs};
+        result.congestion_window = info.Cwnd;
+        result.bytes_in_flight = info.BytesInFlight;
+        result.retransmits = static_cast<kstd::u64>(info.FastRetrans) + info.TimeoutEpisodes;
+        return result;
+    }
+}// namespace sockslib
+#endif
@@ -8,8 +8,14 @@
 namespace sockslib {
 
     auto get_last_error() noexcept -> std::string {
-        const auto error_code = ::GetLastError();
+        return format_error(static_cast<kstd::i32>(::GetLastError()));
+    }
+
+    auto get_last_error_code() noexcept -> kstd::i32 {
+        return WSAGetLastError();
+    }
 
+    auto format_error(const kstd::i32 error_code) noexcept -> std::string {
         if(error_code == 0) {
             return "";
         }
@@ -18,7 +24,7 @@ namespace sockslib {
         constexpr auto lang_id = MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT);
         const auto new_length = ::FormatMessageW(
                 FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS, nullptr,
-                error_code, lang_id, reinterpret_cast<LPWSTR>(&buffer), 0, nullptr);// NOLINT
+                static_cast<DWORD>(error_code), lang_id, reinterpret_cast<LPWSTR>(&buffer), 0, nullptr);// NOLINT
         auto message = kstd::utils::to_mbs({buffer, new_length});
         LocalFree(buffer);
 
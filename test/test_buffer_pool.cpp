@@ -0,0 +1,149 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/buffer_pool.hpp"
+#include "sockslib/socket.hpp"
+
+#include <gtest/gtest.h>
+#include <array>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+TEST(sockslib_BufferPool, test_allocate_reuse) {
+    using namespace sockslib;
+    BufferPool pool {1000};
+    ASSERT_EQ(pool.buffer_size(), 1024);
+
+    const kstd::u8* data = nullptr;
+    {
+        auto buffer = pool.allocate().get();
+        ASSERT_EQ(buffer.size(), 0);
+        ASSERT_EQ(buffer.capacity(), 1024);
+        ASSERT_EQ(pool.used_count(), 1);
+        ASSERT_GT(pool.buffer_count(), 1);
+        ASSERT_GE(pool.memory_size(), pool.buffer_count() * pool.buffer_size());
+        data = buffer.data();
+    }
+    ASSERT_EQ(pool.used_count(), 0);
+
+    // The released buffer is on top of the freelist of this thread
+    const auto buffer = pool.allocate().get();
+    ASSERT_EQ(buffer.data(), data);
+}
+
+TEST(sockslib_BufferPool, test_shared_buffer) {
+    using namespace sockslib;
+    BufferPool pool {};
+    auto buffer = pool.allocate().get();
+    std::memcpy(buffer.data(), "Test", 4);
+    buffer.resize(4);
+    ASSERT_EQ(buffer.use_count(), 1);
+
+    {
+        const auto copy = buffer;// NOLINT
+        ASSERT_EQ(buffer.use_count(), 2);
+        ASSERT_EQ(copy.data(), buffer.data());
+        ASSERT_EQ(copy.size(), 4);
+    }
+    ASSERT_EQ(buffer.use_count(), 1);
+    ASSERT_EQ(pool.used_count(), 1);
+
+    auto moved_buffer = std::move(buffer);
+    ASSERT_TRUE(buffer.is_empty());// NOLINT
+    ASSERT_EQ(moved_buffer.use_count(), 1);
+    moved_buffer = PooledBuffer {};
+    ASSERT_EQ(pool.used_count(), 0);
+
+    buffer = pool.allocate().get();
+    buffer.resize(pool.buffer_size() + 1);
+    ASSERT_EQ(buffer.size(), pool.buffer_size());
+}
+
+TEST(sockslib_BufferPool, test_exhausted) {
+    using namespace sockslib;
+    BufferPool pool {4096, 3};
+    std::vector<PooledBuffer> buffers {};
+    for(kstd::usize i = 0; i < 3; ++i) {
+        auto buffer = pool.allocate();
+        ASSERT_TRUE(buffer);
+        buffers.push_back(std::move(buffer.get()));
+    }
+    ASSERT_EQ(pool.buffer_count(), 3);
+    ASSERT_FALSE(pool.allocate());
+
+    buffers.pop_back();
+    ASSERT_TRUE(pool.allocate());
+}
+
+TEST(sockslib_BufferPool, test_release_on_other_thread) {
+    using namespace sockslib;
+    BufferPool pool {4096, 64};
+    std::vector<PooledBuffer> buffers {};
+    for(kstd::usize i = 0; i < 64; ++i) {
+        buffers.push_back(std::move(pool.allocate().get()));
+    }
+
+    // Buffers released into the freelist of another thread are found by this thread again
+    std::thread {[buffers = std::move(buffers)]() mutable {
+        buffers.clear();
+    }}.join();
+    ASSERT_EQ(pool.used_count(), 0);
+    std::vector<PooledBuffer> reallocated_buffers {};
+    for(kstd::usize i = 0; i < 64; ++i) {
+        reallocated_buffers.push_back(std::move(pool.allocate().get()));
+    }
+    ASSERT_EQ(pool.buffer_count(), 64);
+}
+
+TEST(sockslib_BufferPool, test_concurrent_allocate) {
+    using namespace sockslib;
+    BufferPool pool {256};
+    std::vector<std::thread> threads {};
+    for(kstd::usize i = 0; i < 4; ++i) {
+        threads.emplace_back([&pool, i] {
+            std::vector<PooledBuffer> buffers {};
+            for(kstd::usize round = 0; round < 1000; ++round) {
+                auto buffer = pool.allocate().get();
+                buffer.data()[0] = static_cast<kstd::u8>(i);
+                buffers.push_back(std::move(buffer));
+                if(buffers.size() == 16) {
+                    for(const auto& kept_buffer : buffers) {
+                        ASSERT_EQ(kept_buffer.data()[0], static_cast<kstd::u8>(i));
+                    }
+                    buffers.clear();
+                }
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(pool.used_count(), 0);
+}
+
+TEST(sockslib_BufferPool, test_socket_read) {
+    using namespace sockslib;
+    BufferPool pool {};
+    ServerSocket server_socket {1337, ProtocolType::TCP};
+    ClientSocket client_socket {"127.0.0.1", 1337, ProtocolType::TCP};
+    auto socket = std::move(server_socket.accept().get_or_throw());
+
+    // Nothing to read, so the buffer goes back to the pool right away
+    ASSERT_TRUE(socket.try_read(pool).get_or_throw().is_empty());
+    ASSERT_EQ(pool.used_count(), 0);
+
+    std::array<kstd::u8, 4> data {1, 2, 3, 4};
+    client_socket.write(data.data(), data.size()).throw_if_error();
+    const auto buffer = socket.read(pool).get_or_throw();
+    ASSERT_EQ(pool.used_count(), 1);
+    ASSERT_EQ(buffer.size(), 4);
+    ASSERT_EQ(std::memcmp(buffer.data(), data.data(), data.size()), 0);
+
+    socket.write(data.data(), 2).throw_if_error();
+    kstd::Option<PooledBuffer> received {};
+    while(received.is_empty()) {
+        received = client_socket.try_read(pool).get_or_throw();
+    }
+    ASSERT_EQ(received.get().size(), 2);
+    ASSERT_EQ(pool.used_count(), 2);
+}
+#endif
@@ -0,0 +1,100 @@
+#include "sockslib/buffered_stream.hpp"
+#include "sockslib/socket.hpp"
+
+#include <gtest/gtest.h>
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+    // The client socket is optional, so the tests can close the connection by resetting it
+    struct Connection final {
+        sockslib::ServerSocket server_socket {1337, sockslib::ProtocolType::TCP};
+        std::optional<sockslib::ClientSocket> client_socket {std::in_place, "127.0.0.1", 1337,
+                                                             sockslib::ProtocolType::TCP};
+        sockslib::AcceptedSocket socket {std::move(server_socket.accept().get_or_throw())};
+    };
+}// namespace
+
+TEST(sockslib_BufferedStream, test_write_coalescing) {
+    using namespace sockslib;
+    Connection connection {};
+    BufferedStream stream {*connection.client_socket, 64, 16};
+
+    stream.write("Hello", 5).throw_if_error();
+    stream.write(" World", 6).throw_if_error();
+    ASSERT_EQ(stream.pending_size(), 11);
+
+    // The next write doesn't fit anymore, so the pending bytes are sent first
+    stream.write("!!!!!!", 6).throw_if_error();
+    ASSERT_EQ(stream.pending_size(), 6);
+    stream.flush().throw_if_error();
+    ASSERT_EQ(stream.pending_size(), 0);
+
+    // Writes as large as the buffer bypass it
+    const std::string large_data(32, 'x');
+    stream.write(large_data.data(), large_data.size()).throw_if_error();
+    ASSERT_EQ(stream.pending_size(), 0);
+
+    std::array<kstd::u8, 49> data {};
+    BufferedStream reader {connection.socket};
+    ASSERT_EQ(reader.read_exact(data.data(), data.size()).get_or_throw(), data.size());
+    ASSERT_EQ(std::string(data.begin(), data.end()), "Hello World!!!!!!" + large_data);
+}
+
+TEST(sockslib_BufferedStream, test_read_until) {
+    using namespace sockslib;
+    Connection connection {};
+    std::string lines = "first\nsecond line\n\nlast";
+    connection.client_socket->write(lines.data(), lines.size()).throw_if_error();
+    connection.client_socket.reset();// Closes the connection
+
+    // The small ring buffer forces lines across the wrap-around and refills
+    BufferedStream stream {connection.socket, 4};
+    std::vector<kstd::u8> line {};
+    ASSERT_EQ(stream.read_until('\n', line).get_or_throw(), 6);
+    ASSERT_EQ(std::string(line.begin(), line.end()), "first\n");
+
+    line.clear();
+    ASSERT_EQ(stream.read_until('\n', line).get_or_throw(), 12);
+    ASSERT_EQ(std::string(line.begin(), line.end()), "second line\n");
+
+    line.clear();
+    ASSERT_EQ(stream.read_until('\n', line).get_or_throw(), 1);
+
+    // The connection was closed before the delimiter arrived
+    line.clear();
+    ASSERT_EQ(stream.read_until('\n', line).get_or_throw(), 4);
+    ASSERT_EQ(std::string(line.begin(), line.end()), "last");
+    ASSERT_EQ(stream.read_until('\n', line).get_or_throw(), 0);
+}
+
+TEST(sockslib_BufferedStream, test_peek_read) {
+    using namespace sockslib;
+    Connection connection {};
+    std::array<kstd::u8, 8> sent_data {1, 2, 3, 4, 5, 6, 7, 8};
+    connection.client_socket->write(sent_data.data(), sent_data.size()).throw_if_error();
+
+    BufferedStream stream {connection.socket, 16};
+    std::array<kstd::u8, 8> data {};
+    ASSERT_EQ(stream.peek(data.data(), 8).get_or_throw(), 8);
+    ASSERT_EQ(data, sent_data);
+    ASSERT_EQ(stream.buffered_size(), 8);
+
+    // Reads are served from the buffer without consuming more than requested
+    data = {};
+    ASSERT_EQ(stream.read(data.data(), 3).get_or_throw(), 3);
+    ASSERT_EQ(data[2], 3);
+    ASSERT_EQ(stream.buffered_size(), 5);
+    ASSERT_EQ(stream.read_exact(data.data(), 5).get_or_throw(), 5);
+    ASSERT_EQ(data[4], 8);
+
+    // Peeking more than the read capacity is limited to the capacity
+    std::array<kstd::u8, 40> large_data {};
+    connection.client_socket->write(large_data.data(), 32).throw_if_error();
+    connection.client_socket.reset();// Closes the connection
+    ASSERT_EQ(stream.peek(large_data.data(), 32).get_or_throw(), 16);
+    ASSERT_EQ(stream.read_exact(large_data.data(), 40).get_or_throw(), 32);
+    ASSERT_EQ(stream.peek(large_data.data(), 1).get_or_throw(), 0);
+}
@@ -0,0 +1,164 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/client_socket_pool.hpp"
+
+#include <gtest/gtest.h>
+#include <kstd/safe_alloc.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Accepts the specified count of connections on port 1337 and keeps them open until joined
+    // The accepted sockets are shared with the accepting thread, so they are only touched with the mutex
+    class TestServer final {
+        sockslib::ServerSocket _server_socket;
+        std::mutex _mutex;
+        std::condition_variable _accepted;
+        std::vector<sockslib::AcceptedSocket> _accepted_sockets;
+        std::thread _thread;
+
+        public:
+        explicit TestServer(const kstd::usize connection_count) :
+                _server_socket {1337, sockslib::ProtocolType::TCP} {
+            _thread = std::thread {[this, connection_count] {
+                for(kstd::usize i = 0; i < connection_count; ++i) {
+                    auto socket = std::move(_server_socket.accept().get_or_throw());
+                    {
+                        const std::lock_guard<std::mutex> lock {_mutex};
+                        _accepted_sockets.push_back(std::move(socket));
+                    }
+                    _accepted.notify_all();
+                }
+            }};
+        }
+
+        // Waits until the first connection was accepted and closes all accepted connections
+        auto close_accepted() -> void {
+            std::unique_lock<std::mutex> lock {_mutex};
+            _accepted.wait(lock, [this] {
+                return !_accepted_sockets.empty();
+            });
+            _accepted_sockets.clear();
+        }
+
+        ~TestServer() noexcept {
+            join();
+        }
+
+        auto join() -> void {
+            if(_thread.joinable()) {
+                _thread.join();
+            }
+        }
+    };
+}// namespace
+
+TEST(sockslib_ClientSocketPool, test_reuse_connection) {
+    using namespace sockslib;
+    TestServer server {1};
+    ClientSocketPool pool {};
+
+    SocketHandle socket_handle = invalid_socket_handle;
+    {
+        auto socket = std::move(pool.lease("127.0.0.1", 1337).get_or_throw());
+        socket_handle = socket->socket_handle();
+    }
+    ASSERT_EQ(pool.idle_count(), 1);
+    {
+        auto socket = std::move(pool.lease("127.0.0.1", 1337).get_or_throw());
+        ASSERT_EQ(socket->socket_handle(), socket_handle);
+    }
+
+    const auto metrics = pool.metrics();
+    ASSERT_EQ(metrics.lease_count, 2);
+    ASSERT_EQ(metrics.hit_count, 1);
+    ASSERT_EQ(metrics.miss_count, 1);
+    ASSERT_DOUBLE_EQ(metrics.hit_rate(), 0.5);
+}
+
+TEST(sockslib_ClientSocketPool, test_stale_connection) {
+    using namespace sockslib;
+    TestServer server {2};
+    ClientSocketPool pool {};
+    {
+        auto socket = std::move(pool.lease("127.0.0.1", 1337).get_or_throw());
+    }
+
+    // The server closes the idle connection, which is detected by the peek when leasing it
+    server.close_accepted();
+    std::this_thread::sleep_for(std::chrono::milliseconds {50});
+
+    auto socket = std::move(pool.lease("127.0.0.1", 1337).get_or_throw());
+    const auto metrics = pool.metrics();
+    ASSERT_EQ(metrics.stale_count, 1);
+    ASSERT_EQ(metrics.miss_count, 2);
+    ASSERT_EQ(metrics.hit_count, 0);
+}
+
+TEST(sockslib_ClientSocketPool, test_idle_cap_and_discard) {
+    using namespace sockslib;
+    TestServer server {3};
+    ClientSocketPool pool {1};
+    {
+        auto first_socket = std::move(pool.lease("127.0.0.1", 1337).get_or_throw());
+        auto second_socket = std::move(pool.lease("127.0.0.1", 1337).get_or_throw());
+        auto third_socket = std::move(pool.lease("127.0.0.1", 1337).get_or_throw());
+        third_socket.discard();
+    }
+    ASSERT_EQ(pool.idle_count(), 1);
+    ASSERT_EQ(pool.metrics().eviction_count, 1);
+}
+
+TEST(sockslib_ClientSocketPool, test_evict_idle) {
+    using namespace sockslib;
+    TestServer server {1};
+    ClientSocketPool pool {8, std::chrono::milliseconds {20}};
+    {
+        auto socket = std::move(pool.lease("127.0.0.1", 1337).get_or_throw());
+    }
+    ASSERT_EQ(pool.evict_idle(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds {50});
+    ASSERT_EQ(pool.evict_idle(), 1);
+    ASSERT_EQ(pool.idle_count(), 0);
+}
+
+TEST(sockslib_ClientSocketPool, test_connection_limit) {
+    using namespace sockslib;
+    TestServer server {1};
+    ClientSocketPool pool {8, std::chrono::seconds {60}, 1, std::chrono::milliseconds {2000}};
+
+    // The second lease waits until the first connection is released
+    auto socket = std::move(pool.lease("127.0.0.1", 1337).get_or_throw());
+    auto release_thread = std::thread {[socket = std::move(socket)]() mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds {100});
+        auto released_socket = std::move(socket);
+    }};
+    auto second_socket = std::move(pool.lease("127.0.0.1", 1337).get_or_throw());
+    release_thread.join();
+
+    const auto metrics = pool.metrics();
+    ASSERT_EQ(metrics.hit_count, 1);
+    ASSERT_GE(metrics.max_wait_time, std::chrono::milliseconds {50});
+}
+
+TEST(sockslib_ClientSocketPool, test_lease_timeout) {
+    using namespace sockslib;
+    TestServer server {1};
+    ClientSocketPool pool {8, std::chrono::seconds {60}, 1, std::chrono::milliseconds {50}};
+    auto socket = std::move(pool.lease("127.0.0.1", 1337).get_or_throw());
+    ASSERT_FALSE(pool.lease("127.0.0.1", 1337));
+}
+
+TEST(sockslib_ClientSocketPool, test_connect_deadline) {
+    using namespace sockslib;
+    TestServer server {0};
+
+    // Connecting a new connection counts towards the lease timeout
+    ClientSocketPool pool {8, std::chrono::seconds {60}, 0, std::chrono::milliseconds {0}};
+    const auto result = pool.lease("127.0.0.1", 1337);
+    ASSERT_FALSE(result);
+    ASSERT_EQ(result.get_error(), SocketError(SocketOperation::CONNECT, ETIMEDOUT).to_string());
+}
+#endif
@@ -0,0 +1,112 @@
+#include "sockslib/connection_scheduler.hpp"
+
+#ifdef PLATFORM_LINUX
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Echoes the available data, the handler is invoked again when the client sends more
+    auto echo(const kstd::usize, sockslib::AcceptedSocket& socket) -> bool {
+        std::array<kstd::u8, 64> buffer {};
+        while(true) {
+            auto read_result = socket.try_read(buffer.data(), buffer.size());
+            if(read_result && read_result.get().is_empty()) {
+                return true;
+            }
+            if(!read_result || read_result.get().get() == 0) {
+                return false;
+            }
+            socket.write(buffer.data(), read_result.get().get()).throw_if_error();
+        }
+    }
+}// namespace
+
+TEST(sockslib_ConnectionScheduler, test_echo) {
+    using namespace sockslib;
+    constexpr kstd::usize connection_count = 16;
+    ServerSocket server_socket {1337, ProtocolType::TCP};
+    ConnectionScheduler scheduler {4, echo};
+    scheduler.listen(server_socket).throw_if_error();
+    scheduler.start().throw_if_error();
+
+    std::vector<std::optional<ClientSocket>> client_sockets {};
+    for(kstd::usize i = 0; i < connection_count; ++i) {
+        client_sockets.emplace_back(std::in_place, "127.0.0.1", 1337, ProtocolType::TCP);
+    }
+    for(kstd::usize round = 0; round < 8; ++round) {
+        for(kstd::usize i = 0; i < connection_count; ++i) {
+            auto value = static_cast<kstd::u8>(round * connection_count + i);
+            client_sockets[i]->write(&value, 1).throw_if_error();
+        }
+        for(kstd::usize i = 0; i < connection_count; ++i) {
+            kstd::u8 value = 0;
+            ASSERT_EQ(client_sockets[i]->read(&value, 1).get_or_throw(), 1);
+            ASSERT_EQ(value, static_cast<kstd::u8>(round * connection_count + i));
+        }
+    }
+
+    kstd::usize handled_count = 0;
+    for(kstd::usize i = 0; i < scheduler.worker_count(); ++i) {
+        handled_count += scheduler.handled_count(i);
+    }
+    ASSERT_GE(handled_count, connection_count * 8);
+    ASSERT_EQ(scheduler.connection_count(), connection_count + 1);
+
+    // Closed connections are released by the workers
+    client_sockets.clear();
+    for(kstd::usize i = 0; i < 100 && scheduler.connection_count() > 1; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds {10});
+    }
+    ASSERT_EQ(scheduler.connection_count(), 1);
+    scheduler.stop();
+    ASSERT_EQ(scheduler.connection_count(), 0);
+}
+
+TEST(sockslib_ConnectionScheduler, test_start_after_stop) {
+    sockslib::ConnectionScheduler scheduler {2, echo};
+    scheduler.start().throw_if_error();
+    ASSERT_FALSE(scheduler.start());
+    scheduler.stop();
+    ASSERT_FALSE(scheduler.start());
+}
+
+TEST(sockslib_ConnectionScheduler, test_work_stealing) {
+    using namespace sockslib;
+    constexpr kstd::usize connection_count = 8;
+    ServerSocket server_socket {1337, ProtocolType::TCP};
+
+    // Worker 0 is slow, worker 1 only owns idle connections and has to steal the ready connections of worker 0
+    ConnectionScheduler scheduler {2, [](const kstd::usize worker_index, AcceptedSocket& socket) {
+        if(worker_index == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds {5});
+        }
+        return echo(worker_index, socket);
+    }};
+    std::vector<std::optional<ClientSocket>> client_sockets {};
+    std::vector<std::optional<ClientSocket>> idle_sockets {};
+    for(kstd::usize i = 0; i < connection_count * 2; ++i) {
+        auto& sockets = i % 2 == 0 ? client_sockets : idle_sockets;
+        sockets.emplace_back(std::in_place, "127.0.0.1", 1337, ProtocolType::TCP);
+        scheduler.add(std::move(server_socket.accept().get_or_throw())).throw_if_error();
+    }
+    scheduler.start().throw_if_error();
+
+    for(kstd::usize round = 0; round < 4; ++round) {
+        for(auto& socket : client_sockets) {
+            kstd::u8 value = 42;
+            socket->write(&value, 1).throw_if_error();
+        }
+        for(auto& socket : client_sockets) {
+            kstd::u8 value = 0;
+            ASSERT_EQ(socket->read(&value, 1).get_or_throw(), 1);
+            ASSERT_EQ(value, 42);
+        }
+    }
+    ASSERT_GT(scheduler.stolen_count(1), 0);
+    ASSERT_GT(scheduler.handled_count(1), 0);
+}
+#endif
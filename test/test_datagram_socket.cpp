@@ -0,0 +1,169 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/datagram_socket.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <kstd/safe_alloc.hpp>
+#include <vector>
+
+TEST(sockslib_DatagramSocket, test_send_receive) {
+    using namespace sockslib;
+    auto receiver_result = kstd::try_construct<DatagramSocket>(1337);
+    auto& receiver = receiver_result.get_or_throw();
+    auto sender_result = kstd::try_construct<DatagramSocket>();
+    auto& sender = sender_result.get_or_throw();
+
+    kstd::u8 data = 42;
+    const auto address = SocketAddress::from_literal("127.0.0.1", 1337).get();
+    ASSERT_EQ(sender.send_to(&data, sizeof(data), address).get_or_throw(), 1);
+
+    kstd::u8 received_data = 0;
+    SocketAddress sender_address {};
+    ASSERT_EQ(receiver.receive_from(&received_data, sizeof(received_data), sender_address).get_or_throw(), 1);
+    ASSERT_EQ(received_data, data);
+    ASSERT_EQ(sender_address.port(), sender.local_address().get_or_throw().port());
+}
+
+TEST(sockslib_DatagramSocket, test_would_block) {
+    using namespace sockslib;
+    auto receiver_result = kstd::try_construct<DatagramSocket>(1337);
+    auto& receiver = receiver_result.get_or_throw();
+    auto sender_result = kstd::try_construct<DatagramSocket>();
+    auto& sender = sender_result.get_or_throw();
+
+    kstd::u8 data = 42;
+    SocketAddress sender_address {};
+    ASSERT_FALSE(receiver.try_receive_from(&data, sizeof(data), sender_address).get_or_throw());
+    receiver.set_blocking(false).throw_if_error();
+    DatagramBatch batch {4, 16};
+    ASSERT_EQ(receiver.receive_batch(batch).get_or_throw(), 0);
+    ASSERT_EQ(batch.size(), 0);
+
+    const auto address = SocketAddress::from_literal("127.0.0.1", 1337).get();
+    ASSERT_EQ(sender.try_send_to(&data, sizeof(data), address).get_or_throw().get(), 1);
+    kstd::u8 received_data = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {5};
+    kstd::Option<kstd::usize> size {};
+    while(!size && std::chrono::steady_clock::now() < deadline) {
+        size = receiver.try_receive_from(&received_data, sizeof(received_data), sender_address).get_or_throw();
+    }
+    ASSERT_EQ(size.get(), 1);
+    ASSERT_EQ(received_data, data);
+
+    // Errors other than EAGAIN are still reported
+    const auto ipv6_address = SocketAddress::from_literal("::1", 1337).get();
+    const auto error = sender.send_to(&data, sizeof(data), ipv6_address).get_error();
+    ASSERT_EQ(error.operation(), SocketOperation::WRITE);
+}
+
+TEST(sockslib_DatagramSocket, test_bind_in_use) {
+    auto socket_result = kstd::try_construct<sockslib::DatagramSocket>(1337);
+    static_cast<void>(socket_result.get_or_throw());
+    ASSERT_THROW(sockslib::DatagramSocket {1337}, std::runtime_error);
+}
+
+TEST(sockslib_DatagramSocket, test_send_receive_batch) {
+    using namespace sockslib;
+    constexpr kstd::usize datagram_count = 32;
+    auto receiver_result = kstd::try_construct<DatagramSocket>(1337);
+    auto& receiver = receiver_result.get_or_throw();
+    auto sender_result = kstd::try_construct<DatagramSocket>();
+    auto& sender = sender_result.get_or_throw();
+
+    const auto address = SocketAddress::from_literal("127.0.0.1", 1337).get();
+    DatagramBatch send_batch {datagram_count, 64};
+    for(kstd::usize i = 0; i < datagram_count; ++i) {
+        std::array<kstd::u8, 2> datagram {static_cast<kstd::u8>(i), static_cast<kstd::u8>(~i)};
+        ASSERT_TRUE(send_batch.push(datagram.data(), datagram.size(), address));
+    }
+    kstd::u8 oversized[65] {};
+    ASSERT_FALSE(send_batch.push(oversized, sizeof(oversized), address));
+    ASSERT_EQ(sender.send_batch(send_batch).get_or_throw(), datagram_count);
+
+    // Loopback keeps the order of the datagrams, they may arrive over multiple receive calls though
+    const auto sender_port = sender.local_address().get_or_throw().port();
+    DatagramBatch receive_batch {datagram_count, 64};
+    kstd::usize received_count = 0;
+    while(received_count < datagram_count) {
+        const auto count = receiver.receive_batch(receive_batch).get_or_throw();
+        ASSERT_EQ(count, receive_batch.size());
+        for(kstd::usize i = 0; i < count; ++i) {
+            ASSERT_EQ(receive_batch.datagram_size(i), 2);
+            ASSERT_EQ(receive_batch.data(i)[0], static_cast<kstd::u8>(received_count + i));
+            ASSERT_EQ(receive_batch.data(i)[1], static_cast<kstd::u8>(~(received_count + i)));
+            ASSERT_EQ(receive_batch.address(i).port(), sender_port);
+        }
+        received_count += count;
+    }
+    ASSERT_EQ(received_count, datagram_count);
+}
+
+TEST(sockslib_DatagramSocket, test_ipv6_batch) {
+    using namespace sockslib;
+    auto receiver_result = kstd::try_construct<DatagramSocket>(1337, AddressType::IPV6);
+    if(!receiver_result) {
+        GTEST_SKIP() << "IPv6 is not available";
+    }
+    auto& receiver = receiver_result.get();
+    auto sender_result = kstd::try_construct<DatagramSocket>(AddressType::IPV6);
+    auto& sender = sender_result.get_or_throw();
+
+    DatagramBatch batch {4, 16};
+    kstd::u8 data = 7;
+    ASSERT_TRUE(batch.push(&data, sizeof(data), SocketAddress::from_literal("::1", 1337).get()));
+    ASSERT_EQ(sender.send_batch(batch).get_or_throw(), 1);
+    ASSERT_EQ(receiver.receive_batch(batch).get_or_throw(), 1);
+    ASSERT_EQ(batch.data(0)[0], data);
+    ASSERT_EQ(batch.address(0).address_type(), AddressType::IPV6);
+}
+
+TEST(sockslib_DatagramSocket, test_segmentation_offload) {
+    using namespace sockslib;
+    constexpr kstd::usize segment_count = 10;
+    constexpr kstd::u16 segment_size = 100;
+    auto receiver_result = kstd::try_construct<DatagramSocket>(1337);
+    auto& receiver = receiver_result.get_or_throw();
+    auto sender_result = kstd::try_construct<DatagramSocket>();
+    auto& sender = sender_result.get_or_throw();
+    receiver.set_receive_offload(true).throw_if_error();
+
+    // The last datagram is shorter than the segment size
+    std::vector<kstd::u8> buffer(segment_count * segment_size - 50);
+    for(kstd::usize i = 0; i < buffer.size(); ++i) {
+        buffer[i] = static_cast<kstd::u8>(i / segment_size);
+    }
+    const auto address = SocketAddress::from_literal("127.0.0.1", 1337).get();
+    auto send_result = sender.send_segmented(buffer.data(), buffer.size(), segment_size, address);
+    if(!send_result) {
+        GTEST_SKIP() << "UDP segmentation offload is not supported";
+    }
+    ASSERT_EQ(send_result.get(), buffer.size());
+
+    // Depending on the kernel, the datagrams arrive coalesced or one by one
+    std::vector<kstd::u8> receive_buffer(64 * 1024);
+    kstd::usize received_count = 0;
+    while(received_count < segment_count) {
+        SocketAddress sender_address {};
+        const auto segments =
+                receiver.receive_coalesced(receive_buffer.data(), receive_buffer.size(), sender_address).get_or_throw();
+        for(kstd::usize i = 0; i < segments.count(); ++i, ++received_count) {
+            ASSERT_EQ(segments.size(i), received_count + 1 < segment_count ? segment_size : segment_size - 50);
+            ASSERT_EQ(segments.data(i)[0], received_count);
+        }
+    }
+    ASSERT_EQ(received_count, segment_count);
+}
+
+TEST(sockslib_DatagramSocket, test_segments) {
+    const std::array<kstd::u8, 10> buffer {};
+    const sockslib::DatagramSegments segments {buffer.data(), buffer.size(), 4};
+    ASSERT_EQ(segments.count(), 3);
+    ASSERT_EQ(segments.size(0), 4);
+    ASSERT_EQ(segments.size(2), 2);
+    ASSERT_EQ(segments.data(2), buffer.data() + 8);
+
+    const sockslib::DatagramSegments single_segment {buffer.data(), buffer.size(), 0};
+    ASSERT_EQ(single_segment.count(), 1);
+    ASSERT_EQ(single_segment.size(0), buffer.size());
+}
+#endif
@@ -0,0 +1,230 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/dns_resolver.hpp"
+#include "sockslib/datagram_socket.hpp"
+
+#include <gtest/gtest.h>
+#include <kstd/safe_alloc.hpp>
+#include <array>
+#include <atomic>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct StubRecord {
+        kstd::u16 type;
+        std::vector<kstd::u8> data;
+        kstd::u32 ttl;
+    };
+
+    // Minimal name server on 127.0.0.1:1337, which answers the queries of the tests and counts them
+    class StubDnsServer final {
+        sockslib::DatagramSocket _socket;
+        std::thread _thread;
+
+        static auto append_u16(std::vector<kstd::u8>& message, const kstd::u16 value) -> void {
+            message.push_back(static_cast<kstd::u8>(value >> 8));
+            message.push_back(static_cast<kstd::u8>(value & 0xFF));
+        }
+
+        static auto append_record(std::vector<kstd::u8>& message, const StubRecord& record) -> void {
+            append_u16(message, 0xC00C);// Pointer to the name of the question
+            append_u16(message, record.type);
+            append_u16(message, 1);
+            append_u16(message, static_cast<kstd::u16>(record.ttl >> 16));
+            append_u16(message, static_cast<kstd::u16>(record.ttl & 0xFFFF));
+            append_u16(message, static_cast<kstd::u16>(record.data.size()));
+            message.insert(message.end(), record.data.begin(), record.data.end());
+        }
+
+        static auto answer(const std::string& name, const kstd::u16 type, kstd::u8& response_code)
+                -> std::vector<StubRecord> {
+            response_code = 0;
+            if(name == "example.test" && type == 1) {
+                return {{1, {192, 0, 2, 1}, 60}, {1, {192, 0, 2, 2}, 60}};
+            }
+            if(name == "example.test" && type == 28) {
+                return {{28, {0x20, 0x01, 0x0D, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1}, 60}};
+            }
+            if(name == "short.test" && type == 1) {
+                return {{1, {192, 0, 2, 3}, 1}};
+            }
+            if(name == "fail.test") {
+                response_code = 2;
+            }
+            if(name == "missing.test") {
+                response_code = 3;
+            }
+            return {};
+        }
+
+        public:
+        std::atomic<kstd::usize> query_count;
+
+        StubDnsServer() :
+                _socket {1337},
+                query_count {0} {
+            _thread = std::thread {[this] {
+                std::array<kstd::u8, 512> query {};
+                while(true) {
+                    sockslib::SocketAddress sender {};
+                    const auto size = _socket.receive_from(query.data(), query.size(), sender).get_or_throw();
+                    if(size < 12) {
+                        return;
+                    }
+
+                    std::string name {};
+                    kstd::usize offset = 12;
+                    while(query[offset] != 0) {
+                        name += std::string {reinterpret_cast<const char*>(&query[offset + 1]), query[offset]};
+                        offset += query[offset] + 1;
+                        name += query[offset] != 0 ? "." : "";
+                    }
+                    const auto type = static_cast<kstd::u16>((query[offset + 1] << 8) | query[offset + 2]);
+                    ++query_count;
+
+                    kstd::u8 response_code = 0;
+                    const auto records = answer(name, type, response_code);
+                    std::vector<kstd::u8> response {query.begin(), query.begin() + offset + 5};
+                    response[2] = 0x81;
+                    response[3] = static_cast<kstd::u8>(0x80 | response_code);
+                    response[7] = static_cast<kstd::u8>(records.size());
+                    for(const auto& record : records) {
+                        append_record(response, record);
+                    }
+
+                    // Negative answers carry a SOA record with a minimum of 60 seconds
+                    if(records.empty() && response_code != 2) {
+                        response[9] = 1;
+                        append_record(response, {6, std::vector<kstd::u8>(24, 0), 300});
+                        std::fill(response.end() - 4, response.end(), 0);
+                        response.back() = 60;
+                    }
+                    _socket.send_to(response.data(), response.size(), sender).throw_if_error();
+                }
+            }};
+        }
+
+        ~StubDnsServer() noexcept {
+            // An empty datagram stops the server
+            sockslib::DatagramSocket socket {};
+            const auto address = sockslib::SocketAddress::from_literal("127.0.0.1", 1337).get();
+            static_cast<void>(socket.send_to(nullptr, 0, address));
+            _thread.join();
+        }
+    };
+
+    auto stub_name_server() -> sockslib::SocketAddress {
+        return sockslib::SocketAddress::from_literal("127.0.0.1", 1337).get();
+    }
+}// namespace
+
+TEST(sockslib_DnsResolver, test_resolve_all_addresses) {
+    using namespace sockslib;
+    StubDnsServer server {};
+    DnsResolver resolver {stub_name_server()};
+
+    const auto addresses = resolver.resolve("Example.Test.", 80).get_or_throw();
+    ASSERT_EQ(addresses.size(), 3);
+    ASSERT_EQ(addresses[0].to_string(), "[2001:db8::1]:80");
+    ASSERT_EQ(addresses[1].to_string(), "192.0.2.1:80");
+    ASSERT_EQ(addresses[2].to_string(), "192.0.2.2:80");
+    ASSERT_EQ(server.query_count, 2);
+
+    // The second lookup is answered from the cache
+    const auto cached_addresses = resolver.resolve("example.test", 443).get_or_throw();
+    ASSERT_EQ(cached_addresses.size(), 3);
+    ASSERT_EQ(cached_addresses[1].port(), 443);
+    ASSERT_EQ(server.query_count, 2);
+    ASSERT_EQ(resolver.cache_size(), 1);
+}
+
+TEST(sockslib_DnsResolver, test_negative_cache) {
+    using namespace sockslib;
+    StubDnsServer server {};
+    DnsResolver resolver {stub_name_server()};
+
+    ASSERT_FALSE(resolver.resolve("missing.test"));
+    ASSERT_FALSE(resolver.resolve("missing.test"));
+    ASSERT_EQ(server.query_count, 2);
+
+    // Server failures are not cached
+    ASSERT_FALSE(resolver.resolve("fail.test"));
+    ASSERT_FALSE(resolver.resolve("fail.test"));
+    ASSERT_EQ(server.query_count, 6);
+}
+
+TEST(sockslib_DnsResolver, test_ttl_expiry) {
+    using namespace sockslib;
+    StubDnsServer server {};
+    DnsResolver resolver {stub_name_server()};
+
+    ASSERT_EQ(resolver.resolve("short.test").get_or_throw().size(), 1);
+    ASSERT_EQ(resolver.resolve("short.test").get_or_throw().size(), 1);
+    ASSERT_EQ(server.query_count, 2);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds {1100});
+    ASSERT_EQ(resolver.resolve("short.test").get_or_throw().size(), 1);
+    ASSERT_EQ(server.query_count, 4);
+}
+
+TEST(sockslib_DnsResolver, test_resolve_async) {
+    using namespace sockslib;
+    StubDnsServer server {};
+    DnsResolver resolver {stub_name_server()};
+
+    std::promise<kstd::usize> address_count {};
+    resolver.resolve_async("example.test", 80, [&address_count](kstd::Result<std::vector<SocketAddress>> result) {
+        address_count.set_value(result ? result.get().size() : 0);
+    });
+    ASSERT_EQ(address_count.get_future().get(), 3);
+
+    // Literals are passed to the callback directly
+    kstd::usize literal_count = 0;
+    resolver.resolve_async("::1", 80, [&literal_count](kstd::Result<std::vector<SocketAddress>> result) {
+        literal_count = result.get_or_throw().size();
+    });
+    ASSERT_EQ(literal_count, 1);
+}
+
+TEST(sockslib_DnsResolver, test_unreachable_name_server) {
+    using namespace sockslib;
+    DnsResolver resolver {SocketAddress::from_literal("127.0.0.1", 1338).get(), 1, std::chrono::milliseconds {200}};
+    const auto result = resolver.resolve_addresses("example.test");
+    ASSERT_FALSE(result);
+    ASSERT_EQ(result.get_error().operation(), SocketOperation::RESOLVE);
+    ASSERT_TRUE(result.get_error().code() == ECONNREFUSED || result.get_error().timed_out());
+    ASSERT_EQ(resolver.cache_size(), 0);
+}
+
+TEST(sockslib_DnsResolver, test_error_codes) {
+    using namespace sockslib;
+    StubDnsServer server {};
+    DnsResolver resolver {stub_name_server()};
+    ASSERT_EQ(resolver.resolve_addresses("missing.test").get_error(), SocketError(SocketOperation::RESOLVE, ENOENT));
+    ASSERT_EQ(resolver.resolve_addresses("fail.test").get_error().code(), EIO);
+    ASSERT_EQ(resolver.resolve_addresses("invalid..test").get_error().code(), EINVAL);
+    ASSERT_EQ(resolver.resolve_addresses("example.test", 80).get_or_throw().size(), 3);
+}
+
+TEST(sockslib_DnsResolver, test_system_configuration) {
+    using namespace sockslib;
+    DnsResolver resolver {};
+    ASSERT_TRUE(resolver.name_server().is_empty());
+
+    // localhost is answered through getaddrinfo (usually from /etc/hosts) and cached afterwards
+    const auto addresses = resolver.resolve("localhost", 80).get_or_throw();
+    ASSERT_FALSE(addresses.empty());
+    for(const auto& address : addresses) {
+        ASSERT_EQ(address.port(), 80);
+    }
+    ASSERT_EQ(resolver.cache_size(), 1);
+
+    std::promise<kstd::usize> address_count {};
+    resolver.resolve_async("localhost", 80, [&address_count](kstd::Result<std::vector<SocketAddress>> result) {
+        address_count.set_value(result ? result.get().size() : 0);
+    });
+    ASSERT_EQ(address_count.get_future().get(), addresses.size());
+}
+#endif
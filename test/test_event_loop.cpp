@@ -0,0 +1,240 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/event_loop.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <kstd/safe_alloc.hpp>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    // Echoes everything back and closes accepted sockets once the peer disconnects
+    auto add_echo_server(sockslib::EventLoop& event_loop, sockslib::ServerSocket& server_socket,
+                         std::unordered_map<sockslib::SocketHandle, sockslib::AcceptedSocket>& accepted_sockets) {
+        using namespace sockslib;
+        event_loop.add(server_socket, [&event_loop, &accepted_sockets](AcceptedSocket socket) {
+            const auto handle = socket.socket_handle();
+            accepted_sockets.emplace(handle, std::move(socket));
+            event_loop.add(handle, EventType::READ, [&event_loop, &accepted_sockets, handle](auto) {
+                auto& socket = accepted_sockets.at(handle);
+                std::array<kstd::u8, 256> buffer {};
+                while(true) {
+                    auto read_result = socket.try_read(buffer.data(), buffer.size());
+                    if(!read_result || read_result.get().is_empty()) {
+                        return;
+                    }
+
+                    const auto bytes_read = read_result.get().get();
+                    if(bytes_read == 0) {
+                        event_loop.remove(handle).throw_if_error();
+                        accepted_sockets.erase(handle);
+                        return;
+                    }
+                    socket.try_write(buffer.data(), bytes_read).throw_if_error();
+                }
+            }).throw_if_error();
+        }).throw_if_error();
+    }
+
+    // Lowers the file descriptor limit to the lowest free descriptor, so every new descriptor fails with EMFILE
+    class HandleLimit final {
+        rlimit _limit {};
+
+        public:
+        HandleLimit() {
+            getrlimit(RLIMIT_NOFILE, &_limit);
+            const auto free_handle = open("/dev/null", O_RDONLY | O_CLOEXEC);
+            close(free_handle);
+            rlimit limit {static_cast<rlim_t>(free_handle), _limit.rlim_max};
+            setrlimit(RLIMIT_NOFILE, &limit);
+        }
+
+        HandleLimit(const HandleLimit& other) = delete;
+        HandleLimit(HandleLimit&& other) = delete;
+
+        ~HandleLimit() noexcept {
+            setrlimit(RLIMIT_NOFILE, &_limit);
+        }
+
+        auto operator=(const HandleLimit& other) -> HandleLimit& = delete;
+        auto operator=(HandleLimit&& other) -> HandleLimit& = delete;
+    };
+}// namespace
+
+TEST(sockslib_EventLoop, test_non_blocking_read) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    client_socket_result.throw_if_error();
+
+    server_socket.set_blocking(false).throw_if_error();
+    auto accept_result = server_socket.try_accept();
+    accept_result.throw_if_error();
+    ASSERT_FALSE(accept_result.get().is_empty());
+    auto& socket = accept_result.get().get();
+    ASSERT_TRUE(server_socket.try_accept().get_or_throw().is_empty());
+
+    kstd::u8 data = 0;
+    ASSERT_TRUE(socket.try_read(&data, sizeof(data)).get_or_throw().is_empty());
+}
+
+TEST(sockslib_EventLoop, test_accept_error) {
+    using namespace sockslib;
+    auto event_loop_result = kstd::try_construct<EventLoop>();
+    auto& event_loop = event_loop_result.get_or_throw();
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    std::vector<AcceptedSocket> accepted_sockets {};
+    std::vector<SocketError> errors {};
+    const auto accept_callback = [&accepted_sockets](AcceptedSocket socket) {
+        accepted_sockets.push_back(std::move(socket));
+    };
+    const auto error_callback = [&errors](const SocketError error) {
+        errors.push_back(error);
+    };
+    event_loop.add(server_socket, accept_callback, error_callback).throw_if_error();
+
+    // Accepting fails without free file descriptors, the connection stays queued
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    client_socket_result.throw_if_error();
+    {
+        HandleLimit limit {};
+        static_cast<void>(event_loop.poll(1000).get_or_throw());
+    }
+    ASSERT_EQ(errors.size(), 1);
+    ASSERT_EQ(errors[0], SocketError(SocketOperation::ACCEPT, EMFILE));
+    ASSERT_TRUE(accepted_sockets.empty());
+
+    // Re-arming the event accepts the queued connection
+    event_loop.modify(server_socket.socket_handle(), EventType::READ).throw_if_error();
+    static_cast<void>(event_loop.poll(1000).get_or_throw());
+    ASSERT_EQ(accepted_sockets.size(), 1);
+    ASSERT_EQ(errors.size(), 1);
+}
+
+TEST(sockslib_EventLoop, test_add_failure_keeps_flags) {
+    using namespace sockslib;
+    auto event_loop_result = kstd::try_construct<EventLoop>();
+    auto& event_loop = event_loop_result.get_or_throw();
+
+    // Regular files can't be polled, so the registration fails after the handle was switched to non-blocking
+    auto* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    const auto handle = fileno(file);
+    const auto flags = fcntl(handle, F_GETFL, 0);
+    ASSERT_FALSE(event_loop.add(handle, EventType::READ, [](auto) {}));
+    ASSERT_EQ(fcntl(handle, F_GETFL, 0), flags);
+    std::fclose(file);
+}
+
+TEST(sockslib_EventLoop, test_stop) {
+    using namespace sockslib;
+    auto event_loop_result = kstd::try_construct<EventLoop>();
+    auto& event_loop = event_loop_result.get_or_throw();
+    auto thread = std::thread {[&event_loop] {
+        event_loop.run().throw_if_error();
+    }};
+    event_loop.stop();
+    thread.join();
+}
+
+TEST(sockslib_EventLoop, test_echo_10k_connections) {
+    using namespace sockslib;
+    constexpr kstd::usize connection_count = 10000;
+
+    // Every connection needs a client and a server side file descriptor
+    constexpr rlim_t required_handles = connection_count * 2 + 64;
+    rlimit limit {};
+    getrlimit(RLIMIT_NOFILE, &limit);
+    if(limit.rlim_cur < required_handles) {
+        const rlimit raised_limit {required_handles, std::max(limit.rlim_max, required_handles)};
+        if(setrlimit(RLIMIT_NOFILE, &raised_limit) == 0) {
+            limit = raised_limit;
+        }
+    }
+    if(limit.rlim_cur < required_handles) {
+        GTEST_SKIP() << "File descriptor limit too low for " << connection_count << " connections";
+    }
+
+    auto event_loop_result = kstd::try_construct<EventLoop>();
+    auto& event_loop = event_loop_result.get_or_throw();
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    std::unordered_map<SocketHandle, AcceptedSocket> accepted_sockets {};
+    add_echo_server(event_loop, server_socket, accepted_sockets);
+    auto thread = std::thread {[&event_loop] {
+        event_loop.run().throw_if_error();
+    }};
+
+    std::vector<ClientSocket> client_sockets {};
+    client_sockets.reserve(connection_count);
+    for(kstd::usize i = 0; i < connection_count; ++i) {
+        auto& socket = client_sockets.emplace_back("127.0.0.1", 1337, ProtocolType::TCP);
+        auto data = static_cast<kstd::u8>(i);
+        socket.write(&data, sizeof(data)).throw_if_error();
+    }
+
+    kstd::usize echoed_count = 0;
+    for(kstd::usize i = 0; i < connection_count; ++i) {
+        kstd::u8 data = 0;
+        if(client_sockets[i].read(&data, sizeof(data)).get_or(0) == 1 && data == static_cast<kstd::u8>(i)) {
+            ++echoed_count;
+        }
+    }
+
+    event_loop.stop();
+    thread.join();
+    ASSERT_EQ(echoed_count, connection_count);
+}
+
+TEST(sockslib_EventLoop, test_idle_timeout) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto event_loop_result = kstd::try_construct<EventLoop>();
+    auto& event_loop = event_loop_result.get_or_throw();
+    std::unordered_map<SocketHandle, AcceptedSocket> accepted_sockets {};
+    std::vector<SocketHandle> reaped_handles {};
+    event_loop.set_idle_timeout(std::chrono::milliseconds {100}, [&](const SocketHandle socket_handle) {
+        event_loop.remove(socket_handle).throw_if_error();
+        accepted_sockets.erase(socket_handle);
+        reaped_handles.push_back(socket_handle);
+    });
+    add_echo_server(event_loop, server_socket, accepted_sockets);
+
+    auto active_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& active_socket = active_socket_result.get_or_throw();
+    auto idle_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& idle_socket = idle_socket_result.get_or_throw();
+
+    // The active connection sends more often than the timeout, the idle one never sends anything
+    const auto start = std::chrono::steady_clock::now();
+    auto next_write = start;
+    while(std::chrono::steady_clock::now() - start < std::chrono::milliseconds {400}) {
+        if(std::chrono::steady_clock::now() >= next_write) {
+            kstd::u8 data = 1;
+            active_socket.write(&data, sizeof(data)).throw_if_error();
+            next_write += std::chrono::milliseconds {30};
+        }
+        event_loop.poll(10).throw_if_error();
+    }
+
+    ASSERT_EQ(reaped_handles.size(), 1);
+    ASSERT_EQ(accepted_sockets.size(), 1);
+    ASSERT_EQ(event_loop.idle_timer_count(), 1);
+    ASSERT_EQ(event_loop.registration_count(), 2);
+
+    // The reaped connection was closed, the active one still echoes
+    kstd::u8 data = 0;
+    ASSERT_EQ(idle_socket.read(&data, sizeof(data)).get_or(1), 0);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {1};
+    ASSERT_EQ(active_socket.read(&data, sizeof(data), deadline).get_or_throw(), 1);
+}
+#endif
@@ -0,0 +1,138 @@
+#include "sockslib/frame_codec.hpp"
+#include "sockslib/socket.hpp"
+
+#include <gtest/gtest.h>
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+    // Feeds the encoded frames in chunks of chunk_size bytes into the decoder and collects the decoded payloads
+    auto decode_chunked(sockslib::FrameDecoder& decoder, const sockslib::FrameEncoder& encoder,
+                        const kstd::usize chunk_size) -> std::vector<std::string> {
+        std::vector<std::string> payloads {};
+        kstd::usize offset = 0;
+        while(offset < encoder.size()) {
+            const auto size = std::min({chunk_size, encoder.size() - offset, decoder.prepare()});
+            std::memcpy(decoder.writable_data(), encoder.data() + offset, size);
+            decoder.commit(size);
+            offset += size;
+
+            while(true) {
+                auto frame = decoder.next().get_or_throw();
+                if(frame.is_empty()) {
+                    break;
+                }
+                payloads.emplace_back(reinterpret_cast<const char*>(frame.get().data), frame.get().size);// NOLINT
+            }
+        }
+        return payloads;
+    }
+}// namespace
+
+TEST(sockslib_FrameCodec, test_encode_length_prefix) {
+    using namespace sockslib;
+    std::array<kstd::u8, max_length_prefix_size> data {};
+    ASSERT_EQ(encode_length_prefix(LengthPrefix::VARINT, 0, data.data()).get_or_throw(), 1);
+    ASSERT_EQ(encode_length_prefix(LengthPrefix::VARINT, 127, data.data()).get_or_throw(), 1);
+    ASSERT_EQ(encode_length_prefix(LengthPrefix::VARINT, 300, data.data()).get_or_throw(), 2);
+    ASSERT_EQ(data[0], 0xAC);
+    ASSERT_EQ(data[1], 0x02);
+
+    ASSERT_EQ(encode_length_prefix(LengthPrefix::FIXED_32, 0x01020304, data.data()).get_or_throw(), 4);
+    ASSERT_EQ(data[0], 0x01);
+    ASSERT_EQ(data[3], 0x04);
+
+    // Sizes beyond 32 bits only fit into the varint prefix
+    ASSERT_TRUE(encode_length_prefix(LengthPrefix::FIXED_32, 0x100000000U, data.data()).is_error());
+    ASSERT_EQ(encode_length_prefix(LengthPrefix::VARINT, 0x100000000U, data.data()).get_or_throw(), 5);
+}
+
+TEST(sockslib_FrameCodec, test_decode_frames) {
+    using namespace sockslib;
+    for(const auto prefix : {LengthPrefix::VARINT, LengthPrefix::FIXED_32}) {
+        std::vector<std::string> sent_payloads {"", "a", std::string(127, 'b'), std::string(128, 'c'),
+                                                std::string(5000, 'd'), "last"};
+        FrameEncoder encoder {prefix};
+        for(const auto& payload : sent_payloads) {
+            encoder.encode(payload.data(), payload.size()).throw_if_error();
+        }
+
+        // All frames at once, byte by byte and in chunks, which split the prefixes as well
+        for(const kstd::usize chunk_size : {kstd::usize {1}, kstd::usize {7}, kstd::usize {100000}}) {
+            FrameDecoder decoder {prefix, 1024 * 1024, 256};
+            ASSERT_EQ(decode_chunked(decoder, encoder, chunk_size), sent_payloads);
+            ASSERT_EQ(decoder.buffered_size(), 0);
+        }
+    }
+}
+
+TEST(sockslib_FrameCodec, test_grow_for_large_frame) {
+    using namespace sockslib;
+    FrameEncoder encoder {};
+    const std::string payload(10000, 'x');
+    encoder.encode(payload.data(), payload.size()).throw_if_error();
+
+    // The buffer grows once to the size announced by the prefix, instead of doubling step by step
+    FrameDecoder decoder {LengthPrefix::VARINT, 1024 * 1024, 1024};
+    ASSERT_EQ(decode_chunked(decoder, encoder, 512), std::vector<std::string> {payload});
+    ASSERT_EQ(decoder.capacity(), encoder.size());
+}
+
+TEST(sockslib_FrameCodec, test_decode_errors) {
+    using namespace sockslib;
+    FrameDecoder decoder {LengthPrefix::FIXED_32, 16};
+    const std::array<kstd::u8, 4> oversized_prefix {0, 0, 0, 17};
+    decoder.prepare();
+    std::memcpy(decoder.writable_data(), oversized_prefix.data(), oversized_prefix.size());
+    decoder.commit(oversized_prefix.size());
+    ASSERT_TRUE(decoder.next().is_error());
+
+    FrameDecoder varint_decoder {};
+    const std::array<kstd::u8, 11> long_prefix {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+    varint_decoder.prepare();
+    std::memcpy(varint_decoder.writable_data(), long_prefix.data(), long_prefix.size());
+    varint_decoder.commit(long_prefix.size());
+    ASSERT_TRUE(varint_decoder.next().is_error());
+
+    // The upper bits of the 10th byte would be shifted out, so the prefix must not decode to a size of zero
+    FrameDecoder overflow_decoder {};
+    const std::array<kstd::u8, 10> overflow_prefix {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02};
+    overflow_decoder.prepare();
+    std::memcpy(overflow_decoder.writable_data(), overflow_prefix.data(), overflow_prefix.size());
+    overflow_decoder.commit(overflow_prefix.size());
+    const auto overflow_result = overflow_decoder.next();
+    ASSERT_TRUE(overflow_result.is_error());
+    ASSERT_EQ(overflow_result.get_error(), "Unable to decode frame => Length prefix is too long");
+}
+
+TEST(sockslib_FrameCodec, test_socket_frames) {
+    using namespace sockslib;
+    ServerSocket server_socket {1337, ProtocolType::TCP};
+    ClientSocket client_socket {"127.0.0.1", 1337, ProtocolType::TCP};
+    auto socket = std::move(server_socket.accept().get_or_throw());
+
+    FrameEncoder encoder {};
+    for(kstd::usize i = 0; i < 100; ++i) {
+        encoder.encode(&i, sizeof(i)).throw_if_error();
+    }
+    encoder.write_to(client_socket).throw_if_error();
+    ASSERT_EQ(encoder.size(), 0);
+
+    FrameDecoder decoder {};
+    kstd::usize frame_count = 0;
+    while(frame_count < 100) {
+        ASSERT_GT(decoder.read_from(socket).get_or_throw(), 0);
+        while(true) {
+            const auto frame = decoder.next().get_or_throw();
+            if(frame.is_empty()) {
+                break;
+            }
+            ASSERT_EQ(frame.get().size, sizeof(kstd::usize));
+            kstd::usize value = 0;
+            std::memcpy(&value, frame.get().data, sizeof(value));
+            ASSERT_EQ(value, frame_count++);
+        }
+    }
+}
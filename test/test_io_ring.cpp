@@ -0,0 +1,102 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/io_ring.hpp"
+
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <kstd/safe_alloc.hpp>
+#include <vector>
+
+namespace {
+    auto wait_for_completions(sockslib::IoRing& ring, const kstd::u32 count) -> std::vector<sockslib::IoCompletion> {
+        ring.submit(count).throw_if_error();
+        std::vector<sockslib::IoCompletion> completions(count);
+        kstd::usize reaped = 0;
+        while(reaped < count) {
+            reaped += ring.reap(completions.data() + reaped, count - reaped);
+            if(reaped < count) {
+                ring.submit(static_cast<kstd::u32>(count - reaped)).throw_if_error();
+            }
+        }
+        return completions;
+    }
+
+    auto test_batched_echo(const bool prefer_io_uring) -> void {
+        using namespace sockslib;
+        constexpr kstd::u32 connection_count = 8;
+        auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+        auto& server_socket = server_socket_result.get_or_throw();
+        auto ring_result = kstd::try_construct<IoRing>(64, connection_count, 4096, prefer_io_uring);
+        auto& ring = ring_result.get_or_throw();
+
+        std::vector<ClientSocket> client_sockets {};
+        client_sockets.reserve(connection_count);
+        for(kstd::u32 i = 0; i < connection_count; ++i) {
+            client_sockets.emplace_back("127.0.0.1", 1337, ProtocolType::TCP);
+        }
+
+        // Accept all connections with one submission
+        for(kstd::u32 i = 0; i < connection_count; ++i) {
+            ring.prepare_accept(server_socket, i).throw_if_error();
+        }
+        std::vector<AcceptedSocket> accepted_sockets {};
+        for(const auto& completion : wait_for_completions(ring, connection_count)) {
+            ASSERT_GE(completion.result, 0);
+            accepted_sockets.emplace_back(completion.result);
+        }
+
+        // Receive the messages of all clients into the fixed buffers with one submission
+        for(kstd::u32 i = 0; i < connection_count; ++i) {
+            std::array<kstd::u8, 4> message {'p', 'i', 'n', static_cast<kstd::u8>('0' + i)};
+            client_sockets[i].write(message.data(), message.size()).throw_if_error();
+            ring.prepare_receive_fixed(accepted_sockets[i].socket_handle(), i, i).throw_if_error();
+        }
+        for(const auto& completion : wait_for_completions(ring, connection_count)) {
+            ASSERT_EQ(completion.result, 4);
+            ASSERT_EQ(ring.buffer(completion.user_data)[3], '0' + completion.user_data);
+        }
+
+        // Echo the fixed buffers back with one submission
+        for(kstd::u32 i = 0; i < connection_count; ++i) {
+            ring.prepare_send_fixed(accepted_sockets[i].socket_handle(), i, 4, i).throw_if_error();
+        }
+        for(const auto& completion : wait_for_completions(ring, connection_count)) {
+            ASSERT_EQ(completion.result, 4);
+        }
+
+        for(kstd::u32 i = 0; i < connection_count; ++i) {
+            std::array<kstd::u8, 4> message {};
+            ASSERT_EQ(client_sockets[i].read(message.data(), message.size()).get_or_throw(), 4);
+            ASSERT_EQ(message[3], '0' + i);
+        }
+    }
+}// namespace
+
+TEST(sockslib_IoRing, test_batched_echo) {
+    test_batched_echo(true);
+}
+
+TEST(sockslib_IoRing, test_batched_echo_fallback) {
+    using namespace sockslib;
+    auto ring_result = kstd::try_construct<IoRing>(8, 0, 0, false);
+    ASSERT_FALSE(ring_result.get_or_throw().uses_io_uring());
+    test_batched_echo(false);
+}
+
+TEST(sockslib_IoRing, test_error_completion) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    client_socket_result.throw_if_error();
+
+    // Receiving on a listening socket fails with ENOTCONN
+    auto ring_result = kstd::try_construct<IoRing>(8, 0, 0);
+    auto& ring = ring_result.get_or_throw();
+    kstd::u8 data = 0;
+    ring.prepare_receive(server_socket.socket_handle(), &data, sizeof(data), 42).throw_if_error();
+    const auto completions = wait_for_completions(ring, 1);
+    ASSERT_EQ(completions[0].user_data, 42);
+    ASSERT_LT(completions[0].result, 0);
+}
+#endif
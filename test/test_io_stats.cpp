@@ -0,0 +1,93 @@
+#include "sockslib/io_stats.hpp"
+#include "sockslib/socket.hpp"
+
+#include <gtest/gtest.h>
+#include <kstd/safe_alloc.hpp>
+#include <array>
+#include <thread>
+
+#ifndef PLATFORM_WINDOWS
+#include <errno.h>
+#endif
+
+TEST(sockslib_IoStatistics, test_record_and_subtract) {
+    using namespace sockslib;
+#ifdef PLATFORM_WINDOWS
+    constexpr kstd::i32 would_block = WSAEWOULDBLOCK;
+    constexpr kstd::i32 connection_reset = WSAECONNRESET;
+#else
+    constexpr kstd::i32 would_block = EAGAIN;
+    constexpr kstd::i32 connection_reset = ECONNRESET;
+#endif
+    SocketStatistics socket_statistics {};
+    socket_statistics.record(IoOperation::READ, false, 100, 100, 0, std::chrono::nanoseconds {0});
+    const auto before = socket_statistics.snapshot();
+    socket_statistics.record(IoOperation::READ, false, 10, 100, 0, std::chrono::nanoseconds {1000});
+    socket_statistics.record(IoOperation::READ, true, 0, 100, would_block, std::chrono::nanoseconds {0});
+    socket_statistics.record(IoOperation::WRITE, true, 0, 100, connection_reset, std::chrono::nanoseconds {0});
+    socket_statistics.record(IoOperation::ACCEPT, false, 0, 0, 0, std::chrono::nanoseconds {0});
+
+    const auto statistics = socket_statistics.snapshot() - before;
+    const auto& read_counters = statistics[IoOperation::READ];
+    ASSERT_EQ(read_counters.calls, 2);
+    ASSERT_EQ(read_counters.bytes, 10);
+    ASSERT_EQ(read_counters.short_count, 1);
+    ASSERT_EQ(read_counters.would_block_count, 1);
+    ASSERT_EQ(read_counters.error_count, 0);
+    ASSERT_EQ(read_counters.latency_histogram[9], 1);// 1000ns is in [512, 1024)
+    ASSERT_EQ(statistics[IoOperation::WRITE].error_count, 1);
+    ASSERT_EQ(statistics[IoOperation::ACCEPT].calls, 1);
+    ASSERT_EQ(statistics[IoOperation::ACCEPT].short_count, 0);
+
+    // Would-block failures are expected with non-blocking sockets and aren't counted as errors
+    ASSERT_EQ(statistics.error_count(connection_reset), 1);
+    ASSERT_EQ(statistics.error_count(would_block), 0);
+}
+
+#ifdef SOCKSLIB_IO_STATS
+TEST(sockslib_IoStatistics, test_socket_calls) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    SocketStatistics server_statistics {};
+    server_socket.set_statistics(&server_statistics);
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+    auto socket = std::move(server_socket.accept().get_or_throw());
+    ASSERT_EQ(server_statistics.snapshot()[IoOperation::ACCEPT].calls, 1);
+
+    SocketStatistics client_statistics {};
+    client_socket.set_statistics(&client_statistics);
+    const auto global_before = global_io_statistics();
+
+    std::array<kstd::u8, 8> data {1, 2, 3, 4, 5, 6, 7, 8};
+    ASSERT_EQ(socket.write(data.data(), 4).get_or_throw(), 4);
+    std::array<kstd::u8, 8> received_data {};
+    ASSERT_EQ(client_socket.read(received_data.data(), received_data.size()).get_or_throw(), 4);
+    ASSERT_TRUE(client_socket.try_read(received_data.data(), received_data.size()).get_or_throw().is_empty());
+
+    const auto client_counters = client_statistics.snapshot()[IoOperation::READ];
+    ASSERT_EQ(client_counters.calls, 2);
+    ASSERT_EQ(client_counters.bytes, 4);
+    ASSERT_EQ(client_counters.short_count, 1);
+    ASSERT_EQ(client_counters.would_block_count, 1);
+    ASSERT_EQ(client_statistics.snapshot()[IoOperation::WRITE].calls, 0);
+
+    // The counters of the thread include the calls on sockets without attached statistics
+    const auto global_statistics = global_io_statistics() - global_before;
+    ASSERT_EQ(global_statistics[IoOperation::WRITE].calls, 1);
+    ASSERT_EQ(global_statistics[IoOperation::WRITE].bytes, 4);
+    ASSERT_EQ(global_statistics[IoOperation::READ].calls, 2);
+}
+
+TEST(sockslib_IoStatistics, test_finished_threads) {
+    using namespace sockslib;
+    const auto before = global_io_statistics();
+    std::thread {[]() {
+        detail::thread_io_statistics().record(IoOperation::READ, false, 42, 42, 0, std::chrono::nanoseconds {0});
+    }}.join();
+
+    // The counters of finished threads are kept
+    ASSERT_EQ((global_io_statistics() - before)[IoOperation::READ].bytes, 42);
+}
+#endif
@@ -0,0 +1,117 @@
+#include "sockslib/reactor.hpp"
+
+#if defined(PLATFORM_LINUX) && defined(KSTD_CPP_20)
+#include <gtest/gtest.h>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace {
+    auto echo(sockslib::Reactor& reactor, sockslib::AcceptedSocket socket) -> sockslib::Task<> {
+        std::array<kstd::u8, 64> buffer {};
+        while(true) {
+            const auto bytes_read = (co_await socket.async_read(reactor, buffer.data(), buffer.size())).get_or_throw();
+            if(bytes_read == 0) {
+                co_return;
+            }
+            (co_await socket.async_write(reactor, buffer.data(), bytes_read)).throw_if_error();
+        }
+    }
+
+    auto serve(sockslib::Reactor& reactor, const sockslib::ServerSocket& server_socket,
+               const kstd::usize connection_count) -> sockslib::Task<> {
+        for(kstd::usize i = 0; i < connection_count; ++i) {
+            auto socket = std::move((co_await server_socket.async_accept(reactor)).get_or_throw());
+            reactor.spawn(echo(reactor, std::move(socket)));
+        }
+    }
+
+    auto request(sockslib::Reactor& reactor, const std::string message, kstd::usize& verified_count)
+            -> sockslib::Task<> {
+        using namespace sockslib;
+        const auto address = SocketAddress::from_literal("127.0.0.1", 1337).get();
+        auto connect_result = co_await ClientSocket::async_connect(reactor, address, ProtocolType::TCP);
+        auto socket = std::move(connect_result.get_or_throw());
+        (co_await socket.async_write(reactor, message.data(), message.size())).throw_if_error();
+
+        std::string response(message.size(), '\0');
+        kstd::usize bytes_read = 0;
+        while(bytes_read < response.size()) {
+            auto* data = reinterpret_cast<kstd::u8*>(response.data()) + bytes_read;// NOLINT
+            const auto result = co_await socket.async_read(reactor, data, response.size() - bytes_read);
+            bytes_read += result.get();
+        }
+        if(response == message) {
+            ++verified_count;
+        }
+    }
+}// namespace
+
+TEST(sockslib_Reactor, test_echo) {
+    using namespace sockslib;
+    constexpr kstd::usize connection_count = 32;
+    ServerSocket server_socket {1337, ProtocolType::TCP};
+    Reactor reactor {};
+    kstd::usize verified_count = 0;
+
+    reactor.spawn(serve(reactor, server_socket, connection_count));
+    for(kstd::usize i = 0; i < connection_count; ++i) {
+        reactor.spawn(request(reactor, std::string(1000 + i, static_cast<char>('a' + i % 26)), verified_count));
+    }
+    reactor.run().throw_if_error();
+
+    ASSERT_EQ(reactor.task_count(), 0);
+    ASSERT_EQ(reactor.waiting_count(), 0);
+    ASSERT_EQ(verified_count, connection_count);
+}
+
+TEST(sockslib_Reactor, test_connect_refused) {
+    using namespace sockslib;
+    Reactor reactor {};
+    SocketError error {SocketOperation::CONNECT, 0};
+    reactor.spawn([](Reactor& reactor, SocketError& error) -> Task<> {
+        const auto address = SocketAddress::from_literal("127.0.0.1", 1337).get();
+        const auto result = co_await ClientSocket::async_connect(reactor, address, ProtocolType::TCP);
+        error = result.get_error();
+    }(reactor, error));
+    reactor.run().throw_if_error();
+    ASSERT_EQ(error, (SocketError {SocketOperation::CONNECT, ECONNREFUSED}));
+}
+
+TEST(sockslib_Reactor, test_destroy_pending_tasks) {
+    using namespace sockslib;
+    ServerSocket server_socket {1337, ProtocolType::TCP};
+    const auto token = std::make_shared<kstd::usize>(0);
+    {
+        Reactor reactor {};
+        reactor.spawn([](Reactor& reactor, const ServerSocket& server_socket,
+                         const std::shared_ptr<kstd::usize> token) -> Task<> {
+            static_cast<void>(co_await server_socket.async_accept(reactor));
+            ++*token;
+        }(reactor, server_socket, token));
+        ASSERT_EQ(reactor.task_count(), 1);
+        ASSERT_EQ(reactor.waiting_count(), 1);
+        ASSERT_EQ(token.use_count(), 2);
+    }
+
+    // The reactor destroyed the task without resuming it
+    ASSERT_EQ(token.use_count(), 1);
+    ASSERT_EQ(*token, 0);
+}
+
+TEST(sockslib_Reactor, test_pooled_frames) {
+    using namespace sockslib;
+    Reactor reactor {};
+    const auto reused_count = detail::reused_frame_count();
+    for(kstd::usize i = 0; i < 16; ++i) {
+        reactor.spawn([]() -> Task<> {
+            co_return;
+        }());
+    }
+
+    // Every completed task released its frames, which the next task reused
+    ASSERT_EQ(reactor.task_count(), 0);
+    ASSERT_GE(detail::reused_frame_count() - reused_count, 15 * 2);
+}
+#endif
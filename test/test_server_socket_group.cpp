@@ -0,0 +1,125 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/server_socket_group.hpp"
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <kstd/safe_alloc.hpp>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+
+namespace {
+    // Connects the clients, lets the workers answer with their index and returns the set of answering workers
+    auto collect_workers(sockslib::ServerSocketGroup& group, const kstd::usize connection_count)
+            -> std::set<kstd::u8> {
+        using namespace sockslib;
+        group.start([](const kstd::usize worker_index, AcceptedSocket socket) {
+                 auto data = static_cast<kstd::u8>(worker_index);
+                 socket.write(&data, sizeof(data)).throw_if_error();
+             })
+                .throw_if_error();
+
+        std::set<kstd::u8> workers {};
+        for(kstd::usize i = 0; i < connection_count; ++i) {
+            ClientSocket client_socket {"127.0.0.1", 1337, ProtocolType::TCP};
+            kstd::u8 data = 0;
+            if(client_socket.read(&data, sizeof(data)).get_or_throw() == 1) {
+                workers.insert(data);
+            }
+        }
+        group.stop();
+        return workers;
+    }
+
+    // Lowers the file descriptor limit to the lowest free descriptor, so every new descriptor fails with EMFILE
+    class HandleLimit final {
+        rlimit _limit {};
+
+        public:
+        HandleLimit() {
+            getrlimit(RLIMIT_NOFILE, &_limit);
+            const auto free_handle = open("/dev/null", O_RDONLY | O_CLOEXEC);
+            close(free_handle);
+            rlimit limit {static_cast<rlim_t>(free_handle), _limit.rlim_max};
+            setrlimit(RLIMIT_NOFILE, &limit);
+        }
+
+        HandleLimit(const HandleLimit& other) = delete;
+        HandleLimit(HandleLimit&& other) = delete;
+
+        ~HandleLimit() noexcept {
+            setrlimit(RLIMIT_NOFILE, &_limit);
+        }
+
+        auto operator=(const HandleLimit& other) -> HandleLimit& = delete;
+        auto operator=(HandleLimit&& other) -> HandleLimit& = delete;
+    };
+}// namespace
+
+TEST(sockslib_ServerSocket, test_reuse_port) {
+    using namespace sockslib;
+    auto first_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP, true);
+    first_socket_result.throw_if_error();
+    auto second_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP, true);
+    second_socket_result.throw_if_error();
+    ASSERT_TRUE(kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP).is_error());
+}
+
+TEST(sockslib_ServerSocketGroup, test_spread_connections) {
+    using namespace sockslib;
+    auto group_result = kstd::try_construct<ServerSocketGroup>(1337, 4);
+    auto& group = group_result.get_or_throw();
+    ASSERT_EQ(group.server_sockets().size(), 4);
+
+    // The kernel hashes the connections across the listeners, 64 connections hitting only one is practically impossible
+    const auto workers = collect_workers(group, 64);
+    ASSERT_GT(workers.size(), 1);
+    ASSERT_LT(*workers.rbegin(), 4);
+}
+
+TEST(sockslib_ServerSocketGroup, test_cpu_steering) {
+    using namespace sockslib;
+    auto group_result = kstd::try_construct<ServerSocketGroup>(1337, 4, true);
+    auto& group = group_result.get_or_throw();
+    const auto workers = collect_workers(group, 16);
+    ASSERT_FALSE(workers.empty());
+    ASSERT_LT(*workers.rbegin(), 4);
+}
+
+TEST(sockslib_ServerSocketGroup, test_accept_error) {
+    using namespace sockslib;
+    auto group_result = kstd::try_construct<ServerSocketGroup>(1337, 1);
+    auto& group = group_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    client_socket_result.throw_if_error();
+
+    // The worker reports the failed accept and accepts the queued connection once descriptors are free again
+    std::atomic<kstd::i32> error_code {0};
+    std::atomic<bool> accepted {false};
+    const auto handler = [&accepted](kstd::usize, AcceptedSocket) {
+        accepted = true;
+    };
+    const auto error_handler = [&error_code](kstd::usize, const SocketError error) {
+        error_code = error.code();
+    };
+    {
+        HandleLimit limit {};
+        group.start(handler, error_handler).throw_if_error();
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {1};
+        while(error_code == 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds {1});
+        }
+    }
+    ASSERT_EQ(error_code, EMFILE);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {1};
+    while(!accepted && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds {1});
+    }
+    ASSERT_TRUE(accepted);
+    group.stop();
+}
+#endif
@@ -2,7 +2,15 @@
 
 #include <gtest/gtest.h>
 #include <kstd/safe_alloc.hpp>
+#include <array>
+#include <chrono>
 #include <thread>
+#include <vector>
+
+#ifndef PLATFORM_WINDOWS
+#include <cstdlib>
+#include <unistd.h>
+#endif
 
 TEST(sockslib_ServerSocket, test_bind_tcp_socket) {
     using namespace sockslib;
@@ -87,3 +95,437 @@ TEST(sockslib_ClientSocket, test_tcp_socket_write_read) {
 
     ASSERT_EQ(data, 1);
 }
+
+#ifdef KSTD_CPP_20
+TEST(sockslib_ClientSocket, test_tcp_socket_write_read_vectored) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+    auto socket = std::move(server_socket.accept().get_or_throw());
+
+    // Send a framed message (header + payload) with one syscall
+    const std::array<kstd::u8, 2> header {0, 5};
+    const std::array<kstd::u8, 5> payload {'h', 'e', 'l', 'l', 'o'};
+    const std::array<std::span<const kstd::u8>, 2> buffers {header, payload};
+    ASSERT_EQ(socket.write_all(buffers).get_or_throw(), 7);
+
+    std::array<kstd::u8, 2> received_header {};
+    std::array<kstd::u8, 5> received_payload {};
+    const std::array<std::span<kstd::u8>, 2> received_buffers {received_header, received_payload};
+    kstd::usize bytes_read = 0;
+    while(bytes_read < 7) {
+        const auto result = client_socket.read(received_buffers).get_or_throw();
+        ASSERT_GT(result, 0);
+        bytes_read += result;
+    }
+    ASSERT_EQ(received_header, header);
+    ASSERT_EQ(received_payload, payload);
+}
+
+TEST(sockslib_ClientSocket, test_tcp_socket_write_all_partial) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+    auto socket = std::move(server_socket.accept().get_or_throw());
+
+    // The buffers exceed the socket buffers by far, so the kernel only takes them in partial writes
+    constexpr kstd::usize buffer_size = 4 * 1024 * 1024;
+    std::vector<std::vector<kstd::u8>> buffers {};
+    std::vector<std::span<const kstd::u8>> spans {};
+    for(kstd::u8 i = 0; i < 3; ++i) {
+        auto& buffer = buffers.emplace_back(buffer_size, static_cast<kstd::u8>(i + 1));
+        spans.emplace_back(buffer);
+    }
+
+    auto thread = std::thread {[&socket, &spans] {
+        socket.write_all(spans).throw_if_error();
+    }};
+
+    std::vector<kstd::u8> received(buffer_size * 3);
+    kstd::usize bytes_read = 0;
+    while(bytes_read < received.size()) {
+        const auto result = client_socket.read(received.data() + bytes_read, received.size() - bytes_read);
+        if(!result || result.get() == 0) {
+            break;
+        }
+        bytes_read += result.get();
+    }
+    thread.join();
+
+    ASSERT_EQ(bytes_read, received.size());
+    for(kstd::usize i = 0; i < 3; ++i) {
+        ASSERT_EQ(received[i * buffer_size], i + 1);
+        ASSERT_EQ(received[(i + 1) * buffer_size - 1], i + 1);
+    }
+}
+#endif
+
+TEST(sockslib_AcceptedSocket, test_read_deadline) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+    auto socket = std::move(server_socket.accept().get_or_throw());
+
+    kstd::u8 data = 0;
+    const auto start = std::chrono::steady_clock::now();
+    const auto read_result = socket.read(&data, sizeof(data), start + std::chrono::milliseconds {50});
+    ASSERT_TRUE(read_result.is_error());
+    ASSERT_TRUE(read_result.get_error().timed_out());
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds {50});
+
+    // Pending data is read, even if the deadline already passed
+    data = 42;
+    client_socket.write(&data, sizeof(data), start).throw_if_error();
+    data = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {5};
+    ASSERT_EQ(socket.read(&data, sizeof(data), deadline).get_or_throw(), 1);
+    ASSERT_EQ(data, 42);
+}
+
+TEST(sockslib_ServerSocket, test_accept_deadline) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    const auto start = std::chrono::steady_clock::now();
+    const auto accept_result = server_socket.accept(start + std::chrono::milliseconds {50});
+    ASSERT_TRUE(accept_result.is_error());
+    ASSERT_TRUE(accept_result.get_error().timed_out());
+    ASSERT_EQ(accept_result.get_error().operation(), SocketOperation::ACCEPT);
+
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    client_socket_result.throw_if_error();
+    server_socket.accept(std::chrono::steady_clock::now() + std::chrono::seconds {5}).throw_if_error();
+}
+
+TEST(sockslib_ClientSocket, test_socket_timeouts) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    server_socket_result.throw_if_error();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+    client_socket.set_timeouts(std::chrono::milliseconds {50}, std::chrono::milliseconds {0}).throw_if_error();
+
+    kstd::u8 data = 0;
+    const auto start = std::chrono::steady_clock::now();
+    const auto read_result = client_socket.read(&data, sizeof(data));
+    ASSERT_TRUE(read_result.is_error());
+    ASSERT_TRUE(read_result.get_error().timed_out());
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds {45});
+}
+
+TEST(sockslib_ClientSocket, test_socket_options) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    server_socket_result.throw_if_error();
+
+    SocketOptions options {};
+    options.no_delay = true;
+    options.receive_buffer_size = 1 << 16;
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP, options);
+    auto& client_socket = client_socket_result.get_or_throw();
+    auto current_options = client_socket.get_options().get_or_throw();
+    ASSERT_TRUE(current_options.no_delay.get());
+    ASSERT_GE(current_options.receive_buffer_size.get(), 1 << 16);
+
+    SocketOptions changed_options {};
+    changed_options.no_delay = false;
+    client_socket.set_options(changed_options).throw_if_error();
+    ASSERT_FALSE(client_socket.get_options().get_or_throw().no_delay.get());
+}
+
+#ifndef PLATFORM_WINDOWS
+namespace {
+    // Creates an unlinked temporary file filled with a repeating pattern, which is removed when it gets closed
+    auto create_pattern_file(const kstd::usize size) -> int {
+        std::array<char, 20> path {"/tmp/sockslibXXXXXX"};
+        const auto file_handle = mkstemp(path.data());
+        unlink(path.data());
+
+        std::vector<kstd::u8> buffer(size);
+        for(kstd::usize i = 0; i < size; ++i) {
+            buffer[i] = static_cast<kstd::u8>(i % 251);
+        }
+        kstd::usize bytes_written = 0;
+        while(bytes_written < size) {
+            const auto result = ::write(file_handle, buffer.data() + bytes_written, size - bytes_written);
+            bytes_written += static_cast<kstd::usize>(result);
+        }
+        return file_handle;
+    }
+
+    auto read_exactly(const sockslib::ClientSocket& socket, const kstd::usize size) -> std::vector<kstd::u8> {
+        std::vector<kstd::u8> received(size);
+        kstd::usize bytes_read = 0;
+        while(bytes_read < size) {
+            const auto result = socket.read(received.data() + bytes_read, size - bytes_read);
+            if(!result || result.get() == 0) {
+                break;
+            }
+            bytes_read += result.get();
+        }
+        received.resize(bytes_read);
+        return received;
+    }
+}// namespace
+
+TEST(sockslib_AcceptedSocket, test_send_file) {
+    using namespace sockslib;
+    static constexpr kstd::usize file_size = 16 * 1024 * 1024;
+    const auto file_handle = create_pattern_file(file_size);
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+    auto socket = std::move(server_socket.accept().get_or_throw());
+
+    // Send the file with sendfile and afterwards with the copy loop over the same connection
+    auto thread = std::thread {[&socket, file_handle] {
+        ASSERT_EQ(socket.send_file(file_handle, 0, file_size).get_or_throw(), file_size);
+
+        std::vector<kstd::u8> buffer(64 * 1024);
+        kstd::usize offset = 0;
+        while(offset < file_size) {
+            const auto bytes_read = pread(file_handle, buffer.data(), buffer.size(), static_cast<off_t>(offset));
+            ASSERT_GT(bytes_read, 0);
+            kstd::usize bytes_sent = 0;
+            while(bytes_sent < static_cast<kstd::usize>(bytes_read)) {
+                bytes_sent += socket.write(buffer.data() + bytes_sent, bytes_read - bytes_sent).get_or_throw();
+            }
+            offset += static_cast<kstd::usize>(bytes_read);
+        }
+    }};
+
+    const auto zero_copy_received = read_exactly(client_socket, file_size);
+    const auto copy_received = read_exactly(client_socket, file_size);
+    thread.join();
+    close(file_handle);
+
+    ASSERT_EQ(zero_copy_received.size(), file_size);
+    ASSERT_EQ(zero_copy_received, copy_received);
+    for(kstd::usize i = 0; i < file_size; i += 4093) {
+        ASSERT_EQ(zero_copy_received[i], i % 251);
+    }
+}
+
+TEST(sockslib_AcceptedSocket, test_send_file_range) {
+    using namespace sockslib;
+    const auto file_handle = create_pattern_file(1024);
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+    auto socket = std::move(server_socket.accept().get_or_throw());
+
+    // The second range exceeds the end of the file and stops there
+    ASSERT_EQ(socket.send_file(file_handle, 100, 10).get_or_throw(), 10);
+    ASSERT_EQ(socket.send_file(file_handle, 1000, 100).get_or_throw(), 24);
+    close(file_handle);
+
+    const auto received = read_exactly(client_socket, 34);
+    ASSERT_EQ(received.size(), 34);
+    ASSERT_EQ(received[0], 100);
+    ASSERT_EQ(received[9], 109);
+    ASSERT_EQ(received[10], 1000 % 251);
+    ASSERT_EQ(received[33], 1023 % 251);
+}
+
+TEST(sockslib_AcceptedSocket, test_send_file_would_block) {
+    using namespace sockslib;
+    const auto file_handle = create_pattern_file(1024);
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+    auto socket = std::move(server_socket.accept().get_or_throw());
+
+    // Fill the send buffer until the non-blocking socket would block, then nothing is sent without an error
+    socket.set_blocking(false).throw_if_error();
+    std::vector<kstd::u8> buffer(64 * 1024);
+    while(socket.try_write(buffer.data(), buffer.size()).get_or_throw()) {
+    }
+    ASSERT_EQ(socket.send_file(file_handle, 0, 1024).get_or_throw(), 0);
+    close(file_handle);
+    static_cast<void>(client_socket);
+}
+#endif
+
+#ifdef PLATFORM_LINUX
+namespace {
+    // Raw IPv6 listener on ::1, the server socket only supports IPv4
+    auto listen_ipv6(const kstd::u16 port, const int backlog) -> int {
+        const auto socket_handle = socket(AF_INET6, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        const int enable = 1;
+        setsockopt(socket_handle, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+        const auto address = sockslib::SocketAddress::from_literal("::1", port).get();
+        if(bind(socket_handle, address.data(), address.length()) < 0 || listen(socket_handle, backlog) < 0) {
+            close(socket_handle);
+            return -1;
+        }
+        return socket_handle;
+    }
+
+    auto peer_address_type(const sockslib::ClientSocket& socket) -> sockslib::AddressType {
+        sockslib::SocketAddress address {};
+        socklen_t length = sockslib::SocketAddress::capacity();
+        getpeername(socket.socket_handle(), address.data(), &length);
+        address.set_length(length);
+        return address.address_type();
+    }
+}// namespace
+
+TEST(sockslib_ClientSocket, test_connect_ipv6_literal) {
+    using namespace sockslib;
+    const auto listener = listen_ipv6(1338, SOMAXCONN);
+    ASSERT_GE(listener, 0);
+
+    auto socket_result = kstd::try_construct<ClientSocket>("::1", 1338, ProtocolType::TCP);
+    auto& socket = socket_result.get_or_throw();
+    ASSERT_EQ(peer_address_type(socket), AddressType::IPV6);
+    ASSERT_EQ(socket.protocol_type(), ProtocolType::TCP);
+    close(listener);
+}
+
+TEST(sockslib_ClientSocket, test_happy_eyeballs_prefers_first_family) {
+    using namespace sockslib;
+    const auto listener = listen_ipv6(1337, SOMAXCONN);
+    ASSERT_GE(listener, 0);
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    server_socket_result.throw_if_error();
+
+    const std::vector<SocketAddress> addresses {SocketAddress::from_literal("::1", 1337).get(),
+                                                SocketAddress::from_literal("127.0.0.1", 1337).get()};
+    auto socket_result = kstd::try_construct<ClientSocket>(addresses, ProtocolType::TCP);
+    ASSERT_EQ(peer_address_type(socket_result.get_or_throw()), AddressType::IPV6);
+    close(listener);
+}
+
+TEST(sockslib_ClientSocket, test_happy_eyeballs_refused_family) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    server_socket_result.throw_if_error();
+
+    // Nothing listens on ::1, so the refused attempt starts the IPv4 attempt without waiting for the delay
+    const std::vector<SocketAddress> addresses {SocketAddress::from_literal("::1", 1337).get(),
+                                                SocketAddress::from_literal("127.0.0.1", 1337).get()};
+    const auto start = std::chrono::steady_clock::now();
+    auto socket_result = kstd::try_construct<ClientSocket>(addresses, ProtocolType::TCP, std::chrono::seconds {5});
+    ASSERT_EQ(peer_address_type(socket_result.get_or_throw()), AddressType::IPV4);
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds {1});
+}
+
+TEST(sockslib_ClientSocket, test_happy_eyeballs_stalled_family) {
+    using namespace sockslib;
+
+    // A listener with a full accept queue drops further SYNs, so connects to it stall for at least a second
+    const auto listener = listen_ipv6(1337, 0);
+    ASSERT_GE(listener, 0);
+    std::vector<int> queued_connections {};
+    const auto ipv6_address = SocketAddress::from_literal("::1", 1337).get();
+    for(kstd::usize i = 0; i < 4; ++i) {
+        queued_connections.push_back(socket(AF_INET6, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+        connect(queued_connections.back(), ipv6_address.data(), ipv6_address.length());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds {100});
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    server_socket_result.throw_if_error();
+
+    const std::vector<SocketAddress> addresses {ipv6_address, SocketAddress::from_literal("127.0.0.1", 1337).get()};
+    const auto start = std::chrono::steady_clock::now();
+    auto socket_result =
+            kstd::try_construct<ClientSocket>(addresses, ProtocolType::TCP, std::chrono::milliseconds {100});
+    const auto duration = std::chrono::steady_clock::now() - start;
+    ASSERT_EQ(peer_address_type(socket_result.get_or_throw()), AddressType::IPV4);
+    ASSERT_GE(duration, std::chrono::milliseconds {100});
+    ASSERT_LT(duration, std::chrono::milliseconds {900});
+
+    for(const auto connection : queued_connections) {
+        close(connection);
+    }
+    close(listener);
+}
+
+TEST(sockslib_ClientSocket, test_connect_deadline) {
+    using namespace sockslib;
+    const auto listener = listen_ipv6(1337, 0);
+    ASSERT_GE(listener, 0);
+    std::vector<int> queued_connections {};
+    const auto ipv6_address = SocketAddress::from_literal("::1", 1337).get();
+    for(kstd::usize i = 0; i < 4; ++i) {
+        queued_connections.push_back(socket(AF_INET6, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+        connect(queued_connections.back(), ipv6_address.data(), ipv6_address.length());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds {100});
+
+    // The connect stalls on the full accept queue and is abandoned at the deadline
+    const auto start = std::chrono::steady_clock::now();
+    const auto socket_result = ClientSocket::create(std::vector<SocketAddress> {ipv6_address}, ProtocolType::TCP,
+                                                    std::chrono::milliseconds {250},
+                                                    start + std::chrono::milliseconds {100});
+    const auto duration = std::chrono::steady_clock::now() - start;
+    ASSERT_TRUE(socket_result.is_error());
+    ASSERT_EQ(socket_result.get_error(), (SocketError {SocketOperation::CONNECT, ETIMEDOUT}));
+    ASSERT_GE(duration, std::chrono::milliseconds {100});
+    ASSERT_LT(duration, std::chrono::milliseconds {900});
+
+    for(const auto connection : queued_connections) {
+        close(connection);
+    }
+    close(listener);
+}
+
+TEST(sockslib_ServerSocket, test_socket_options_linux) {
+    using namespace sockslib;
+    SocketOptions server_options {};
+    server_options.defer_accept = std::chrono::seconds {1};
+    server_options.fast_open = 16;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP, false, server_options);
+    auto& server_socket = server_socket_result.get_or_throw();
+    const auto current_server_options = server_socket.get_options().get_or_throw();
+    ASSERT_GE(current_server_options.defer_accept.get(), std::chrono::seconds {1});
+    ASSERT_EQ(current_server_options.fast_open.get(), 16);
+
+    SocketOptions client_options {};
+    client_options.cork = true;
+    client_options.not_sent_low_watermark = 1U << 14;
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP,
+                                                                  client_options);
+    auto& client_socket = client_socket_result.get_or_throw();
+    const auto current_client_options = client_socket.get_options().get_or_throw();
+    ASSERT_TRUE(current_client_options.cork.get());
+    ASSERT_EQ(current_client_options.not_sent_low_watermark.get(), 1U << 14);
+
+    // The connection is only accepted once the corked data was pushed out
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds {100};
+    ASSERT_TRUE(server_socket.accept(deadline).get_error().timed_out());
+    kstd::u8 data = 42;
+    ASSERT_EQ(client_socket.write(&data, sizeof(data)).get_or_throw(), sizeof(data));
+    SocketOptions uncork_options {};
+    uncork_options.cork = false;
+    client_socket.set_options(uncork_options).throw_if_error();
+    auto accepted_socket = server_socket.accept(std::chrono::steady_clock::now() + std::chrono::seconds {5});
+    kstd::u8 received_data = 0;
+    ASSERT_EQ(accepted_socket.get_or_throw().read(&received_data, sizeof(received_data)).get_or_throw(), 1);
+    ASSERT_EQ(received_data, data);
+
+    // TCP options are rejected by UDP sockets
+    SocketOptions tcp_options {};
+    tcp_options.no_delay = true;
+    const auto udp_socket_result = ServerSocket::create(1337, ProtocolType::UDP, false, tcp_options);
+    ASSERT_TRUE(udp_socket_result.is_error());
+    ASSERT_EQ(udp_socket_result.get_error().operation(), SocketOperation::CONFIGURE);
+}
+
+TEST(sockslib_ClientSocket, test_happy_eyeballs_unreachable) {
+    using namespace sockslib;
+    const std::vector<SocketAddress> addresses {SocketAddress::from_literal("::1", 1337).get(),
+                                                SocketAddress::from_literal("127.0.0.1", 1337).get()};
+    ASSERT_FALSE(kstd::try_construct<ClientSocket>(addresses, ProtocolType::TCP));
+    ASSERT_FALSE(kstd::try_construct<ClientSocket>(std::vector<SocketAddress> {}, ProtocolType::TCP));
+}
+#endif
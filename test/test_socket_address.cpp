@@ -0,0 +1,58 @@
+#include "sockslib/socket_address.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(sockslib_SocketAddress, test_ipv4_literal) {
+    auto address = sockslib::SocketAddress::from_literal("127.0.0.1", 1337);
+    ASSERT_FALSE(address.is_empty());
+    ASSERT_EQ(address.get().address_type(), sockslib::AddressType::IPV4);
+    ASSERT_EQ(address.get().port(), 1337);
+    ASSERT_EQ(address.get().length(), sizeof(sockaddr_in));
+    ASSERT_EQ(address.get().to_string(), "127.0.0.1:1337");
+}
+
+TEST(sockslib_SocketAddress, test_ipv6_literal) {
+    auto address = sockslib::SocketAddress::from_literal("::1", 1337);
+    ASSERT_FALSE(address.is_empty());
+    ASSERT_EQ(address.get().address_type(), sockslib::AddressType::IPV6);
+    ASSERT_EQ(address.get().port(), 1337);
+    ASSERT_EQ(address.get().length(), sizeof(sockaddr_in6));
+    ASSERT_EQ(address.get().to_string(), "[::1]:1337");
+
+    auto scoped_address = sockslib::SocketAddress::from_literal("fe80::1%17", 1337);
+    ASSERT_FALSE(scoped_address.is_empty());
+    ASSERT_EQ(reinterpret_cast<const sockaddr_in6*>(scoped_address.get().data())->sin6_scope_id, 17);// NOLINT
+}
+
+TEST(sockslib_SocketAddress, test_invalid_literal) {
+    ASSERT_TRUE(sockslib::SocketAddress::from_literal("example.com", 1337).is_empty());
+    ASSERT_TRUE(sockslib::SocketAddress {}.is_empty());
+}
+
+TEST(sockslib_SocketAddress, test_equality) {
+    const auto address = sockslib::SocketAddress::from_literal("127.0.0.1", 1337).get();
+    ASSERT_EQ(address, sockslib::SocketAddress::from_literal("127.0.0.1", 1337).get());
+    ASSERT_NE(address, sockslib::SocketAddress::from_literal("127.0.0.1", 1338).get());
+    ASSERT_NE(address, sockslib::SocketAddress::from_literal("::1", 1337).get());
+}
+
+TEST(sockslib_SocketAddress, test_interleave_address_families) {
+    using namespace sockslib;
+    const std::vector<SocketAddress> addresses {SocketAddress::from_literal("::1", 1).get(),
+                                                SocketAddress::from_literal("::2", 1).get(),
+                                                SocketAddress::from_literal("::3", 1).get(),
+                                                SocketAddress::from_literal("127.0.0.1", 1).get()};
+    const auto interleaved = interleave_address_families(addresses);
+    ASSERT_EQ(interleaved.size(), 4);
+    ASSERT_EQ(interleaved[0].address_to_string(), "::1");
+    ASSERT_EQ(interleaved[1].address_to_string(), "127.0.0.1");
+    ASSERT_EQ(interleaved[2].address_to_string(), "::2");
+    ASSERT_EQ(interleaved[3].address_to_string(), "::3");
+    ASSERT_TRUE(interleave_address_families({}).empty());
+}
+
+TEST(sockslib_SocketAddress, test_set_port) {
+    auto address = sockslib::SocketAddress::from_literal("::1", 1337).get();
+    address.set_port(80);
+    ASSERT_EQ(address.to_string(), "[::1]:80");
+}
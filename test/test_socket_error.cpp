@@ -0,0 +1,119 @@
+#include "sockslib/socket.hpp"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef PLATFORM_WINDOWS
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+TEST(sockslib_ServerSocket, test_create) {
+    using namespace sockslib;
+    auto socket_result = ServerSocket::create(1337, ProtocolType::TCP);
+    ASSERT_TRUE(socket_result);
+    ASSERT_EQ(socket_result.get().protocol_type(), ProtocolType::TCP);
+}
+
+TEST(sockslib_ClientSocket, test_create) {
+    using namespace sockslib;
+    auto server_socket_result = ServerSocket::create(1337, ProtocolType::TCP);
+    ASSERT_TRUE(server_socket_result);
+
+    auto socket_result = ClientSocket::create("127.0.0.1", 1337, ProtocolType::TCP);
+    ASSERT_TRUE(socket_result);
+    ASSERT_EQ(socket_result.get().protocol_type(), ProtocolType::TCP);
+}
+
+TEST(sockslib_ClientSocket, test_create_invalid_address) {
+    using namespace sockslib;
+    const auto socket_result = ClientSocket::create("no address", 1337, ProtocolType::TCP);
+    ASSERT_TRUE(socket_result.is_error());
+    ASSERT_EQ(socket_result.get_error().operation(), SocketOperation::RESOLVE);
+
+    const auto empty_result = ClientSocket::create(std::vector<SocketAddress> {}, ProtocolType::TCP);
+    ASSERT_TRUE(empty_result.is_error());
+    ASSERT_EQ(empty_result.get_error().operation(), SocketOperation::CONNECT);
+}
+
+// The error codes are errno values on Linux and macOS, but WSA errors on Windows
+#ifndef PLATFORM_WINDOWS
+TEST(sockslib_SocketError, test_format_message) {
+    using namespace sockslib;
+    const SocketError error {SocketOperation::READ, ECONNRESET};
+    ASSERT_EQ(error.operation(), SocketOperation::READ);
+    ASSERT_EQ(error.code(), ECONNRESET);
+    ASSERT_TRUE(error.connection_reset());
+    ASSERT_FALSE(error.would_block());
+    ASSERT_EQ(error.to_string(), fmt::format("Unable to read from socket => {}", format_error(ECONNRESET)));
+    ASSERT_EQ(static_cast<std::string>(error), error.to_string());
+}
+
+TEST(sockslib_SocketError, test_format_resolve_message) {
+    using namespace sockslib;
+    const SocketError error {SocketOperation::RESOLVE, ENOENT};
+    ASSERT_EQ(error.to_string(), "Unable to resolve address => Host not found");
+    ASSERT_TRUE((SocketError {SocketOperation::RESOLVE, ETIMEDOUT}).timed_out());
+}
+
+TEST(sockslib_SocketError, test_compare) {
+    using namespace sockslib;
+    ASSERT_EQ((SocketError {SocketOperation::WRITE, EPIPE}), (SocketError {SocketOperation::WRITE, EPIPE}));
+    ASSERT_NE((SocketError {SocketOperation::WRITE, EPIPE}), (SocketError {SocketOperation::READ, EPIPE}));
+    ASSERT_TRUE((SocketError {SocketOperation::ACCEPT, EAGAIN}).would_block());
+}
+
+TEST(sockslib_ServerSocket, test_create_port_in_use) {
+    using namespace sockslib;
+    auto socket_result = ServerSocket::create(1337, ProtocolType::TCP);
+    ASSERT_TRUE(socket_result);
+
+    const auto second_socket_result = ServerSocket::create(1337, ProtocolType::TCP);
+    ASSERT_TRUE(second_socket_result.is_error());
+    ASSERT_EQ(second_socket_result.get_error(), (SocketError {SocketOperation::BIND, EADDRINUSE}));
+
+    // The constructor reports the same error as exception
+    try {
+        ServerSocket server_socket {1337, ProtocolType::TCP};
+        FAIL();
+    }
+    catch(const std::runtime_error& error) {
+        ASSERT_EQ(std::string {error.what()}, second_socket_result.get_error().to_string());
+    }
+}
+
+TEST(sockslib_ClientSocket, test_create_refused) {
+    using namespace sockslib;
+    const auto socket_result = ClientSocket::create("127.0.0.1", 1337, ProtocolType::TCP);
+    ASSERT_TRUE(socket_result.is_error());
+    ASSERT_EQ(socket_result.get_error(), (SocketError {SocketOperation::CONNECT, ECONNREFUSED}));
+}
+
+TEST(sockslib_ClientSocket, test_try_read_errors) {
+    using namespace sockslib;
+    auto server_socket = std::move(ServerSocket::create(1337, ProtocolType::TCP).get_or_throw());
+    auto socket = std::move(ClientSocket::create("127.0.0.1", 1337, ProtocolType::TCP).get_or_throw());
+
+    // Nothing was sent yet, which is no error
+    kstd::u8 data = 0;
+    const auto accepted_socket_handle = ::accept(server_socket.socket_handle(), nullptr, nullptr);
+    ASSERT_TRUE(handle_valid(accepted_socket_handle));
+    ASSERT_TRUE(socket.try_read(&data, sizeof(data)).get_or_throw().is_empty());
+
+    // Closing with a zero linger time resets the connection
+    const linger linger_option {1, 0};
+    setsockopt(accepted_socket_handle, SOL_SOCKET, SO_LINGER, &linger_option, sizeof(linger_option));
+    close(accepted_socket_handle);
+
+    kstd::Result<kstd::Option<kstd::usize>, SocketError> read_result {};
+    do {
+        read_result = socket.try_read(&data, sizeof(data));
+    } while(read_result && read_result.get().is_empty());
+    ASSERT_TRUE(read_result.is_error());
+    ASSERT_TRUE(read_result.get_error().connection_reset());
+    ASSERT_EQ(read_result.get_error().operation(), SocketOperation::READ);
+}
+#endif
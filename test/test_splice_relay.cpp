@@ -0,0 +1,110 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/splice_relay.hpp"
+
+#include <gtest/gtest.h>
+#include <kstd/safe_alloc.hpp>
+#include <array>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST(sockslib_SpliceRelay, test_create) {
+    using namespace sockslib;
+    auto relay_result = kstd::try_construct<SpliceRelay>(128 * 1024);
+    auto& relay = relay_result.get_or_throw();
+    ASSERT_GT(relay.pipe_size(), 0);
+    ASSERT_EQ(relay.pending_size(), 0);
+}
+
+TEST(sockslib_SpliceRelay, test_forward_all) {
+    using namespace sockslib;
+    constexpr kstd::usize data_size = 16 * 1024 * 1024;
+
+    // Client -> upstream server side -> relay -> downstream client -> downstream server side
+    auto upstream_server_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& upstream_server = upstream_server_result.get_or_throw();
+    auto upstream_client_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& upstream_client = upstream_client_result.get_or_throw();
+    auto upstream_socket = std::move(upstream_server.accept().get_or_throw());
+
+    auto downstream_server_result = kstd::try_construct<ServerSocket>(1338, ProtocolType::TCP);
+    auto& downstream_server = downstream_server_result.get_or_throw();
+    auto downstream_client_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1338, ProtocolType::TCP);
+    auto& downstream_client = downstream_client_result.get_or_throw();
+    auto downstream_socket = std::move(downstream_server.accept().get_or_throw());
+
+    std::vector<kstd::u8> data(data_size);
+    for(kstd::usize i = 0; i < data_size; ++i) {
+        data[i] = static_cast<kstd::u8>(i % 251);
+    }
+
+    // The client socket closes the connection on destruction, which ends the relay
+    auto sender_thread = std::thread {[&data, client_socket = std::move(upstream_client)]() mutable {
+        kstd::usize bytes_sent = 0;
+        while(bytes_sent < data.size()) {
+            bytes_sent += client_socket.write(data.data() + bytes_sent, data.size() - bytes_sent).get_or_throw();
+        }
+    }};
+
+    kstd::usize bytes_forwarded = 0;
+    auto relay_thread = std::thread {[&] {
+        SpliceRelay relay {};
+        bytes_forwarded =
+                relay.forward_all(upstream_socket.socket_handle(), downstream_client.socket_handle()).get_or_throw();
+    }};
+
+    std::vector<kstd::u8> received(data_size);
+    kstd::usize bytes_read = 0;
+    while(bytes_read < received.size()) {
+        const auto result = downstream_socket.read(received.data() + bytes_read, received.size() - bytes_read);
+        if(!result || result.get() == 0) {
+            break;
+        }
+        bytes_read += result.get();
+    }
+    sender_thread.join();
+    relay_thread.join();
+
+    ASSERT_EQ(bytes_forwarded, data_size);
+    ASSERT_EQ(bytes_read, data_size);
+    ASSERT_EQ(received, data);
+}
+
+TEST(sockslib_SpliceRelay, test_forward_small_message) {
+    using namespace sockslib;
+    auto upstream_server_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& upstream_server = upstream_server_result.get_or_throw();
+    auto upstream_client_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& upstream_client = upstream_client_result.get_or_throw();
+    auto upstream_socket = std::move(upstream_server.accept().get_or_throw());
+
+    auto downstream_server_result = kstd::try_construct<ServerSocket>(1338, ProtocolType::TCP);
+    auto& downstream_server = downstream_server_result.get_or_throw();
+    auto downstream_client_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1338, ProtocolType::TCP);
+    auto& downstream_client = downstream_client_result.get_or_throw();
+    auto downstream_socket = std::move(downstream_server.accept().get_or_throw());
+
+    // Nothing to read from a non-blocking source yet, which isn't an error
+    SpliceRelay relay {};
+    upstream_socket.set_blocking(false).throw_if_error();
+    auto empty_result = relay.forward(upstream_socket.socket_handle(), downstream_client.socket_handle(), 64);
+    ASSERT_TRUE(empty_result.get_or_throw().is_empty());
+    upstream_socket.set_blocking(true).throw_if_error();
+
+    // The relayed message has to arrive without waiting for more data (no MSG_MORE on the destination)
+    std::array<kstd::u8, 5> data {1, 2, 3, 4, 5};
+    ASSERT_EQ(upstream_client.write(data.data(), data.size()).get_or_throw(), data.size());
+    auto result = relay.forward(upstream_socket.socket_handle(), downstream_client.socket_handle(), 64);
+    ASSERT_EQ(result.get_or_throw().get(), data.size());
+    ASSERT_EQ(relay.pending_size(), 0);
+
+    downstream_socket.set_timeouts(std::chrono::milliseconds {50}, std::chrono::milliseconds {0}).throw_if_error();
+    std::array<kstd::u8, 5> received {};
+    kstd::usize bytes_read = 0;
+    while(bytes_read < received.size()) {
+        bytes_read += downstream_socket.read(received.data() + bytes_read, received.size() - bytes_read)
+                              .get_or_throw();
+    }
+    ASSERT_EQ(received, data);
+}
+#endif
@@ -0,0 +1,81 @@
+#include "sockslib/socket.hpp"
+#include "sockslib/tcp_info.hpp"
+
+#include <gtest/gtest.h>
+#include <kstd/safe_alloc.hpp>
+#include <array>
+#include <chrono>
+#include <thread>
+
+TEST(sockslib_ClientSocket, test_tcp_info) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+    auto socket = std::move(server_socket.accept().get_or_throw());
+
+    std::array<kstd::u8, 4> data {1, 2, 3, 4};
+    ASSERT_EQ(client_socket.write(data.data(), data.size()).get_or_throw(), data.size());
+    ASSERT_EQ(socket.read(data.data(), data.size()).get_or_throw(), data.size());
+
+    // The handshake already took an RTT sample
+    const auto info = client_socket.tcp_info().get_or_throw();
+    ASSERT_GT(info.rtt.count(), 0);
+    ASSERT_GT(info.congestion_window, 0);
+    ASSERT_GT(socket.tcp_info().get_or_throw().congestion_window, 0);
+}
+
+TEST(sockslib_ClientSocket, test_tcp_info_udp) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::UDP);
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::UDP);
+    const auto info_result = client_socket_result.get_or_throw().tcp_info();
+    ASSERT_TRUE(info_result.is_error());
+    ASSERT_EQ(info_result.get_error().operation(), SocketOperation::CONFIGURE);
+}
+
+TEST(sockslib_TcpInfoSampler, test_ring_buffer) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+    auto socket = std::move(server_socket.accept().get_or_throw());
+
+    TcpInfoSampler sampler {3};
+    sampler.add(client_socket.socket_handle());
+    sampler.add(socket.socket_handle());
+    sampler.add(socket.socket_handle());
+    ASSERT_EQ(sampler.sample(), 2);
+    ASSERT_EQ(sampler.samples().size(), 2);
+    ASSERT_EQ(sampler.sample(), 2);
+
+    // The first sample got overwritten, the remaining ones are returned oldest first
+    const auto samples = sampler.samples();
+    ASSERT_EQ(samples.size(), 3);
+    ASSERT_EQ(samples[0].socket_handle, socket.socket_handle());
+    ASSERT_EQ(samples[1].socket_handle, client_socket.socket_handle());
+    ASSERT_EQ(samples[2].socket_handle, socket.socket_handle());
+    ASSERT_LE(samples[0].time, samples[1].time);
+
+    sampler.remove(client_socket.socket_handle());
+    ASSERT_EQ(sampler.sample(), 1);
+}
+
+TEST(sockslib_TcpInfoSampler, test_interval) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+    auto socket = std::move(server_socket.accept().get_or_throw());
+
+    TcpInfoSampler sampler {64, std::chrono::milliseconds {5}};
+    sampler.add(client_socket.socket_handle());
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {5};
+    while(sampler.samples().size() < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds {5});
+    }
+    ASSERT_GE(sampler.samples().size(), 2);
+}
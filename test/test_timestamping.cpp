@@ -0,0 +1,129 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/datagram_socket.hpp"
+#include "sockslib/socket.hpp"
+#include "sockslib/timestamping.hpp"
+
+#include <gtest/gtest.h>
+#include <kstd/safe_alloc.hpp>
+#include <array>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+    auto now() -> sockslib::KernelTimestamp {
+        return std::chrono::time_point_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now());
+    }
+
+    // Transmit timestamps are queued asynchronously, so they are polled for a while
+    template<typename S>
+    auto read_transmit_timestamps(const S& socket, const kstd::usize count)
+            -> std::vector<sockslib::TransmitTimestamp> {
+        std::vector<sockslib::TransmitTimestamp> timestamps {};
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {5};
+        while(timestamps.size() < count && std::chrono::steady_clock::now() < deadline) {
+            auto timestamp = socket.try_read_transmit_timestamp().get_or_throw();
+            if(timestamp) {
+                timestamps.push_back(timestamp.get());
+                continue;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds {1});
+        }
+        return timestamps;
+    }
+}// namespace
+
+TEST(sockslib_DatagramSocket, test_receive_timestamp) {
+    using namespace sockslib;
+    auto receiver_result = kstd::try_construct<DatagramSocket>(1337);
+    auto& receiver = receiver_result.get_or_throw();
+    auto sender_result = kstd::try_construct<DatagramSocket>();
+    auto& sender = sender_result.get_or_throw();
+    receiver.set_timestamping({true, false, false}).throw_if_error();
+
+    // The kernel may enable the timestamps after the first packets, so they are sent until one carries it
+    const auto address = SocketAddress::from_literal("127.0.0.1", 1337).get();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {5};
+    kstd::u8 data = 42;
+    kstd::u8 received_data = 0;
+    SocketAddress sender_address {};
+    auto before_send = now();
+    TimestampedRead read {};
+    do {
+        before_send = now();
+        ASSERT_EQ(sender.send_to(&data, sizeof(data), address).get_or_throw(), 1);
+        read = receiver.receive_from_timestamped(&received_data, sizeof(received_data), sender_address)
+                       .get_or_throw();
+    } while(!read.timestamp && std::chrono::steady_clock::now() < deadline);
+    ASSERT_EQ(read.size, 1);
+    ASSERT_EQ(received_data, data);
+    ASSERT_EQ(sender_address.port(), sender.local_address().get_or_throw().port());
+    ASSERT_TRUE(read.timestamp);
+    ASSERT_GE(read.timestamp.get(), before_send);
+    ASSERT_LE(read.timestamp.get(), now());
+}
+
+TEST(sockslib_DatagramSocket, test_transmit_timestamps) {
+    using namespace sockslib;
+    auto receiver_result = kstd::try_construct<DatagramSocket>(1337);
+    auto& receiver = receiver_result.get_or_throw();
+    auto sender_result = kstd::try_construct<DatagramSocket>();
+    auto& sender = sender_result.get_or_throw();
+    sender.set_timestamping({false, true, true}).throw_if_error();
+    ASSERT_TRUE(sender.try_read_transmit_timestamp().get_or_throw().is_empty());
+
+    const auto before_send = now();
+    const auto address = SocketAddress::from_literal("127.0.0.1", 1337).get();
+    for(kstd::u8 i = 0; i < 3; ++i) {
+        ASSERT_EQ(sender.send_to(&i, sizeof(i), address).get_or_throw(), 1);
+    }
+
+    // The datagrams are numbered in the order they were sent
+    const auto timestamps = read_transmit_timestamps(sender, 3);
+    ASSERT_EQ(timestamps.size(), 3);
+    for(kstd::u32 i = 0; i < 3; ++i) {
+        ASSERT_EQ(timestamps[i].id, i);
+        ASSERT_GE(timestamps[i].timestamp, before_send);
+    }
+    ASSERT_TRUE(sender.try_read_transmit_timestamp().get_or_throw().is_empty());
+}
+
+TEST(sockslib_AcceptedSocket, test_timestamps) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+    auto socket = std::move(server_socket.accept().get_or_throw());
+    socket.set_timestamping({true, false, false}).throw_if_error();
+
+    // The kernel may enable the timestamps after the first packets, so they are sent until one carries it
+    std::array<kstd::u8, 10> data {};
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {5};
+    TimestampedRead warmup_read {};
+    do {
+        ASSERT_EQ(client_socket.write(data.data(), data.size()).get_or_throw(), data.size());
+        warmup_read = socket.read_timestamped(data.data(), data.size()).get_or_throw();
+        ASSERT_EQ(warmup_read.size, data.size());
+    } while(!warmup_read.timestamp && std::chrono::steady_clock::now() < deadline);
+
+    client_socket.set_timestamping({false, true, true}).throw_if_error();
+    ASSERT_EQ(client_socket.write(data.data(), data.size()).get_or_throw(), data.size());
+    const auto read = socket.read_timestamped(data.data(), data.size()).get_or_throw();
+    ASSERT_EQ(read.size, data.size());
+    ASSERT_TRUE(read.timestamp);
+
+    // With TCP, the id is the offset of the last byte of the write since the id was enabled
+    const auto timestamps = read_transmit_timestamps(client_socket, 1);
+    ASSERT_EQ(timestamps.size(), 1);
+    ASSERT_EQ(timestamps[0].id, data.size() - 1);
+    ASSERT_LE(timestamps[0].timestamp, read.timestamp.get());
+
+    // Without timestamping, the reads don't carry a timestamp
+    socket.set_timestamping({false, false, false}).throw_if_error();
+    ASSERT_EQ(client_socket.write(data.data(), data.size()).get_or_throw(), data.size());
+    const auto untimed_read = socket.read_timestamped(data.data(), data.size()).get_or_throw();
+    ASSERT_EQ(untimed_read.size, data.size());
+    ASSERT_TRUE(untimed_read.timestamp.is_empty());
+}
+#endif
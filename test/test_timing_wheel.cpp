@@ -0,0 +1,90 @@
+#include "sockslib/timing_wheel.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <vector>
+
+namespace {
+    using clock = std::chrono::steady_clock;
+    using std::chrono::milliseconds;
+}// namespace
+
+TEST(sockslib_TimingWheel, test_expiry_order) {
+    using namespace sockslib;
+    const auto start = clock::now();
+    TimingWheel<int> timing_wheel {milliseconds {1}, start};
+    for(int i = 9; i >= 0; --i) {
+        timing_wheel.schedule(start + milliseconds {i * 10}, i);
+    }
+
+    std::vector<int> expired_values {};
+    const auto collect = [&expired_values](const int value) {
+        expired_values.push_back(value);
+    };
+    ASSERT_EQ(timing_wheel.advance(start + milliseconds {45}, collect), 5);
+    ASSERT_EQ(expired_values, (std::vector<int> {0, 1, 2, 3, 4}));
+    ASSERT_EQ(timing_wheel.size(), 5);
+
+    // Timers never expire before their deadline
+    ASSERT_EQ(timing_wheel.advance(start + milliseconds {49}, collect), 0);
+    ASSERT_EQ(timing_wheel.advance(start + milliseconds {50}, collect), 1);
+    ASSERT_EQ(timing_wheel.advance(start + milliseconds {1000}, collect), 4);
+    ASSERT_EQ(expired_values, (std::vector<int> {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    ASSERT_TRUE(timing_wheel.is_empty());
+}
+
+TEST(sockslib_TimingWheel, test_cascade) {
+    using namespace sockslib;
+    const auto start = clock::now();
+    TimingWheel<int> timing_wheel {milliseconds {1}, start};
+
+    // The deadlines land in all levels of the wheel and have to cascade down to the lowest one
+    const std::vector<int> delays {63, 64, 65, 4095, 4096, 4097, 262143, 262144, 300000, 5000000};
+    for(const auto delay : delays) {
+        timing_wheel.schedule(start + milliseconds {delay}, delay);
+    }
+
+    for(const auto delay : delays) {
+        std::vector<int> expired_values {};
+        const auto collect = [&expired_values](const int value) {
+            expired_values.push_back(value);
+        };
+        ASSERT_EQ(timing_wheel.advance(start + milliseconds {delay - 1}, collect), 0) << delay;
+        ASSERT_EQ(timing_wheel.next_expiry() <= start + milliseconds {delay}, true) << delay;
+        ASSERT_EQ(timing_wheel.advance(start + milliseconds {delay}, collect), 1) << delay;
+        ASSERT_EQ(expired_values, (std::vector<int> {delay}));
+    }
+    ASSERT_TRUE(timing_wheel.is_empty());
+}
+
+TEST(sockslib_TimingWheel, test_reschedule_cancel) {
+    using namespace sockslib;
+    const auto start = clock::now();
+    TimingWheel<int> timing_wheel {milliseconds {1}, start};
+    const auto first_timer = timing_wheel.schedule(start + milliseconds {10}, 1);
+    const auto second_timer = timing_wheel.schedule(start + milliseconds {10}, 2);
+    const auto third_timer = timing_wheel.schedule(start + milliseconds {10}, 3);
+
+    ASSERT_TRUE(timing_wheel.reschedule(first_timer, start + milliseconds {5000}));
+    ASSERT_TRUE(timing_wheel.cancel(second_timer));
+    ASSERT_FALSE(timing_wheel.cancel(second_timer));
+
+    // Timers scheduled or cancelled by a callback are handled like any other timer
+    std::vector<int> expired_values {};
+    TimerId fourth_timer {};
+    ASSERT_EQ(timing_wheel.advance(start + milliseconds {10}, [&](const int value) {
+        expired_values.push_back(value);
+        fourth_timer = timing_wheel.schedule(start, 4);
+    }), 1);
+    ASSERT_EQ(expired_values, (std::vector<int> {3}));
+    ASSERT_FALSE(timing_wheel.cancel(third_timer));
+
+    ASSERT_EQ(timing_wheel.advance(start + milliseconds {11}, [&](const int value) {
+        expired_values.push_back(value);
+    }), 1);
+    ASSERT_FALSE(timing_wheel.reschedule(fourth_timer, start + milliseconds {20}));
+    ASSERT_EQ(timing_wheel.advance(start + milliseconds {5000}, [&](const int value) {
+        expired_values.push_back(value);
+    }), 1);
+    ASSERT_EQ(expired_values, (std::vector<int> {3, 4, 1}));
+}
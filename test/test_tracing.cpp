@@ -0,0 +1,96 @@
+#include "sockslib/socket.hpp"
+#include "sockslib/tracing.hpp"
+
+#include <gtest/gtest.h>
+#include <kstd/safe_alloc.hpp>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+TEST(sockslib_RingBufferTraceSink, test_records) {
+    using namespace sockslib;
+    RingBufferTraceSink sink {3};// Rounded up to 4
+    for(kstd::u64 i = 0; i < 6; ++i) {
+        sink.begin(TraceEvent::SEND, 7, i * 1000);
+        sink.end(TraceEvent::SEND, 7, i * 1000 + 500, static_cast<kstd::i64>(i));
+    }
+    std::thread {[&sink]() {
+        sink.begin(TraceEvent::RECV, 8, 10000);
+        sink.end(TraceEvent::RECV, 8, 12500, -1);
+    }}.join();
+
+    // Only the latest calls of every thread are kept, the records of finished threads are kept as well
+    const auto records = sink.records();
+    ASSERT_EQ(records.size(), 5);
+    for(kstd::usize i = 0; i < 4; ++i) {
+        ASSERT_EQ(records[i].event, TraceEvent::SEND);
+        ASSERT_EQ(records[i].socket_handle, 7);
+        ASSERT_EQ(records[i].start, (i + 2) * 1000);
+        ASSERT_EQ(records[i].end - records[i].start, 500);
+        ASSERT_EQ(records[i].result, static_cast<kstd::i64>(i + 2));
+        ASSERT_EQ(records[i].thread_index, 0);
+    }
+    ASSERT_EQ(records[4].event, TraceEvent::RECV);
+    ASSERT_EQ(records[4].thread_index, 1);
+    ASSERT_EQ(records[4].result, -1);
+
+    std::ostringstream stream {};
+    sink.write_chrome_trace(stream);
+    const auto trace = stream.str();
+    ASSERT_EQ(trace.rfind(R"({"displayTimeUnit":"ns","traceEvents":[{"name":"send")", 0), 0);
+    ASSERT_NE(trace.find(R"("name":"recv","cat":"sockslib","ph":"X","ts":10.000,"dur":2.500,"pid":0,"tid":1,)"
+                         R"("args":{"fd":8,"result":-1}})"),
+              std::string::npos);
+    ASSERT_EQ(trace.substr(trace.size() - 3), "}]}");
+}
+
+TEST(sockslib_RingBufferTraceSink, test_sink_lifetime) {
+    using namespace sockslib;
+
+    // Every sink gets its own buffer on this thread, also when it reuses the memory of a destroyed one
+    for(kstd::i64 i = 0; i < 3; ++i) {
+        auto sink = std::make_unique<RingBufferTraceSink>(4);
+        sink->begin(TraceEvent::SEND, 7, 1000);
+        sink->end(TraceEvent::SEND, 7, 1500, i);
+        const auto records = sink->records();
+        ASSERT_EQ(records.size(), 1);
+        ASSERT_EQ(records[0].result, i);
+        ASSERT_EQ(records[0].thread_index, 0);
+    }
+}
+
+#ifdef SOCKSLIB_TRACING
+TEST(sockslib_RingBufferTraceSink, test_socket_calls) {
+    using namespace sockslib;
+    RingBufferTraceSink sink {};
+    set_trace_sink(&sink);
+    {
+        auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+        auto& server_socket = server_socket_result.get_or_throw();
+        auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+        auto& client_socket = client_socket_result.get_or_throw();
+        auto socket = std::move(server_socket.accept().get_or_throw());
+
+        std::array<kstd::u8, 4> data {1, 2, 3, 4};
+        ASSERT_EQ(client_socket.write(data.data(), data.size()).get_or_throw(), data.size());
+        ASSERT_EQ(socket.read(data.data(), data.size()).get_or_throw(), data.size());
+        set_trace_sink(nullptr);
+
+        const auto records = sink.records();
+        const auto find_record = [&records](const TraceEvent event, const SocketHandle socket_handle) {
+            return std::find_if(records.begin(), records.end(), [&](const TraceRecord& record) {
+                return record.event == event && record.socket_handle == static_cast<kstd::i64>(socket_handle);
+            });
+        };
+        ASSERT_NE(find_record(TraceEvent::CONNECT, client_socket.socket_handle()), records.end());
+        ASSERT_NE(find_record(TraceEvent::ACCEPT, server_socket.socket_handle()), records.end());
+        const auto send_record = find_record(TraceEvent::SEND, client_socket.socket_handle());
+        ASSERT_NE(send_record, records.end());
+        ASSERT_EQ(send_record->result, 4);
+        ASSERT_LE(send_record->start, send_record->end);
+        ASSERT_NE(find_record(TraceEvent::RECV, socket.socket_handle()), records.end());
+    }
+}
+#endif
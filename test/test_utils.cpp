@@ -32,3 +32,70 @@ TEST(sockslib_Utils, test_ipv6_addresses) {
     ASSERT_TRUE(sockslib::is_ipv6_address("fe80::1%17"));
     ASSERT_TRUE(sockslib::is_ipv6_address("::1"));
 }
+
+TEST(sockslib_Utils, test_invalid_domains) {
+    ASSERT_FALSE(sockslib::is_domain(""));
+    ASSERT_FALSE(sockslib::is_domain("de"));
+    ASSERT_FALSE(sockslib::is_domain("-cach30verfl0w.de"));
+    ASSERT_FALSE(sockslib::is_domain("cach30verfl0w-.de"));
+    ASSERT_FALSE(sockslib::is_domain("cach30verfl0w..de"));
+    ASSERT_FALSE(sockslib::is_domain("cach30verfl0w.d"));
+    ASSERT_FALSE(sockslib::is_domain("cach30verfl0w.d3"));
+    ASSERT_FALSE(sockslib::is_domain("cach30verfl0w.de."));
+    ASSERT_FALSE(sockslib::is_domain("cach30_verfl0w.de"));
+    ASSERT_FALSE(sockslib::is_domain("127.0.0.1"));
+}
+
+TEST(sockslib_Utils, test_invalid_ipv4_addresses) {
+    ASSERT_FALSE(sockslib::is_ipv4_address(""));
+    ASSERT_FALSE(sockslib::is_ipv4_address("127.0.0"));
+    ASSERT_FALSE(sockslib::is_ipv4_address("127.0.0.1."));
+    ASSERT_FALSE(sockslib::is_ipv4_address("127.0.0.256"));
+    ASSERT_FALSE(sockslib::is_ipv4_address("127.0.0.01"));
+    ASSERT_FALSE(sockslib::is_ipv4_address("127..0.1"));
+    ASSERT_FALSE(sockslib::is_ipv4_address("1270.0.0.1"));
+    ASSERT_FALSE(sockslib::is_ipv4_address("127.0.0.1a"));
+}
+
+TEST(sockslib_Utils, test_invalid_ipv6_addresses) {
+    ASSERT_FALSE(sockslib::is_ipv6_address(""));
+    ASSERT_FALSE(sockslib::is_ipv6_address(":"));
+    ASSERT_FALSE(sockslib::is_ipv6_address(":::"));
+    ASSERT_FALSE(sockslib::is_ipv6_address(":1"));
+    ASSERT_FALSE(sockslib::is_ipv6_address("1:"));
+    ASSERT_FALSE(sockslib::is_ipv6_address("1::2::3"));
+    ASSERT_FALSE(sockslib::is_ipv6_address("12345::1"));
+    ASSERT_FALSE(sockslib::is_ipv6_address("1:2:3:4:5:6:7"));
+    ASSERT_FALSE(sockslib::is_ipv6_address("1:2:3:4:5:6:7:8:9"));
+    ASSERT_FALSE(sockslib::is_ipv6_address("1:2:3:4:5:6:7::8"));
+    ASSERT_FALSE(sockslib::is_ipv6_address("fe80::1%"));
+    ASSERT_FALSE(sockslib::is_ipv6_address("::ffff:127.0.0.256"));
+    ASSERT_FALSE(sockslib::is_ipv6_address("127.0.0.1"));
+}
+
+TEST(sockslib_Utils, test_parse_ipv4_address) {
+    const auto address = sockslib::parse_ipv4_address("192.168.0.255");
+    ASSERT_FALSE(address.is_empty());
+    const std::array<kstd::u8, 4> expected {192, 168, 0, 255};
+    ASSERT_EQ(address.get().octets, expected);
+}
+
+TEST(sockslib_Utils, test_parse_ipv6_address) {
+    const auto loopback = sockslib::parse_ipv6_address("::1");
+    ASSERT_FALSE(loopback.is_empty());
+    const std::array<kstd::u8, 16> expected_loopback {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+    ASSERT_EQ(loopback.get().octets, expected_loopback);
+    ASSERT_TRUE(loopback.get().zone.empty());
+
+    const auto link_local = sockslib::parse_ipv6_address("fe80::5b3f:c05e:de1a:9df7%17");
+    ASSERT_FALSE(link_local.is_empty());
+    const std::array<kstd::u8, 16> expected_link_local {0xFE, 0x80, 0, 0, 0, 0, 0, 0,
+                                                        0x5B, 0x3F, 0xC0, 0x5E, 0xDE, 0x1A, 0x9D, 0xF7};
+    ASSERT_EQ(link_local.get().octets, expected_link_local);
+    ASSERT_EQ(link_local.get().zone, "17");
+
+    const auto mapped = sockslib::parse_ipv6_address("::ffff:127.0.0.1");
+    ASSERT_FALSE(mapped.is_empty());
+    const std::array<kstd::u8, 16> expected_mapped {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF, 127, 0, 0, 1};
+    ASSERT_EQ(mapped.get().octets, expected_mapped);
+}
@@ -0,0 +1,101 @@
+#ifdef PLATFORM_LINUX
+#include "sockslib/zero_copy_sender.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <kstd/safe_alloc.hpp>
+#include <thread>
+#include <vector>
+
+TEST(sockslib_ZeroCopySender, test_send_and_flush) {
+    using namespace sockslib;
+    constexpr kstd::usize buffer_count = 8;
+    constexpr kstd::usize buffer_size = 256 * 1024;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+    auto socket = std::move(server_socket.accept().get_or_throw());
+
+    std::vector<std::vector<kstd::u8>> buffers {};
+    for(kstd::usize i = 0; i < buffer_count; ++i) {
+        buffers.emplace_back(buffer_size, static_cast<kstd::u8>(i));
+    }
+
+    auto receiver_thread = std::thread {[&client_socket] {
+        std::vector<kstd::u8> buffer(64 * 1024);
+        kstd::usize bytes_received = 0;
+        while(bytes_received < buffer_count * buffer_size) {
+            const auto result = client_socket.read(buffer.data(), buffer.size());
+            if(!result || result.get() == 0) {
+                break;
+            }
+            bytes_received += result.get();
+        }
+    }};
+
+    auto sender_result = kstd::try_construct<ZeroCopySender>(socket.socket_handle());
+    auto& sender = sender_result.get_or_throw();
+    for(kstd::usize i = 0; i < buffer_count; ++i) {
+        kstd::usize bytes_sent = 0;
+        while(bytes_sent < buffer_size) {
+            bytes_sent += sender.send(buffers[i].data() + bytes_sent, buffer_size - bytes_sent, i).get_or_throw();
+        }
+    }
+
+    // Every buffer is reported at least once, partial sends report the user data multiple times
+    std::vector<kstd::usize> completions(buffer_count);
+    sender.flush([&completions](const kstd::u64 user_data, bool) {
+              ++completions[user_data];
+          })
+            .throw_if_error();
+    receiver_thread.join();
+
+    ASSERT_EQ(sender.pending_count(), 0);
+    for(const auto completion_count : completions) {
+        ASSERT_GE(completion_count, 1);
+    }
+}
+
+TEST(sockslib_ZeroCopySender, test_reap_without_sends) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    auto& client_socket = client_socket_result.get_or_throw();
+
+    auto sender_result = kstd::try_construct<ZeroCopySender>(client_socket.socket_handle());
+    auto& sender = sender_result.get_or_throw();
+    ASSERT_EQ(sender.reap([](kstd::u64, bool) {}).get_or_throw(), 0);
+    ASSERT_EQ(sender.flush([](kstd::u64, bool) {}).get_or_throw(), 0);
+    ASSERT_EQ(sender.pending_count(), 0);
+    server_socket.accept().throw_if_error();
+}
+
+TEST(sockslib_ZeroCopySender, test_flush_deadline) {
+    using namespace sockslib;
+    auto server_socket_result = kstd::try_construct<ServerSocket>(1337, ProtocolType::TCP);
+    auto& server_socket = server_socket_result.get_or_throw();
+    auto client_socket_result = kstd::try_construct<ClientSocket>("127.0.0.1", 1337, ProtocolType::TCP);
+    client_socket_result.throw_if_error();
+    auto socket = std::move(server_socket.accept().get_or_throw());
+
+    auto sender_result = kstd::try_construct<ZeroCopySender>(socket.socket_handle());
+    auto& sender = sender_result.get_or_throw();
+    const std::vector<kstd::u8> buffer(64 * 1024);
+    static_cast<void>(sender.send(buffer.data(), buffer.size(), 0).get_or_throw());
+
+    // An expired deadline only reaps the completions which already arrived
+    const auto result = sender.flush([](kstd::u64, bool) {}, Deadline {});
+    if(result) {
+        ASSERT_EQ(sender.pending_count(), 0);
+    }
+    else {
+        ASSERT_EQ(result.get_error(), SocketError(SocketOperation::WRITE, ETIMEDOUT));
+        ASSERT_EQ(sender.pending_count(), 1);
+    }
+    sender.flush([](kstd::u64, bool) {}, std::chrono::steady_clock::now() + std::chrono::seconds {5})
+            .throw_if_error();
+    ASSERT_EQ(sender.pending_count(), 0);
+}
+#endif